@@ -148,6 +148,7 @@ using quentier::LogViewerWidget;
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 #define NOTIFY_ERROR(error)                                                    \
     QNWARNING("quentier:main_window", QString::fromUtf8(error));               \
@@ -181,6 +182,11 @@ using quentier::LogViewerWidget;
 #define CREATE_SIDE_BORDERS_CONTROLLER_DELAY (200)
 #define NOTIFY_SIDE_BORDERS_CONTROLLER_DELAY (200)
 
+// Max duration of a models startup stage in msec: if the models of the stage
+// haven't listed their items by then, the next stage is started anyway so that
+// a failed listing doesn't hold back the rest of models
+#define MODELS_STARTUP_STAGE_TIMEOUT (5000)
+
 using namespace quentier;
 
 namespace {
@@ -399,6 +405,7 @@ MainWindow::~MainWindow()
 {
     QNDEBUG("quentier:main_window", "MainWindow::~MainWindow");
 
+    saveModelSnapshots();
     clearSynchronizationManager();
 
     if (m_pLocalStorageManagerThread) {
@@ -4945,6 +4952,37 @@ void MainWindow::onDefaultAccountFirstNotebookAndNoteCreatorError(
     }
 }
 
+void MainWindow::onNoteModelMinimalNotesBatchLoaded()
+{
+    if (m_modelsStartupStage != ModelsStartupStage::NoteList ||
+        !m_modelsStartupStagePendingNoteList)
+    {
+        return;
+    }
+
+    QNDEBUG(
+        "quentier:main_window",
+        "MainWindow::onNoteModelMinimalNotesBatchLoaded");
+
+    m_modelsStartupStagePendingNoteList = false;
+    checkModelsStartupStageCompletion();
+}
+
+void MainWindow::onItemModelAllItemsListed()
+{
+    auto * pModel = qobject_cast<AbstractItemModel *>(sender());
+    if (!pModel || !m_modelsStartupStagePendingModels.removeOne(pModel)) {
+        return;
+    }
+
+    QNDEBUG(
+        "quentier:main_window",
+        "MainWindow::onItemModelAllItemsListed: "
+            << pModel->metaObject()->className());
+
+    checkModelsStartupStageCompletion();
+}
+
 #ifdef WITH_UPDATE_MANAGER
 void MainWindow::onCheckForUpdatesActionTriggered()
 {
@@ -5103,6 +5141,20 @@ void MainWindow::timerEvent(QTimerEvent * pTimerEvent)
         killTimer(m_setDefaultAccountsFirstNoteAsCurrentDelayTimerId);
         m_setDefaultAccountsFirstNoteAsCurrentDelayTimerId = 0;
     }
+    else if (pTimerEvent->timerId() == m_modelsStartupStageTimeoutTimerId) {
+        QNWARNING(
+            "quentier:main_window",
+            "Models startup stage \""
+                << modelsStartupStageName(m_modelsStartupStage)
+                << "\" timed out, "
+                << m_modelsStartupStagePendingModels.size()
+                << " models haven't listed their items yet"
+                << (m_modelsStartupStagePendingNoteList
+                        ? ", note list is not loaded yet"
+                        : ""));
+
+        finishModelsStartupStage();
+    }
 }
 
 void MainWindow::focusInEvent(QFocusEvent * pFocusEvent)
@@ -5206,6 +5258,18 @@ void MainWindow::changeEvent(QEvent * pEvent)
     }
 }
 
+bool MainWindow::eventFilter(QObject * pWatched, QEvent * pEvent)
+{
+    // NOTE: deleted notes view is the only one watched by the main window
+    if (pEvent && (pEvent->type() == QEvent::Show) &&
+        qobject_cast<DeletedNoteItemView *>(pWatched))
+    {
+        startDeletedNotesModel();
+    }
+
+    return QMainWindow::eventFilter(pWatched, pEvent);
+}
+
 void MainWindow::centerWidget(QWidget & widget)
 {
     // Center the widget relative to the main window
@@ -5447,6 +5511,10 @@ void MainWindow::setupModels()
         *m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache, m_notebookCache,
         this, NoteModel::IncludedNotes::NonDeleted, noteSortingMode);
 
+    QObject::connect(
+        m_pNoteModel, &NoteModel::minimalNotesBatchLoaded, this,
+        &MainWindow::onNoteModelMinimalNotesBatchLoaded);
+
     m_pFavoritesModel = new FavoritesModel(
         *m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache, m_notebookCache,
         m_tagCache, m_savedSearchCache, this);
@@ -5460,12 +5528,22 @@ void MainWindow::setupModels()
     m_pSavedSearchModel = new SavedSearchModel(
         *m_pAccount, *m_pLocalStorageManagerAsync, m_savedSearchCache, this);
 
+    // Favorited notebooks and tags take their note counts from the notebook
+    // and tag models instead of requesting them from the local storage
+    m_pFavoritesModel->setNotebookModel(m_pNotebookModel);
+    m_pFavoritesModel->setTagModel(m_pTagModel);
+
+    // Items persisted during the previous run are shown right away and
+    // reconciled with the local storage once the models are started
+    Q_UNUSED(m_pFavoritesModel->restoreSnapshot())
+    Q_UNUSED(m_pNotebookModel->restoreSnapshot())
+    Q_UNUSED(m_pTagModel->restoreSnapshot())
+    Q_UNUSED(m_pSavedSearchModel->restoreSnapshot())
+
     m_pDeletedNotesModel = new NoteModel(
         *m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache, m_notebookCache,
         this, NoteModel::IncludedNotes::Deleted);
 
-    m_pDeletedNotesModel->start();
-
     if (m_pNoteCountLabelController == nullptr) {
         m_pNoteCountLabelController =
             new NoteCountLabelController(*m_pUi->notesCountLabelPanel, this);
@@ -5482,6 +5560,11 @@ void MainWindow::setupModels()
     m_pUi->deletedNotesTableView->setModel(m_pDeletedNotesModel);
     m_pUi->noteListView->setModel(m_pNoteModel);
 
+    m_pUi->deletedNotesTableView->installEventFilter(this);
+    if (m_pUi->deletedNotesTableView->isVisible()) {
+        startDeletedNotesModel();
+    }
+
     m_pNotebookModelColumnChangeRerouter->setModel(m_pNotebookModel);
     m_pTagModelColumnChangeRerouter->setModel(m_pTagModel);
     m_pNoteModelColumnChangeRerouter->setModel(m_pNoteModel);
@@ -5490,13 +5573,195 @@ void MainWindow::setupModels()
     if (m_pEditNoteDialogsManager) {
         m_pEditNoteDialogsManager->setNotebookModel(m_pNotebookModel);
     }
+
+    startModelsStartupStage(ModelsStartupStage::NoteList);
+}
+
+void MainWindow::startDeletedNotesModel()
+{
+    if (!m_pDeletedNotesModel || m_pDeletedNotesModel->isStarted()) {
+        return;
+    }
+
+    QNDEBUG("quentier:main_window", "MainWindow::startDeletedNotesModel");
+    m_pDeletedNotesModel->start();
+}
+
+QString MainWindow::modelsStartupStageName(
+    const ModelsStartupStage::type stage)
+{
+    switch (stage) {
+    case ModelsStartupStage::NoteList:
+        return QStringLiteral("note list");
+    case ModelsStartupStage::VisibleSidePanels:
+        return QStringLiteral("visible side panels");
+    case ModelsStartupStage::HiddenSidePanels:
+        return QStringLiteral("hidden side panels");
+    case ModelsStartupStage::Finished:
+        return QStringLiteral("finished");
+    default:
+        return QStringLiteral("unknown: ") +
+            QString::number(static_cast<qint64>(stage));
+    }
+}
+
+void MainWindow::startModelsStartupStage(const ModelsStartupStage::type stage)
+{
+    QNDEBUG(
+        "quentier:main_window",
+        "MainWindow::startModelsStartupStage: "
+            << modelsStartupStageName(stage));
+
+    if (stage == ModelsStartupStage::NoteList) {
+        m_modelsStartupTimer.start();
+    }
+
+    m_modelsStartupStage = stage;
+    m_modelsStartupStageTimer.start();
+    m_modelsStartupStagePendingNoteList = false;
+    m_modelsStartupStagePendingModels.clear();
+
+    if (m_modelsStartupStageTimeoutTimerId != 0) {
+        killTimer(m_modelsStartupStageTimeoutTimerId);
+    }
+
+    m_modelsStartupStageTimeoutTimerId =
+        startTimer(MODELS_STARTUP_STAGE_TIMEOUT);
+
+    if (stage == ModelsStartupStage::NoteList) {
+        // Note model is started along with note filters; if filters are not
+        // ready yet, they wait for the models of notebooks, tags or saved
+        // searches which are then required for the note list as well
+        m_modelsStartupStagePendingNoteList = true;
+
+        if (m_pNoteFiltersManager && !m_pNoteFiltersManager->isReady()) {
+            startModelForModelsStartupStage(m_pNotebookModel);
+            startModelForModelsStartupStage(m_pTagModel);
+            startModelForModelsStartupStage(m_pSavedSearchModel);
+        }
+
+        return;
+    }
+
+    bool showSidePanel = m_pUi->ActionShowSidePanel->isChecked();
+
+    // Filters by notebooks, tags and saved searches need the corresponding
+    // models as much as the side panels do
+    bool showFilters = m_filtersViewExpanded &&
+        m_pUi->ActionShowNotesList->isChecked();
+
+    std::pair<AbstractItemModel *, bool> models[] = {
+        {m_pFavoritesModel,
+         showSidePanel && m_pUi->ActionShowFavorites->isChecked()},
+        {m_pNotebookModel,
+         showFilters ||
+             (showSidePanel && m_pUi->ActionShowNotebooks->isChecked())},
+        {m_pTagModel,
+         showFilters || (showSidePanel && m_pUi->ActionShowTags->isChecked())},
+        {m_pSavedSearchModel,
+         showFilters ||
+             (showSidePanel && m_pUi->ActionShowSavedSearches->isChecked())}};
+
+    bool startVisible = (stage == ModelsStartupStage::VisibleSidePanels);
+    for (const auto & pair: models) {
+        if (pair.second == startVisible) {
+            startModelForModelsStartupStage(pair.first);
+        }
+    }
+
+    checkModelsStartupStageCompletion();
+}
+
+void MainWindow::startModelForModelsStartupStage(AbstractItemModel * pModel)
+{
+    if (Q_UNLIKELY(!pModel)) {
+        return;
+    }
+
+    pModel->start();
+
+    if (pModel->allItemsListed() ||
+        m_modelsStartupStagePendingModels.contains(pModel))
+    {
+        return;
+    }
+
+    QObject::connect(
+        pModel, &AbstractItemModel::notifyAllItemsListed, this,
+        &MainWindow::onItemModelAllItemsListed, Qt::UniqueConnection);
+
+    m_modelsStartupStagePendingModels.push_back(pModel);
+}
+
+void MainWindow::checkModelsStartupStageCompletion()
+{
+    if (m_modelsStartupStage == ModelsStartupStage::Finished) {
+        return;
+    }
+
+    if (m_modelsStartupStagePendingNoteList ||
+        !m_modelsStartupStagePendingModels.isEmpty())
+    {
+        return;
+    }
+
+    finishModelsStartupStage();
+}
+
+void MainWindow::finishModelsStartupStage()
+{
+    QNINFO(
+        "quentier:main_window",
+        "Models startup stage \""
+            << modelsStartupStageName(m_modelsStartupStage)
+            << "\" finished in " << m_modelsStartupStageTimer.elapsed()
+            << " msec, " << m_modelsStartupTimer.elapsed()
+            << " msec since the start of models");
+
+    if (m_modelsStartupStageTimeoutTimerId != 0) {
+        killTimer(m_modelsStartupStageTimeoutTimerId);
+        m_modelsStartupStageTimeoutTimerId = 0;
+    }
+
+    m_modelsStartupStagePendingNoteList = false;
+    m_modelsStartupStagePendingModels.clear();
+
+    if (m_modelsStartupStage == ModelsStartupStage::NoteList) {
+        startModelsStartupStage(ModelsStartupStage::VisibleSidePanels);
+        return;
+    }
+
+    if (m_modelsStartupStage == ModelsStartupStage::VisibleSidePanels) {
+        startModelsStartupStage(ModelsStartupStage::HiddenSidePanels);
+        return;
+    }
+
+    m_modelsStartupStage = ModelsStartupStage::Finished;
+    m_modelsStartupStageTimer.invalidate();
+    m_modelsStartupTimer.invalidate();
+}
+
+void MainWindow::clearModelsStartup()
+{
+    if (m_modelsStartupStageTimeoutTimerId != 0) {
+        killTimer(m_modelsStartupStageTimeoutTimerId);
+        m_modelsStartupStageTimeoutTimerId = 0;
+    }
+
+    m_modelsStartupStage = ModelsStartupStage::Finished;
+    m_modelsStartupStagePendingNoteList = false;
+    m_modelsStartupStagePendingModels.clear();
+    m_modelsStartupStageTimer.invalidate();
+    m_modelsStartupTimer.invalidate();
 }
 
 void MainWindow::clearModels()
 {
     QNDEBUG("quentier:main_window", "MainWindow::clearModels");
 
+    saveModelSnapshots();
     clearViews();
+    clearModelsStartup();
 
     if (m_pNotebookModel) {
         delete m_pNotebookModel;
@@ -5531,6 +5796,20 @@ void MainWindow::clearModels()
     }
 }
 
+void MainWindow::saveModelSnapshots()
+{
+    QNDEBUG("quentier:main_window", "MainWindow::saveModelSnapshots");
+
+    AbstractItemModel * models[] = {
+        m_pFavoritesModel, m_pNotebookModel, m_pTagModel, m_pSavedSearchModel};
+
+    for (auto * pModel: models) {
+        if (pModel) {
+            Q_UNUSED(pModel->saveSnapshot())
+        }
+    }
+}
+
 void MainWindow::setupShowHideStartupSettings()
 {
     QNDEBUG("quentier:main_window", "MainWindow::setupShowHideStartupSettings");
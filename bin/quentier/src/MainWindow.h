@@ -49,6 +49,7 @@
 #error "Quentier needs libquentier built with authentication manager"
 #endif
 
+#include <QElapsedTimer>
 #include <QLinearGradient>
 #include <QMap>
 #include <QMovie>
@@ -357,6 +358,10 @@ private Q_SLOTS:
     void onDefaultAccountFirstNotebookAndNoteCreatorError(
         ErrorString errorDescription);
 
+    // Models startup slots
+    void onNoteModelMinimalNotesBatchLoaded();
+    void onItemModelAllItemsListed();
+
 #ifdef WITH_UPDATE_MANAGER
     void onCheckForUpdatesActionTriggered();
     void onUpdateManagerError(ErrorString errorDescription);
@@ -373,6 +378,8 @@ private:
     virtual void hideEvent(QHideEvent * pHideEvent) override;
     virtual void changeEvent(QEvent * pEvent) override;
 
+    virtual bool eventFilter(QObject * pWatched, QEvent * pEvent) override;
+
 private:
     void centerWidget(QWidget & widget);
     void centerDialog(QDialog & dialog);
@@ -387,6 +394,46 @@ private:
     void setupModels();
     void clearModels();
 
+    /**
+     * Persists the snapshots of item models so that the models created
+     * for the same account during the next run can show their items right away
+     */
+    void saveModelSnapshots();
+
+    /**
+     * Deleted notes model is only started once deleted notes view is shown
+     * as most sessions never show it and the model would otherwise compete
+     * with other models for the local storage during the startup
+     */
+    void startDeletedNotesModel();
+
+    /**
+     * Models are started in stages so that the note list the user is waiting
+     * for doesn't get queued within the local storage behind the listings of
+     * side panel models: first the note model (along with the models note
+     * filters depend on, if any), then the models behind visible side panels
+     * and filters, then the rest of models
+     */
+    struct ModelsStartupStage
+    {
+        enum type
+        {
+            NoteList = 0,
+            VisibleSidePanels,
+            HiddenSidePanels,
+            Finished
+        };
+    };
+
+    static QString modelsStartupStageName(
+        const ModelsStartupStage::type stage);
+
+    void startModelsStartupStage(const ModelsStartupStage::type stage);
+    void startModelForModelsStartupStage(AbstractItemModel * pModel);
+    void checkModelsStartupStageCompletion();
+    void finishModelsStartupStage();
+    void clearModelsStartup();
+
     void setupShowHideStartupSettings();
     void setupViews();
     void clearViews();
@@ -585,6 +632,15 @@ private:
     NoteFiltersManager * m_pNoteFiltersManager = nullptr;
 
     int m_setDefaultAccountsFirstNoteAsCurrentDelayTimerId = 0;
+
+    ModelsStartupStage::type m_modelsStartupStage =
+        ModelsStartupStage::Finished;
+
+    QElapsedTimer m_modelsStartupTimer;
+    QElapsedTimer m_modelsStartupStageTimer;
+    bool m_modelsStartupStagePendingNoteList = false;
+    QVector<AbstractItemModel *> m_modelsStartupStagePendingModels;
+    int m_modelsStartupStageTimeoutTimerId = 0;
     QString m_defaultAccountFirstNoteLocalUid;
 
     NoteEditorTabsAndWindowsCoordinator *
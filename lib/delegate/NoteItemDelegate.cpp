@@ -380,9 +380,22 @@ void NoteItemDelegate::paint(
             pPainter->setPen(option.palette.windowText().color());
         }
 
-        QImage thumbnail;
-        Q_UNUSED(thumbnail.loadFromData(thumbnailData, "PNG"))
-        pPainter->drawImage(thumbnailRect, thumbnail);
+        // The thumbnail decoded and scaled to the size of the painted rect
+        // in device pixels is cached; if it's not decoded yet, it would be
+        // painted after the decoding in background is finished
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+        qreal devicePixelRatio = pPainter->device()->devicePixelRatioF();
+#else
+        qreal devicePixelRatio = pPainter->device()->devicePixelRatio();
+#endif
+
+        const auto * pThumbnail = pNoteModel->thumbnailCache().thumbnail(
+            noteLocalUid, pItem->thumbnailDataHash(), thumbnailData,
+            thumbnailRect.size(), devicePixelRatio);
+
+        if (pThumbnail) {
+            pPainter->drawPixmap(thumbnailRect, *pThumbnail);
+        }
     }
 
     auto * pNoteListView = qobject_cast<NoteListView *>(pView);
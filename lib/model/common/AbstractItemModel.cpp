@@ -17,7 +17,12 @@
  */
 
 #include "AbstractItemModel.h"
+#include "ModelSnapshot.h"
 
+#include <quentier/logging/QuentierLogger.h>
+#include <quentier/utility/Compat.h>
+
+#include <QDataStream>
 #include <QDebug>
 
 namespace quentier {
@@ -26,10 +31,142 @@ AbstractItemModel::AbstractItemModel(
     const Account & account, QObject * parent) :
     QAbstractItemModel(parent),
     m_account(account)
-{}
+{
+    QObject::connect(
+        this, &AbstractItemModel::notifyAllItemsListed, this,
+        &AbstractItemModel::onAllItemsListed);
+}
 
 AbstractItemModel::~AbstractItemModel() {}
 
+void AbstractItemModel::start()
+{
+    if (m_isStarted) {
+        return;
+    }
+
+    QNDEBUG(
+        "model:abstract_item_model",
+        metaObject()->className() << " starts listing items");
+
+    m_isStarted = true;
+    m_allItemsListingTimer.start();
+    startListing();
+}
+
+bool AbstractItemModel::saveSnapshot() const
+{
+    if (!allItemsListed()) {
+        QNDEBUG(
+            "model:abstract_item_model",
+            "Not saving the snapshot of "
+                << metaObject()->className()
+                << ": not all items are listed yet");
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    ModelSnapshot snapshot(
+        m_account, QString::fromUtf8(metaObject()->className()));
+
+    bool res = snapshot.write([this](QDataStream & out) {
+        writeSnapshot(out);
+    });
+
+    if (res) {
+        QNDEBUG(
+            "model:abstract_item_model",
+            "Saved the snapshot of " << metaObject()->className() << " in "
+                                     << timer.elapsed() << " msec");
+    }
+
+    return res;
+}
+
+bool AbstractItemModel::restoreSnapshot()
+{
+    if (m_isStarted) {
+        QNDEBUG(
+            "model:abstract_item_model",
+            "Not restoring the snapshot of "
+                << metaObject()->className() << ": already started");
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QStringList localUids;
+
+    ModelSnapshot snapshot(
+        m_account, QString::fromUtf8(metaObject()->className()));
+
+    bool res = snapshot.take([&](QDataStream & in) {
+        return readSnapshot(in, localUids);
+    });
+
+    // Even if the snapshot was read only partially, the items restored from it
+    // are still to be reconciled with the local storage
+    for (const auto & localUid: qAsConst(localUids)) {
+        Q_UNUSED(m_unconfirmedSnapshotItemLocalUids.insert(localUid))
+    }
+
+    if (res) {
+        QNDEBUG(
+            "model:abstract_item_model",
+            "Restored " << localUids.size() << " items of "
+                        << metaObject()->className() << " from the snapshot in "
+                        << timer.elapsed() << " msec");
+    }
+
+    return res;
+}
+
+void AbstractItemModel::confirmSnapshotItem(const QString & localUid)
+{
+    if (!m_unconfirmedSnapshotItemLocalUids.isEmpty()) {
+        Q_UNUSED(m_unconfirmedSnapshotItemLocalUids.remove(localUid))
+    }
+}
+
+void AbstractItemModel::removeUnconfirmedSnapshotItems()
+{
+    if (m_unconfirmedSnapshotItemLocalUids.isEmpty()) {
+        return;
+    }
+
+    QStringList localUids = m_unconfirmedSnapshotItemLocalUids.values();
+    m_unconfirmedSnapshotItemLocalUids.clear();
+
+    QNDEBUG(
+        "model:abstract_item_model",
+        "Removing " << localUids.size() << " items of "
+                    << metaObject()->className()
+                    << " restored from the snapshot but not received from "
+                    << "the local storage");
+
+    removeSnapshotItems(localUids);
+}
+
+void AbstractItemModel::onAllItemsListed()
+{
+    removeUnconfirmedSnapshotItems();
+
+    if (m_allItemsListingTimeMsec >= 0) {
+        return;
+    }
+
+    m_allItemsListingTimeMsec = m_allItemsListingTimer.elapsed();
+    m_allItemsListingTimer.invalidate();
+
+    QNDEBUG(
+        "model:abstract_item_model",
+        metaObject()->className() << " listed all items in "
+                                  << m_allItemsListingTimeMsec << " msec");
+}
+
 QDebug & operator<<(
     QDebug & dbg, const AbstractItemModel::LinkedNotebookInfo & info)
 {
@@ -22,9 +22,12 @@
 #include <quentier/types/Account.h>
 
 #include <QAbstractItemModel>
+#include <QElapsedTimer>
+#include <QSet>
 #include <QStringList>
 #include <QVector>
 
+QT_FORWARD_DECLARE_CLASS(QDataStream)
 QT_FORWARD_DECLARE_CLASS(QDebug)
 
 namespace quentier {
@@ -224,6 +227,54 @@ public:
         return persistentIndexList();
     }
 
+    /**
+     * @brief start - makes the model request its items from the local storage.
+     * Until the model is started it doesn't list any items from the local
+     * storage although it still tracks the changes of items within it; this
+     * allows the owner of several models to decide the order in which they
+     * load their items. Calling start more than once has no effect.
+     */
+    void start();
+
+    bool isStarted() const
+    {
+        return m_isStarted;
+    }
+
+    /**
+     * @brief saveSnapshot - persists the model's items so that the model
+     * created for the same account during the next run of the app could show
+     * them right away, before listing them from the local storage
+     * @return                      True if the snapshot was saved, false
+     *                              if not all items are listed yet or if
+     *                              the snapshot could not be written
+     */
+    bool saveSnapshot() const;
+
+    /**
+     * @brief restoreSnapshot - fills the model which is not started yet with
+     * the items from the snapshot saved during the previous run of the app,
+     * if any. Once the model is started, the restored items are updated as
+     * they are listed from the local storage; the restored items which
+     * the local storage no longer contains are removed after all items are
+     * listed.
+     * @return                      True if the items were restored from
+     *                              the snapshot, false otherwise
+     */
+    bool restoreSnapshot();
+
+    /**
+     * @brief allItemsListingTimeMsec
+     * @return                      The time in milliseconds elapsed since
+     *                              the model was started until it first
+     *                              emitted notifyAllItemsListed signal or -1
+     *                              if it hasn't done so yet
+     */
+    qint64 allItemsListingTimeMsec() const
+    {
+        return m_allItemsListingTimeMsec;
+    }
+
 Q_SIGNALS:
     /**
      * @brief allItemsListed - this signal should be emitted when the model has
@@ -231,8 +282,60 @@ Q_SIGNALS:
      */
     void notifyAllItemsListed();
 
+private Q_SLOTS:
+    void onAllItemsListed();
+
+protected:
+    /**
+     * @brief startListing - the actual implementation of start method: sends
+     * the requests listing the model's items from the local storage
+     */
+    virtual void startListing() = 0;
+
+    /**
+     * @brief writeSnapshot - writes the data of the model's items into
+     * the snapshot
+     */
+    virtual void writeSnapshot(QDataStream & out) const = 0;
+
+    /**
+     * @brief readSnapshot - restores the model's items from the snapshot
+     * written by writeSnapshot
+     * @param in                    The data stream to read the snapshot from
+     * @param localUids             The local uids of the restored items
+     * @return                      True if the snapshot was read successfully
+     */
+    virtual bool readSnapshot(QDataStream & in, QStringList & localUids) = 0;
+
+    /**
+     * @brief removeSnapshotItems - removes the items restored from
+     * the snapshot which were not found within the local storage
+     */
+    virtual void removeSnapshotItems(const QStringList & localUids) = 0;
+
+    /**
+     * @brief confirmSnapshotItem - subclasses should call this method for
+     * each item received from the local storage so that the item restored from
+     * the snapshot is not removed after all items are listed
+     */
+    void confirmSnapshotItem(const QString & localUid);
+
+    /**
+     * @brief removeUnconfirmedSnapshotItems - removes the items restored from
+     * the snapshot which haven't been received from the local storage yet;
+     * subclasses should call this method when listing the items fails as
+     * the items not confirmed by then can't be trusted to still exist
+     */
+    void removeUnconfirmedSnapshotItems();
+
 protected:
     Account m_account;
+
+private:
+    bool m_isStarted = false;
+    QSet<QString> m_unconfirmedSnapshotItemLocalUids;
+    QElapsedTimer m_allItemsListingTimer;
+    qint64 m_allItemsListingTimeMsec = -1;
 };
 
 } // namespace quentier
@@ -21,6 +21,11 @@
 
 #include <quentier/utility/Printable.h>
 
+#include <QList>
+#include <QVector>
+
+#include <algorithm>
+
 QT_FORWARD_DECLARE_CLASS(QDataStream)
 QT_FORWARD_DECLARE_CLASS(QDebug)
 
@@ -123,10 +128,41 @@ public:
         return pItem;
     }
 
+    /**
+     * @brief sortChildren - sorts children using the comparator; the relative
+     * order of equivalent children is preserved
+     * @return  The permutation of rows: the new row of the child for each
+     *          of its former rows
+     */
     template <typename Comparator>
-    void sortChildren(Comparator comparator)
+    QVector<int> sortChildren(Comparator comparator)
     {
-        std::sort(m_children.begin(), m_children.end(), comparator);
+        const int numChildren = m_children.size();
+
+        QVector<int> formerRows;
+        formerRows.reserve(numChildren);
+        for (int row = 0; row < numChildren; ++row) {
+            formerRows << row;
+        }
+
+        std::stable_sort(
+            formerRows.begin(), formerRows.end(),
+            [&](const int lhs, const int rhs) {
+                return comparator(m_children.at(lhs), m_children.at(rhs));
+            });
+
+        QList<TSubclass *> sortedChildren;
+        sortedChildren.reserve(numChildren);
+
+        QVector<int> newRows(numChildren);
+        for (int row = 0; row < numChildren; ++row) {
+            const int formerRow = formerRows.at(row);
+            sortedChildren << m_children.at(formerRow);
+            newRows[formerRow] = row;
+        }
+
+        m_children = sortedChildren;
+        return newRows;
     }
 
     virtual QDataStream & serializeItemData(QDataStream & out) const
@@ -0,0 +1,375 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ItemNamesCompletionModel.h"
+
+#include <quentier/logging/QuentierLogger.h>
+#include <quentier/utility/Compat.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace quentier {
+
+ItemNamesCompletionModel * ItemNamesCompletionModel::forSourceModel(
+    AbstractItemModel & sourceModel)
+{
+    auto * pModel = sourceModel.findChild<ItemNamesCompletionModel *>(
+        QString(), Qt::FindDirectChildrenOnly);
+
+    if (pModel) {
+        return pModel;
+    }
+
+    return new ItemNamesCompletionModel(sourceModel);
+}
+
+ItemNamesCompletionModel::ItemNamesCompletionModel(
+    AbstractItemModel & sourceModel) :
+    QAbstractListModel(&sourceModel),
+    m_pSourceModel(&sourceModel)
+{
+    createConnections();
+    onSourceModelReset();
+}
+
+ItemNamesCompletionModel::~ItemNamesCompletionModel() = default;
+
+AbstractItemModel * ItemNamesCompletionModel::sourceModel() const
+{
+    return m_pSourceModel.data();
+}
+
+int ItemNamesCompletionModel::rowCount(const QModelIndex & parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return static_cast<int>(m_entries.size());
+}
+
+QVariant ItemNamesCompletionModel::data(
+    const QModelIndex & index, int role) const
+{
+    if (!index.isValid() || (index.column() != 0)) {
+        return {};
+    }
+
+    int row = index.row();
+    if ((row < 0) || (static_cast<size_t>(row) >= m_entries.size())) {
+        return {};
+    }
+
+    const auto & entry = m_entries[static_cast<size_t>(row)];
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return entry.m_completion;
+    case Role::LinkedNotebookGuid:
+        return entry.m_linkedNotebookGuid;
+    default:
+        return {};
+    }
+}
+
+void ItemNamesCompletionModel::onSourceRowsInserted(
+    const QModelIndex & parent, int start, int end)
+{
+    QNTRACE(
+        "model:item_names_completion",
+        "ItemNamesCompletionModel::onSourceRowsInserted: start = "
+            << start << ", end = " << end);
+
+    addOrUpdateItems(parent, start, end);
+}
+
+void ItemNamesCompletionModel::onSourceRowsAboutToBeRemoved(
+    const QModelIndex & parent, int start, int end)
+{
+    QNTRACE(
+        "model:item_names_completion",
+        "ItemNamesCompletionModel::onSourceRowsAboutToBeRemoved: start = "
+            << start << ", end = " << end);
+
+    QStringList localUids;
+    collectLocalUids(parent, start, end, localUids);
+
+    for (const auto & localUid: qAsConst(localUids)) {
+        removeItem(localUid);
+    }
+}
+
+void ItemNamesCompletionModel::onSourceDataChanged(
+    const QModelIndex & topLeft, const QModelIndex & bottomRight,
+    const QVector<int> & roles)
+{
+    Q_UNUSED(roles)
+
+    if (m_pSourceModel.isNull()) {
+        return;
+    }
+
+    // Changes of columns other than the name one, for example, of note counts,
+    // don't affect the completions
+    int nameColumn = m_pSourceModel->nameColumn();
+    if ((topLeft.column() > nameColumn) || (bottomRight.column() < nameColumn))
+    {
+        return;
+    }
+
+    QNTRACE(
+        "model:item_names_completion",
+        "ItemNamesCompletionModel::onSourceDataChanged: rows "
+            << topLeft.row() << " to " << bottomRight.row());
+
+    // Descendants are updated as well because the change of a linked notebook
+    // root item might mean the change of the username within completions for
+    // all its items
+    addOrUpdateItems(topLeft.parent(), topLeft.row(), bottomRight.row());
+}
+
+void ItemNamesCompletionModel::onSourceModelReset()
+{
+    QNDEBUG(
+        "model:item_names_completion",
+        "ItemNamesCompletionModel::onSourceModelReset");
+
+    beginResetModel();
+
+    m_entries.clear();
+    m_completionsByLocalUid.clear();
+
+    if (!m_pSourceModel.isNull()) {
+        QStringList localUids;
+
+        int rowCount = m_pSourceModel->rowCount();
+        if (rowCount > 0) {
+            collectLocalUids(QModelIndex(), 0, rowCount - 1, localUids);
+        }
+
+        m_entries.reserve(static_cast<size_t>(localUids.size()));
+        m_completionsByLocalUid.reserve(localUids.size());
+
+        for (const auto & localUid: qAsConst(localUids)) {
+            Entry entry;
+            if (!entryForLocalUid(localUid, entry)) {
+                continue;
+            }
+
+            m_completionsByLocalUid[localUid] = entry.m_completion;
+            m_entries.push_back(std::move(entry));
+        }
+
+        std::sort(m_entries.begin(), m_entries.end(), &entryLess);
+    }
+
+    endResetModel();
+
+    QNDEBUG(
+        "model:item_names_completion",
+        "Built " << m_entries.size() << " completions");
+}
+
+void ItemNamesCompletionModel::createConnections()
+{
+    QObject::connect(
+        m_pSourceModel.data(), &AbstractItemModel::rowsInserted, this,
+        &ItemNamesCompletionModel::onSourceRowsInserted);
+
+    QObject::connect(
+        m_pSourceModel.data(), &AbstractItemModel::rowsAboutToBeRemoved, this,
+        &ItemNamesCompletionModel::onSourceRowsAboutToBeRemoved);
+
+    QObject::connect(
+        m_pSourceModel.data(), &AbstractItemModel::dataChanged, this,
+        &ItemNamesCompletionModel::onSourceDataChanged);
+
+    QObject::connect(
+        m_pSourceModel.data(), &AbstractItemModel::modelReset, this,
+        &ItemNamesCompletionModel::onSourceModelReset);
+}
+
+void ItemNamesCompletionModel::addOrUpdateItems(
+    const QModelIndex & parent, int start, int end)
+{
+    if (m_pSourceModel.isNull()) {
+        return;
+    }
+
+    for (int row = start; row <= end; ++row) {
+        auto index = m_pSourceModel->index(row, 0, parent);
+        if (!index.isValid()) {
+            continue;
+        }
+
+        // Items without local uids, like root items or notebook stacks,
+        // are not completed but might contain items to complete
+        QString localUid = m_pSourceModel->localUidForItemIndex(index);
+        if (!localUid.isEmpty()) {
+            addOrUpdateItem(localUid);
+        }
+
+        int childCount = m_pSourceModel->rowCount(index);
+        if (childCount > 0) {
+            addOrUpdateItems(index, 0, childCount - 1);
+        }
+    }
+}
+
+void ItemNamesCompletionModel::collectLocalUids(
+    const QModelIndex & parent, int start, int end,
+    QStringList & localUids) const
+{
+    if (m_pSourceModel.isNull()) {
+        return;
+    }
+
+    for (int row = start; row <= end; ++row) {
+        auto index = m_pSourceModel->index(row, 0, parent);
+        if (!index.isValid()) {
+            continue;
+        }
+
+        QString localUid = m_pSourceModel->localUidForItemIndex(index);
+        if (!localUid.isEmpty()) {
+            localUids << localUid;
+        }
+
+        int childCount = m_pSourceModel->rowCount(index);
+        if (childCount > 0) {
+            collectLocalUids(index, 0, childCount - 1, localUids);
+        }
+    }
+}
+
+void ItemNamesCompletionModel::addOrUpdateItem(const QString & localUid)
+{
+    Entry entry;
+    if (!entryForLocalUid(localUid, entry)) {
+        removeItem(localUid);
+        return;
+    }
+
+    auto it = m_completionsByLocalUid.find(localUid);
+    if (it != m_completionsByLocalUid.end()) {
+        if (it.value() == entry.m_completion) {
+            return;
+        }
+
+        removeItem(localUid);
+    }
+
+    auto pos =
+        std::upper_bound(m_entries.begin(), m_entries.end(), entry, &entryLess);
+
+    int row = static_cast<int>(std::distance(m_entries.begin(), pos));
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_completionsByLocalUid[localUid] = entry.m_completion;
+    Q_UNUSED(m_entries.insert(pos, std::move(entry)))
+    endInsertRows();
+}
+
+void ItemNamesCompletionModel::removeItem(const QString & localUid)
+{
+    auto it = m_completionsByLocalUid.find(localUid);
+    if (it == m_completionsByLocalUid.end()) {
+        return;
+    }
+
+    int row = rowForEntry(it.value(), localUid);
+    Q_UNUSED(m_completionsByLocalUid.erase(it))
+
+    if (Q_UNLIKELY(row < 0)) {
+        QNWARNING(
+            "model:item_names_completion",
+            "Can't find the completion entry for item with local uid "
+                << localUid);
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    Q_UNUSED(m_entries.erase(m_entries.begin() + row))
+    endRemoveRows();
+}
+
+bool ItemNamesCompletionModel::entryForLocalUid(
+    const QString & localUid, Entry & entry) const
+{
+    if (m_pSourceModel.isNull()) {
+        return false;
+    }
+
+    auto itemInfo = m_pSourceModel->itemInfoForLocalUid(localUid);
+    if (itemInfo.m_name.isEmpty()) {
+        return false;
+    }
+
+    entry.m_completion = itemInfo.m_name;
+    if (!itemInfo.m_linkedNotebookGuid.isEmpty()) {
+        entry.m_completion += QStringLiteral(" \\ @");
+        entry.m_completion += itemInfo.m_linkedNotebookUsername;
+    }
+
+    entry.m_localUid = localUid;
+    entry.m_linkedNotebookGuid = itemInfo.m_linkedNotebookGuid;
+    return true;
+}
+
+int ItemNamesCompletionModel::rowForEntry(
+    const QString & completion, const QString & localUid) const
+{
+    Entry probe;
+    probe.m_completion = completion;
+
+    auto it = std::lower_bound(
+        m_entries.begin(), m_entries.end(), probe, &entryLess);
+
+    for (auto end = m_entries.end(); it != end; ++it) {
+        if (it->m_completion != completion) {
+            break;
+        }
+
+        if (it->m_localUid == localUid) {
+            return static_cast<int>(std::distance(m_entries.begin(), it));
+        }
+    }
+
+    return -1;
+}
+
+bool ItemNamesCompletionModel::entryLess(const Entry & lhs, const Entry & rhs)
+{
+    // QCompleter looks up completions within case insensitively sorted model
+    // using binary search comparing strings case insensitively; ties are
+    // ordered case sensitively so that equal completions are adjacent
+    int result = QString::compare(
+        lhs.m_completion, rhs.m_completion, Qt::CaseInsensitive);
+
+    if (result != 0) {
+        return result < 0;
+    }
+
+    return QString::compare(
+               lhs.m_completion, rhs.m_completion, Qt::CaseSensitive) < 0;
+}
+
+} // namespace quentier
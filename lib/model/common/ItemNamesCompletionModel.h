@@ -0,0 +1,128 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_COMMON_ITEM_NAMES_COMPLETION_MODEL_H
+#define QUENTIER_LIB_MODEL_COMMON_ITEM_NAMES_COMPLETION_MODEL_H
+
+#include "AbstractItemModel.h"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPointer>
+
+#include <vector>
+
+namespace quentier {
+
+/**
+ * @brief The ItemNamesCompletionModel class is a flat list of names of items
+ * from AbstractItemModel suitable for use with QCompleter
+ *
+ * The names are kept sorted case insensitively so that QCompleter can look up
+ * completions for the typed prefix via binary search. The list is built once
+ * and then kept in sync with the source model incrementally, in response to
+ * rows insertions, removals and changes of item names. Names of items from
+ * linked notebooks are suffixed with the linked notebook owner's username.
+ */
+class ItemNamesCompletionModel final : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    struct Role
+    {
+        enum type
+        {
+            LinkedNotebookGuid = Qt::UserRole + 1
+        };
+    };
+
+    /**
+     * @brief forSourceModel - provides the completion model for the given
+     * source model
+     *
+     * The completion model is created on the first call and is owned by
+     * the source model so that all its clients share the same instance.
+     */
+    static ItemNamesCompletionModel * forSourceModel(
+        AbstractItemModel & sourceModel);
+
+    virtual ~ItemNamesCompletionModel() override;
+
+    AbstractItemModel * sourceModel() const;
+
+public:
+    // QAbstractItemModel interface
+    virtual int rowCount(
+        const QModelIndex & parent = QModelIndex()) const override;
+
+    virtual QVariant data(
+        const QModelIndex & index, int role = Qt::DisplayRole) const override;
+
+private Q_SLOTS:
+    void onSourceRowsInserted(const QModelIndex & parent, int start, int end);
+
+    void onSourceRowsAboutToBeRemoved(
+        const QModelIndex & parent, int start, int end);
+
+    void onSourceDataChanged(
+        const QModelIndex & topLeft, const QModelIndex & bottomRight,
+        const QVector<int> & roles = QVector<int>());
+
+    void onSourceModelReset();
+
+private:
+    struct Entry
+    {
+        QString m_completion;
+        QString m_localUid;
+        QString m_linkedNotebookGuid;
+    };
+
+    explicit ItemNamesCompletionModel(AbstractItemModel & sourceModel);
+
+    void createConnections();
+
+    /**
+     * @brief addOrUpdateItems - adds or updates entries for items within
+     * the given rows of the source model and all their descendants
+     */
+    void addOrUpdateItems(const QModelIndex & parent, int start, int end);
+
+    void collectLocalUids(
+        const QModelIndex & parent, int start, int end,
+        QStringList & localUids) const;
+
+    void addOrUpdateItem(const QString & localUid);
+    void removeItem(const QString & localUid);
+
+    bool entryForLocalUid(const QString & localUid, Entry & entry) const;
+    int rowForEntry(const QString & completion, const QString & localUid) const;
+
+    static bool entryLess(const Entry & lhs, const Entry & rhs);
+
+private:
+    QPointer<AbstractItemModel> m_pSourceModel;
+
+    // Entries sorted case insensitively by completion strings
+    std::vector<Entry> m_entries;
+    QHash<QString, QString> m_completionsByLocalUid;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_COMMON_ITEM_NAMES_COMPLETION_MODEL_H
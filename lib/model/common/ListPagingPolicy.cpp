@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ListPagingPolicy.h"
+
+#include <algorithm>
+
+// The page size is chosen so that page round trips take about this long
+#define LIST_PAGE_TARGET_MSEC (100)
+
+// Upper bound for the page size regardless of the measured cost per item
+#define LIST_PAGE_MAX_LIMIT (2000)
+
+// The page size grows no more than this many times from one page to the next
+#define LIST_PAGE_MAX_GROWTH_FACTOR (4)
+
+namespace quentier {
+
+ListPagingPolicy::ListPagingPolicy(const size_t initialLimit) :
+    m_initialLimit(initialLimit), m_limit(initialLimit)
+{}
+
+size_t ListPagingPolicy::onPageRequested()
+{
+    m_pageTimer.start();
+    return m_limit;
+}
+
+bool ListPagingPolicy::onPageReceived(const size_t limit, const size_t numItems)
+{
+    if ((numItems == 0) || (numItems < limit)) {
+        m_pageTimer.invalidate();
+        return false;
+    }
+
+    if (!m_pageTimer.isValid()) {
+        return true;
+    }
+
+    // NOTE: using at least one millisecond per page as elapsed time is
+    // measured with this precision
+    double elapsedMsec = static_cast<double>(
+        std::max(m_pageTimer.elapsed(), static_cast<qint64>(1)));
+
+    m_pageTimer.invalidate();
+
+    double msecPerItem = elapsedMsec / static_cast<double>(numItems);
+
+    auto limitForTargetTime = static_cast<size_t>(
+        static_cast<double>(LIST_PAGE_TARGET_MSEC) / msecPerItem);
+
+    m_limit = std::min(
+        limitForTargetTime, m_limit * size_t(LIST_PAGE_MAX_GROWTH_FACTOR));
+
+    m_limit = std::max(
+        m_initialLimit, std::min(m_limit, size_t(LIST_PAGE_MAX_LIMIT)));
+
+    return true;
+}
+
+size_t ListPagingPolicy::limit() const
+{
+    return m_limit;
+}
+
+} // namespace quentier
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_COMMON_LIST_PAGING_POLICY_H
+#define QUENTIER_LIB_MODEL_COMMON_LIST_PAGING_POLICY_H
+
+#include <QElapsedTimer>
+
+#include <cstddef>
+
+namespace quentier {
+
+/**
+ * @brief The ListPagingPolicy class determines the sizes of pages in which
+ * models list items from the local storage
+ *
+ * Each page is a round trip to the local storage thread so the page size
+ * starts from the initial limit and grows while the measured cost per listed
+ * item is low enough for larger pages to arrive within a reasonable time.
+ */
+class ListPagingPolicy
+{
+public:
+    explicit ListPagingPolicy(const size_t initialLimit);
+
+    /**
+     * @brief onPageRequested - starts measuring the round trip of the page
+     * request
+     * @return      The limit to use for the requested page
+     */
+    size_t onPageRequested();
+
+    /**
+     * @brief onPageReceived - adjusts the limit for subsequent pages according
+     * to the measured cost per item of the received page
+     * @param limit         The limit with which the page was requested
+     * @param numItems      The number of items within the received page
+     * @return              True if more pages need to be requested, false if
+     *                      the received page is the last one
+     */
+    bool onPageReceived(const size_t limit, const size_t numItems);
+
+    size_t limit() const;
+
+private:
+    size_t m_initialLimit;
+    size_t m_limit;
+    QElapsedTimer m_pageTimer;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_COMMON_LIST_PAGING_POLICY_H
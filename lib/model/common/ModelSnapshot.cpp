@@ -0,0 +1,182 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelSnapshot.h"
+
+#include <quentier/logging/QuentierLogger.h>
+#include <quentier/utility/StandardPaths.h>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <limits>
+
+// Identifies snapshot files: "QNMS" in ASCII
+#define MODEL_SNAPSHOT_MAGIC (0x514E4D53)
+
+// Snapshots written with another format version are ignored
+#define MODEL_SNAPSHOT_FORMAT_VERSION (1)
+
+#define MODEL_SNAPSHOTS_FOLDER QStringLiteral("modelSnapshots")
+
+namespace quentier {
+
+ModelSnapshot::ModelSnapshot(const Account & account, const QString & name) :
+    m_filePath(
+        accountPersistentStoragePath(account) + QStringLiteral("/") +
+        MODEL_SNAPSHOTS_FOLDER + QStringLiteral("/") + name +
+        QStringLiteral(".dat"))
+{}
+
+bool ModelSnapshot::write(
+    const std::function<void(QDataStream &)> & writer) const
+{
+    QNDEBUG("model:snapshot", "ModelSnapshot::write: " << m_filePath);
+
+    QDir dir = QFileInfo(m_filePath).absoluteDir();
+    if (!dir.exists() && !dir.mkpath(QStringLiteral("."))) {
+        QNWARNING(
+            "model:snapshot",
+            "Failed to create the folder for model snapshots: "
+                << dir.absolutePath());
+        return false;
+    }
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QNWARNING(
+            "model:snapshot",
+            "Failed to open model snapshot file for writing: "
+                << m_filePath << ": " << file.errorString());
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_5);
+
+    out << static_cast<quint32>(MODEL_SNAPSHOT_MAGIC)
+        << static_cast<quint32>(MODEL_SNAPSHOT_FORMAT_VERSION);
+
+    writer(out);
+
+    if (out.status() != QDataStream::Ok) {
+        QNWARNING(
+            "model:snapshot",
+            "Failed to write model snapshot: " << m_filePath);
+        file.cancelWriting();
+        return false;
+    }
+
+    if (!file.commit()) {
+        QNWARNING(
+            "model:snapshot",
+            "Failed to commit model snapshot file: "
+                << m_filePath << ": " << file.errorString());
+        return false;
+    }
+
+    return true;
+}
+
+bool ModelSnapshot::take(
+    const std::function<bool(QDataStream &)> & reader) const
+{
+    QFile file(m_filePath);
+    if (!file.exists()) {
+        return false;
+    }
+
+    QNDEBUG("model:snapshot", "ModelSnapshot::take: " << m_filePath);
+
+    bool res = false;
+    const qint64 size = file.size();
+
+    if (Q_UNLIKELY(size > std::numeric_limits<int>::max())) {
+        QNWARNING(
+            "model:snapshot",
+            "Model snapshot file is too large: " << m_filePath << ", size = "
+                                                 << size);
+    }
+    else if (!file.open(QIODevice::ReadOnly)) {
+        QNWARNING(
+            "model:snapshot",
+            "Failed to open model snapshot file for reading: "
+                << m_filePath << ": " << file.errorString());
+    }
+    else {
+        uchar * pData = (size > 0 ? file.map(0, size) : nullptr);
+        if (!pData) {
+            QNWARNING(
+                "model:snapshot",
+                "Failed to map model snapshot file into memory: "
+                    << m_filePath << ": " << file.errorString());
+        }
+        else {
+            // The byte array doesn't copy the mapped data so it must not
+            // outlive the mapping
+            QByteArray data = QByteArray::fromRawData(
+                reinterpret_cast<const char *>(pData), static_cast<int>(size));
+
+            QDataStream in(data);
+            in.setVersion(QDataStream::Qt_5_5);
+
+            quint32 magic = 0;
+            quint32 formatVersion = 0;
+            in >> magic >> formatVersion;
+
+            if ((in.status() != QDataStream::Ok) ||
+                (magic != MODEL_SNAPSHOT_MAGIC) ||
+                (formatVersion != MODEL_SNAPSHOT_FORMAT_VERSION))
+            {
+                QNINFO(
+                    "model:snapshot",
+                    "Ignoring model snapshot of unknown format: "
+                        << m_filePath);
+            }
+            else {
+                res = reader(in) && (in.status() == QDataStream::Ok);
+                if (!res) {
+                    QNWARNING(
+                        "model:snapshot",
+                        "Failed to read model snapshot: " << m_filePath);
+                }
+            }
+        }
+
+        if (pData) {
+            Q_UNUSED(file.unmap(pData))
+        }
+
+        file.close();
+    }
+
+    if (!file.remove()) {
+        QNWARNING(
+            "model:snapshot",
+            "Failed to remove model snapshot file: "
+                << m_filePath << ": " << file.errorString());
+    }
+
+    return res;
+}
+
+} // namespace quentier
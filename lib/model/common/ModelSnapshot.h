@@ -0,0 +1,68 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_COMMON_MODEL_SNAPSHOT_H
+#define QUENTIER_LIB_MODEL_COMMON_MODEL_SNAPSHOT_H
+
+#include <quentier/types/Account.h>
+
+#include <QString>
+
+#include <functional>
+
+QT_FORWARD_DECLARE_CLASS(QDataStream)
+
+namespace quentier {
+
+/**
+ * @brief The ModelSnapshot class reads and writes the binary snapshot file
+ * of a model's items persisted between the runs of the app
+ *
+ * The snapshot is written when the model is destroyed after having listed
+ * all its items and is taken, i.e. read and removed, on the next start.
+ * If the app doesn't shut down cleanly, there's no snapshot to take during
+ * the next start so the snapshot which is present is in sync with the local
+ * storage unless the latter was modified outside of the app.
+ */
+class ModelSnapshot
+{
+public:
+    ModelSnapshot(const Account & account, const QString & name);
+
+    /**
+     * @brief write - atomically replaces the snapshot file with the data
+     * written by the writer
+     * @return      True if the snapshot was written successfully
+     */
+    bool write(const std::function<void(QDataStream &)> & writer) const;
+
+    /**
+     * @brief take - maps the snapshot file into memory and lets the reader
+     * read the data from it, then removes the file
+     * @return      True if the snapshot file existed and the reader read it
+     *              successfully
+     */
+    bool take(const std::function<bool(QDataStream &)> & reader) const;
+
+private:
+    QString m_filePath;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_COMMON_MODEL_SNAPSHOT_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StringPool.h"
+
+namespace quentier {
+
+QString StringPool::intern(const QString & str)
+{
+    if (str.isEmpty()) {
+        return {};
+    }
+
+    auto it = m_strings.constFind(str);
+    if (it != m_strings.constEnd()) {
+        return *it;
+    }
+
+    Q_UNUSED(m_strings.insert(str))
+    return str;
+}
+
+QStringList StringPool::intern(QStringList strs)
+{
+    for (auto & str: strs) {
+        str = intern(str);
+    }
+
+    return strs;
+}
+
+int StringPool::size() const
+{
+    return m_strings.size();
+}
+
+void StringPool::clear()
+{
+    m_strings.clear();
+}
+
+} // namespace quentier
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_COMMON_STRING_POOL_H
+#define QUENTIER_LIB_MODEL_COMMON_STRING_POOL_H
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace quentier {
+
+/**
+ * @brief The StringPool class interns strings: equal strings passed through
+ * the pool share the same implicitly shared data so that model items
+ * referencing the same notebooks or tags don't hold separate copies of
+ * the same local uids and guids
+ *
+ * Clearing the pool doesn't affect the strings already interned: they keep
+ * their data alive through implicit sharing.
+ */
+class StringPool
+{
+public:
+    QString intern(const QString & str);
+
+    /**
+     * @brief intern - interns each string within the list
+     */
+    QStringList intern(QStringList strs);
+
+    int size() const;
+    void clear();
+
+private:
+    QSet<QString> m_strings;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_COMMON_STRING_POOL_H
@@ -18,9 +18,15 @@
 
 #include "FavoritesModel.h"
 
+#include <lib/model/notebook/NotebookModel.h>
+#include <lib/model/tag/TagModel.h>
+
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/Compat.h>
 
+#include <QDataStream>
+#include <QTimer>
+
 #include <algorithm>
 #include <utility>
 
@@ -41,14 +47,13 @@ FavoritesModel::FavoritesModel(
     SavedSearchCache & savedSearchCache, QObject * parent) :
     AbstractItemModel(account, parent),
     m_noteCache(noteCache), m_notebookCache(notebookCache),
-    m_tagCache(tagCache), m_savedSearchCache(savedSearchCache)
+    m_tagCache(tagCache), m_savedSearchCache(savedSearchCache),
+    m_listNotesPagingPolicy(NOTE_LIST_LIMIT),
+    m_listNotebooksPagingPolicy(NOTEBOOK_LIST_LIMIT),
+    m_listTagsPagingPolicy(TAG_LIST_LIMIT),
+    m_listSavedSearchesPagingPolicy(SAVED_SEARCH_LIST_LIMIT)
 {
     createConnections(localStorageManagerAsync);
-
-    requestNotebooksList();
-    requestTagsList();
-    requestNotesList();
-    requestSavedSearchesList();
 }
 
 FavoritesModel::~FavoritesModel() {}
@@ -83,6 +88,61 @@ const FavoritesModelItem * FavoritesModel::itemAtRow(const int row) const
     return &(rowIndex[static_cast<size_t>(row)]);
 }
 
+void FavoritesModel::setNotebookModel(NotebookModel * pNotebookModel)
+{
+    QNDEBUG("model:favorites", "FavoritesModel::setNotebookModel");
+
+    if (m_pNotebookModel == pNotebookModel) {
+        return;
+    }
+
+    if (!m_pNotebookModel.isNull()) {
+        QObject::disconnect(
+            m_pNotebookModel.data(), &NotebookModel::dataChanged, this,
+            &FavoritesModel::onNotebookModelDataChanged);
+    }
+
+    m_pNotebookModel = pNotebookModel;
+
+    if (m_pNotebookModel.isNull()) {
+        return;
+    }
+
+    QObject::connect(
+        m_pNotebookModel.data(), &NotebookModel::dataChanged, this,
+        &FavoritesModel::onNotebookModelDataChanged);
+
+    requestNoteCountForAllNotebooks(
+        NoteCountRequestOption::IfNotAlreadyRunning);
+}
+
+void FavoritesModel::setTagModel(TagModel * pTagModel)
+{
+    QNDEBUG("model:favorites", "FavoritesModel::setTagModel");
+
+    if (m_pTagModel == pTagModel) {
+        return;
+    }
+
+    if (!m_pTagModel.isNull()) {
+        QObject::disconnect(
+            m_pTagModel.data(), &TagModel::dataChanged, this,
+            &FavoritesModel::onTagModelDataChanged);
+    }
+
+    m_pTagModel = pTagModel;
+
+    if (m_pTagModel.isNull()) {
+        return;
+    }
+
+    QObject::connect(
+        m_pTagModel.data(), &TagModel::dataChanged, this,
+        &FavoritesModel::onTagModelDataChanged);
+
+    requestNoteCountForAllTags(NoteCountRequestOption::IfNotAlreadyRunning);
+}
+
 QModelIndex FavoritesModel::indexForLocalUid(const QString & localUid) const
 {
     const auto & localUidIndex = m_data.get<ByLocalUid>();
@@ -1016,20 +1076,25 @@ void FavoritesModel::onListNotesComplete(
             << ", num found notes = " << foundNotes.size()
             << ", request id = " << requestId);
 
-    for (const auto & foundNote: qAsConst(foundNotes)) {
-        onNoteAddedOrUpdated(foundNote);
-    }
-
     m_listNotesRequestId = QUuid();
 
-    if (!foundNotes.isEmpty()) {
+    bool hasMorePages = m_listNotesPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundNotes.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:favorites",
-            "The number of found notes is greater than "
-                << "zero, requesting more notes from the local storage");
+            "The page of found notes is full, requesting more notes "
+                << "from the local storage");
+
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listNotesOffset += static_cast<size_t>(foundNotes.size());
         requestNotesList();
-        return;
+    }
+
+    for (const auto & foundNote: qAsConst(foundNotes)) {
+        onNoteAddedOrUpdated(foundNote);
     }
 
     checkAllItemsListed();
@@ -1067,6 +1132,9 @@ void FavoritesModel::onListNotesFailed(
 
     m_listNotesRequestId = QUuid();
 
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -1079,11 +1147,31 @@ void FavoritesModel::onExpungeNoteComplete(Note note, QUuid requestId)
 
     removeItemByLocalUid(note.localUid());
 
-    // Since it's unclear whether some notebook within the favorites model was
-    // affected, need to check and re-subscribe to the note counts for all
-    // notebooks
-    requestNoteCountForAllNotebooks(NoteCountRequestOption::Force);
-    requestNoteCountForAllTags(NoteCountRequestOption::Force);
+    // The deleted note didn't contribute to note counts of its notebook and
+    // tags so its expunging doesn't affect them
+    if (note.hasDeletionTimestamp()) {
+        return;
+    }
+
+    // If the expunged note doesn't tell which notebook and tags it belonged
+    // to, it's unclear whether some notebook or tag within the favorites model
+    // was affected so need to re-request the note counts for all of them
+    if (note.hasNotebookLocalUid()) {
+        checkAndDecrementNoteCountPerNotebook(note.notebookLocalUid());
+    }
+    else {
+        requestNoteCountForAllNotebooks(NoteCountRequestOption::Force);
+    }
+
+    if (note.hasTagLocalUids()) {
+        const QStringList & tagLocalUids = note.tagLocalUids();
+        for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
+            checkAndDecrementNoteCountPerTag(tagLocalUid);
+        }
+    }
+    else {
+        requestNoteCountForAllTags(NoteCountRequestOption::Force);
+    }
 }
 
 void FavoritesModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
@@ -1249,21 +1337,25 @@ void FavoritesModel::onListNotebooksComplete(
             << ", num found notebooks = " << foundNotebooks.size()
             << ", request id = " << requestId);
 
-    for (const auto & foundNotebook: qAsConst(foundNotebooks)) {
-        onNotebookAddedOrUpdated(foundNotebook);
-    }
-
     m_listNotebooksRequestId = QUuid();
 
-    if (!foundNotebooks.isEmpty()) {
+    bool hasMorePages = m_listNotebooksPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundNotebooks.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:favorites",
-            "The number of found notebooks is greater "
-                << "than zero, requesting more notebooks from the local "
-                   "storage");
+            "The page of found notebooks is full, requesting more notebooks "
+                << "from the local storage");
+
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listNotebooksOffset += static_cast<size_t>(foundNotebooks.size());
         requestNotebooksList();
-        return;
+    }
+
+    for (const auto & foundNotebook: qAsConst(foundNotebooks)) {
+        onNotebookAddedOrUpdated(foundNotebook);
     }
 
     checkAllItemsListed();
@@ -1292,6 +1384,9 @@ void FavoritesModel::onListNotebooksFailed(
 
     m_listNotebooksRequestId = QUuid();
 
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -1460,20 +1555,25 @@ void FavoritesModel::onListTagsComplete(
             << ", num found tags = " << foundTags.size()
             << ", request id = " << requestId);
 
-    for (const auto & foundTag: qAsConst(foundTags)) {
-        onTagAddedOrUpdated(foundTag);
-    }
-
     m_listTagsRequestId = QUuid();
 
-    if (!foundTags.isEmpty()) {
+    bool hasMorePages = m_listTagsPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundTags.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:favorites",
-            "The number of found tags is greater than "
-                << "zero, requesting more tags from the local storage");
+            "The page of found tags is full, requesting more tags "
+                << "from the local storage");
+
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listTagsOffset += static_cast<size_t>(foundTags.size());
         requestTagsList();
-        return;
+    }
+
+    for (const auto & foundTag: qAsConst(foundTags)) {
+        onTagAddedOrUpdated(foundTag);
     }
 
     checkAllItemsListed();
@@ -1502,6 +1602,9 @@ void FavoritesModel::onListTagsFailed(
 
     m_listTagsRequestId = QUuid();
 
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -1691,23 +1794,27 @@ void FavoritesModel::onListSavedSearchesComplete(
             << ", direction = " << orderDirection << ", num found searches = "
             << foundSearches.size() << ", request id = " << requestId);
 
-    for (auto it = foundSearches.begin(), end = foundSearches.end(); it != end;
-         ++it)
-    {
-        onSavedSearchAddedOrUpdated(*it);
-    }
-
     m_listSavedSearchesRequestId = QUuid();
 
-    if (!foundSearches.isEmpty()) {
+    bool hasMorePages = m_listSavedSearchesPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundSearches.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:favorites",
-            "The number of found saved searches is not "
-                << "empty, requesting more saved searches from the local "
-                   "storage");
+            "The page of found saved searches is full, requesting more "
+                << "saved searches from the local storage");
+
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listSavedSearchesOffset += static_cast<size_t>(foundSearches.size());
         requestSavedSearchesList();
-        return;
+    }
+
+    for (auto it = foundSearches.begin(), end = foundSearches.end(); it != end;
+         ++it)
+    {
+        onSavedSearchAddedOrUpdated(*it);
     }
 
     checkAllItemsListed();
@@ -1733,6 +1840,9 @@ void FavoritesModel::onListSavedSearchesFailed(
 
     m_listSavedSearchesRequestId = QUuid();
 
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -1766,20 +1876,7 @@ void FavoritesModel::onGetNoteCountPerNotebookComplete(
 
     Q_UNUSED(m_notebookLocalUidToNoteCountRequestIdBimap.right.erase(it))
 
-    auto & localUidIndex = m_data.get<ByLocalUid>();
-    auto itemIt = localUidIndex.find(notebook.localUid());
-    if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-        QNDEBUG(
-            "model:favorites",
-            "Can't find the notebook item within "
-                << "the favorites model for which the note count was received");
-        return;
-    }
-
-    FavoritesModelItem item = *itemIt;
-    item.setNoteCount(noteCount);
-    Q_UNUSED(localUidIndex.replace(itemIt, item))
-    updateItemColumnInView(item, Column::NoteCount);
+    setItemNoteCount(notebook.localUid(), noteCount);
 }
 
 void FavoritesModel::onGetNoteCountPerNotebookFailed(
@@ -1827,20 +1924,7 @@ void FavoritesModel::onGetNoteCountPerTagComplete(
 
     Q_UNUSED(m_tagLocalUidToNoteCountRequestIdBimap.right.erase(it))
 
-    auto & localUidIndex = m_data.get<ByLocalUid>();
-    auto itemIt = localUidIndex.find(tag.localUid());
-    if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-        QNDEBUG(
-            "model:favorites",
-            "Can't find the tag item within "
-                << "the favorites model for which the note count was received");
-        return;
-    }
-
-    FavoritesModelItem item = *itemIt;
-    item.setNoteCount(noteCount);
-    Q_UNUSED(localUidIndex.replace(itemIt, item))
-    updateItemColumnInView(item, Column::NoteCount);
+    setItemNoteCount(tag.localUid(), noteCount);
 }
 
 void FavoritesModel::onGetNoteCountPerTagFailed(
@@ -1867,6 +1951,162 @@ void FavoritesModel::onGetNoteCountPerTagFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
+void FavoritesModel::onNotebookModelDataChanged(
+    const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+    int noteCountColumn = static_cast<int>(NotebookModel::Column::NoteCount);
+    if ((topLeft.column() > noteCountColumn) ||
+        (bottomRight.column() < noteCountColumn))
+    {
+        return;
+    }
+
+    QNTRACE("model:favorites", "FavoritesModel::onNotebookModelDataChanged");
+    setNoteCountsFromNotebookModel();
+}
+
+void FavoritesModel::setNoteCountsFromNotebookModel()
+{
+    QNTRACE(
+        "model:favorites", "FavoritesModel::setNoteCountsFromNotebookModel");
+
+    m_noteCountsFromNotebookModelPending = false;
+
+    // There are few favorited notebooks so it's cheaper to check all of them
+    // than to find out which notebooks the changed range corresponds to
+    QStringList notebookLocalUids;
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & item: localUidIndex) {
+        if (item.type() == FavoritesModelItem::Type::Notebook) {
+            notebookLocalUids << item.localUid();
+        }
+    }
+
+    for (const auto & notebookLocalUid: qAsConst(notebookLocalUids)) {
+        Q_UNUSED(setNoteCountFromNotebookModel(notebookLocalUid))
+    }
+}
+
+void FavoritesModel::onTagModelDataChanged(
+    const QModelIndex & topLeft, const QModelIndex & bottomRight)
+{
+    int noteCountColumn = static_cast<int>(TagModel::Column::NoteCount);
+    if ((topLeft.column() > noteCountColumn) ||
+        (bottomRight.column() < noteCountColumn))
+    {
+        return;
+    }
+
+    QNTRACE("model:favorites", "FavoritesModel::onTagModelDataChanged");
+
+    // There are few favorited tags so it's cheaper to check all of them
+    // than to find out which tags the changed range corresponds to
+    QStringList tagLocalUids;
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & item: localUidIndex) {
+        if (item.type() == FavoritesModelItem::Type::Tag) {
+            tagLocalUids << item.localUid();
+        }
+    }
+
+    for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
+        Q_UNUSED(setNoteCountFromTagModel(tagLocalUid))
+    }
+}
+
+void FavoritesModel::startListing()
+{
+    QNDEBUG("model:favorites", "FavoritesModel::startListing");
+
+    requestNotebooksList();
+    requestTagsList();
+    requestNotesList();
+    requestSavedSearchesList();
+}
+
+void FavoritesModel::writeSnapshot(QDataStream & out) const
+{
+    const auto & rowIndex = m_data.get<ByIndex>();
+    out << static_cast<quint32>(rowIndex.size());
+
+    for (const auto & item: rowIndex) {
+        out << static_cast<qint32>(item.type()) << item.localUid()
+            << item.displayName() << static_cast<qint32>(item.noteCount());
+    }
+}
+
+bool FavoritesModel::readSnapshot(QDataStream & in, QStringList & localUids)
+{
+    quint32 numItems = 0;
+    in >> numItems;
+
+    QList<FavoritesModelItem> items;
+    for (quint32 i = 0; i < numItems && in.status() == QDataStream::Ok; ++i) {
+        qint32 type = 0;
+        QString localUid;
+        QString displayName;
+        qint32 noteCount = 0;
+
+        in >> type >> localUid >> displayName >> noteCount;
+
+        if ((type < static_cast<qint32>(FavoritesModelItem::Type::Notebook)) ||
+            (type >= static_cast<qint32>(FavoritesModelItem::Type::Unknown)))
+        {
+            return false;
+        }
+
+        items << FavoritesModelItem(
+            static_cast<FavoritesModelItem::Type>(type), localUid, displayName,
+            noteCount);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto & rowIndex = m_data.get<ByIndex>();
+
+    for (const auto & item: qAsConst(items)) {
+        if (localUidIndex.find(item.localUid()) != localUidIndex.end()) {
+            continue;
+        }
+
+        switch (item.type()) {
+        case FavoritesModelItem::Type::Notebook:
+            Q_UNUSED(m_lowerCaseNotebookNames.insert(
+                item.displayName().toLower()))
+            break;
+        case FavoritesModelItem::Type::Tag:
+            Q_UNUSED(m_lowerCaseTagNames.insert(item.displayName().toLower()))
+            break;
+        case FavoritesModelItem::Type::SavedSearch:
+            Q_UNUSED(m_lowerCaseSavedSearchNames.insert(
+                item.displayName().toLower()))
+            break;
+        default:
+            break;
+        }
+
+        int row = static_cast<int>(rowIndex.size());
+        beginInsertRows(QModelIndex(), row, row);
+        rowIndex.push_back(item);
+        endInsertRows();
+
+        updateItemRowWithRespectToSorting(item);
+        localUids << item.localUid();
+    }
+
+    return true;
+}
+
+void FavoritesModel::removeSnapshotItems(const QStringList & localUids)
+{
+    for (const auto & localUid: localUids) {
+        removeItemByLocalUid(localUid);
+    }
+}
+
 void FavoritesModel::createConnections(
     LocalStorageManagerAsync & localStorageManagerAsync)
 {
@@ -2130,6 +2370,8 @@ void FavoritesModel::requestNotesList()
         "Emitting the request to list notes: offset = "
             << m_listNotesOffset << ", request id = " << m_listNotesRequestId);
 
+    size_t limit = m_listNotesPagingPolicy.onPageRequested();
+
     Q_EMIT listNotes(
         flags,
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -2137,7 +2379,7 @@ void FavoritesModel::requestNotesList()
 #else
         LocalStorageManager::GetNoteOptions(0),
 #endif
-        NOTE_LIST_LIMIT, m_listNotesOffset, order, direction, QString(),
+        limit, m_listNotesOffset, order, direction, QString(),
         m_listNotesRequestId);
 }
 
@@ -2169,9 +2411,11 @@ void FavoritesModel::requestNotebooksList()
             << "offset = " << m_listNotebooksOffset
             << ", request id = " << m_listNotebooksRequestId);
 
+    size_t limit = m_listNotebooksPagingPolicy.onPageRequested();
+
     Q_EMIT listNotebooks(
-        flags, NOTEBOOK_LIST_LIMIT, m_listNotebooksOffset, order, direction,
-        QString(), m_listNotebooksRequestId);
+        flags, limit, m_listNotebooksOffset, order, direction, QString(),
+        m_listNotebooksRequestId);
 }
 
 void FavoritesModel::requestTagsList()
@@ -2199,8 +2443,10 @@ void FavoritesModel::requestTagsList()
         "Emitting the request to list tags: offset = "
             << m_listTagsOffset << ", request id = " << m_listTagsRequestId);
 
+    size_t limit = m_listTagsPagingPolicy.onPageRequested();
+
     Q_EMIT listTags(
-        flags, TAG_LIST_LIMIT, m_listTagsOffset, order, direction, QString(),
+        flags, limit, m_listTagsOffset, order, direction, QString(),
         m_listTagsRequestId);
 }
 
@@ -2231,9 +2477,11 @@ void FavoritesModel::requestSavedSearchesList()
             << "offset = " << m_listSavedSearchesOffset
             << ", request id = " << m_listSavedSearchesRequestId);
 
+    size_t limit = m_listSavedSearchesPagingPolicy.onPageRequested();
+
     Q_EMIT listSavedSearches(
-        flags, SAVED_SEARCH_LIST_LIMIT, m_listSavedSearchesOffset, order,
-        direction, m_listSavedSearchesRequestId);
+        flags, limit, m_listSavedSearchesOffset, order, direction,
+        m_listSavedSearchesRequestId);
 }
 
 void FavoritesModel::requestNoteCountForNotebook(
@@ -2245,6 +2493,10 @@ void FavoritesModel::requestNoteCountForNotebook(
             << "notebook lcoal uid = " << notebookLocalUid
             << ", note count request option = " << option);
 
+    if (setNoteCountFromNotebookModel(notebookLocalUid)) {
+        return;
+    }
+
     if (option != NoteCountRequestOption::Force) {
         auto it = m_notebookLocalUidToNoteCountRequestIdBimap.left.find(
             notebookLocalUid);
@@ -2326,6 +2578,19 @@ void FavoritesModel::checkAndDecrementNoteCountPerNotebook(
 void FavoritesModel::checkAndAdjustNoteCountPerNotebook(
     const QString & notebookLocalUid, const bool increment)
 {
+    // The notebook model adjusts its own note count in response to the same
+    // event but its slot may be invoked either before or after this one, so
+    // the count is taken from it once all slots have processed the event
+    if (!m_pNotebookModel.isNull() &&
+        (m_pNotebookModel->noteCountForNotebook(notebookLocalUid) >= 0))
+    {
+        if (!m_noteCountsFromNotebookModelPending) {
+            m_noteCountsFromNotebookModelPending = true;
+            QTimer::singleShot(0, this, SLOT(setNoteCountsFromNotebookModel()));
+        }
+        return;
+    }
+
     auto requestIt =
         m_notebookLocalUidToNoteCountRequestIdBimap.left.find(notebookLocalUid);
 
@@ -2381,6 +2646,10 @@ void FavoritesModel::requestNoteCountForTag(
             << "tag local uid = " << tagLocalUid
             << ", note count request option = " << option);
 
+    if (setNoteCountFromTagModel(tagLocalUid)) {
+        return;
+    }
+
     if (option != NoteCountRequestOption::Force) {
         auto it = m_tagLocalUidToNoteCountRequestIdBimap.left.find(tagLocalUid);
         if (it != m_tagLocalUidToNoteCountRequestIdBimap.left.end()) {
@@ -2451,6 +2720,11 @@ void FavoritesModel::checkAndDecrementNoteCountPerTag(
 void FavoritesModel::checkAndAdjustNoteCountPerTag(
     const QString & tagLocalUid, const bool increment)
 {
+    // See the comment in checkAndAdjustNoteCountPerNotebook
+    if (setNoteCountFromTagModel(tagLocalUid)) {
+        return;
+    }
+
     auto requestIt =
         m_tagLocalUidToNoteCountRequestIdBimap.left.find(tagLocalUid);
 
@@ -2491,6 +2765,77 @@ void FavoritesModel::checkAndAdjustNoteCountPerTag(
     updateItemColumnInView(item, Column::NoteCount);
 }
 
+bool FavoritesModel::setNoteCountFromNotebookModel(
+    const QString & notebookLocalUid)
+{
+    if (m_pNotebookModel.isNull()) {
+        return false;
+    }
+
+    int noteCount = m_pNotebookModel->noteCountForNotebook(notebookLocalUid);
+    if (noteCount < 0) {
+        return false;
+    }
+
+    QNTRACE(
+        "model:favorites",
+        "Using the note count from the notebook model for notebook "
+            << notebookLocalUid << ": " << noteCount);
+
+    // The result of the request to the local storage is no longer needed
+    Q_UNUSED(m_notebookLocalUidToNoteCountRequestIdBimap.left.erase(
+        notebookLocalUid))
+
+    setItemNoteCount(notebookLocalUid, noteCount);
+    return true;
+}
+
+bool FavoritesModel::setNoteCountFromTagModel(const QString & tagLocalUid)
+{
+    if (m_pTagModel.isNull()) {
+        return false;
+    }
+
+    int noteCount = m_pTagModel->noteCountForTag(tagLocalUid);
+    if (noteCount < 0) {
+        return false;
+    }
+
+    QNTRACE(
+        "model:favorites",
+        "Using the note count from the tag model for tag "
+            << tagLocalUid << ": " << noteCount);
+
+    // The result of the request to the local storage is no longer needed
+    Q_UNUSED(m_tagLocalUidToNoteCountRequestIdBimap.left.erase(tagLocalUid))
+
+    setItemNoteCount(tagLocalUid, noteCount);
+    return true;
+}
+
+void FavoritesModel::setItemNoteCount(
+    const QString & localUid, const int noteCount)
+{
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto itemIt = localUidIndex.find(localUid);
+    if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+        QNDEBUG(
+            "model:favorites",
+            "Can't find the item within the favorites model for which "
+                << "the note count was received: " << localUid);
+        return;
+    }
+
+    if (itemIt->noteCount() == noteCount) {
+        return;
+    }
+
+    FavoritesModelItem item = *itemIt;
+    item.setNoteCount(noteCount);
+    Q_UNUSED(localUidIndex.replace(itemIt, item))
+    updateItemColumnInView(item, Column::NoteCount);
+}
+
 QVariant FavoritesModel::dataImpl(const int row, const Column column) const
 {
     if (Q_UNLIKELY((row < 0) || (row >= static_cast<int>(m_data.size())))) {
@@ -3219,6 +3564,8 @@ void FavoritesModel::onNoteAddedOrUpdated(
             << "note local uid = " << note.localUid()
             << ", tags updated = " << (tagsUpdated ? "true" : "false"));
 
+    confirmSnapshotItem(note.localUid());
+
     if (tagsUpdated) {
         m_noteCache.put(note.localUid(), note);
     }
@@ -3275,6 +3622,14 @@ void FavoritesModel::onNoteAddedOrUpdated(
         return;
     }
 
+    if (itemIt->displayName() == item.displayName()) {
+        QNTRACE(
+            "model:favorites",
+            "The favorited note's display name is unchanged, nothing to "
+                << "update");
+        return;
+    }
+
     QNDEBUG("model:favorites", "Updating the already favorited item");
 
     auto indexIt = m_data.project<ByIndex>(itemIt);
@@ -3313,6 +3668,7 @@ void FavoritesModel::onNotebookAddedOrUpdated(const Notebook & notebook)
         "FavoritesModel::onNotebookAddedOrUpdated: "
             << "local uid = " << notebook.localUid());
 
+    confirmSnapshotItem(notebook.localUid());
     m_notebookCache.put(notebook.localUid(), notebook);
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
@@ -3421,9 +3777,16 @@ void FavoritesModel::onNotebookAddedOrUpdated(const Notebook & notebook)
         return;
     }
 
+    const auto & originalItem = *itemIt;
+    if (originalItem.displayName() == item.displayName()) {
+        QNTRACE(
+            "model:favorites",
+            "The favorited notebook's name is unchanged, nothing to update");
+        return;
+    }
+
     QNDEBUG("model:favorites", "Updating the already favorited notebook item");
 
-    const auto & originalItem = *itemIt;
     item.setNoteCount(originalItem.noteCount());
 
     auto indexIt = m_data.project<ByIndex>(itemIt);
@@ -3462,6 +3825,7 @@ void FavoritesModel::onTagAddedOrUpdated(const Tag & tag)
         "FavoritesModel::onTagAddedOrUpdated: "
             << "local uid = " << tag.localUid());
 
+    confirmSnapshotItem(tag.localUid());
     m_tagCache.put(tag.localUid(), tag);
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
@@ -3523,9 +3887,16 @@ void FavoritesModel::onTagAddedOrUpdated(const Tag & tag)
         return;
     }
 
+    const auto & originalItem = *itemIt;
+    if (originalItem.displayName() == item.displayName()) {
+        QNTRACE(
+            "model:favorites",
+            "The favorited tag's name is unchanged, nothing to update");
+        return;
+    }
+
     QNDEBUG("model:favorites", "Updating the already favorited tag item");
 
-    const auto & originalItem = *itemIt;
     item.setNoteCount(originalItem.noteCount());
 
     auto indexIt = m_data.project<ByIndex>(itemIt);
@@ -3564,6 +3935,7 @@ void FavoritesModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
         "FavoritesModel::onSavedSearchAddedOrUpdated: "
             << "local uid = " << search.localUid());
 
+    confirmSnapshotItem(search.localUid());
     m_savedSearchCache.put(search.localUid(), search);
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
@@ -22,6 +22,7 @@
 #include "FavoritesModelItem.h"
 
 #include <lib/model/common/AbstractItemModel.h>
+#include <lib/model/common/ListPagingPolicy.h>
 #include <lib/model/note/NoteCache.h>
 #include <lib/model/notebook/NotebookCache.h>
 #include <lib/model/saved_search/SavedSearchCache.h>
@@ -38,6 +39,7 @@
 
 #include <QAbstractItemModel>
 #include <QHash>
+#include <QPointer>
 #include <QSet>
 #include <QUuid>
 
@@ -57,6 +59,9 @@ QT_FORWARD_DECLARE_CLASS(QDebug)
 
 namespace quentier {
 
+class NotebookModel;
+class TagModel;
+
 class FavoritesModel final : public AbstractItemModel
 {
     Q_OBJECT
@@ -83,6 +88,24 @@ public:
 
     const FavoritesModelItem * itemAtRow(const int row) const;
 
+    /**
+     * @brief setNotebookModel - sets the notebook model which note counts
+     * are used for favorited notebooks instead of querying the local storage
+     * whenever the notebook model knows them
+     *
+     * @param pNotebookModel        The notebook model, can be null
+     */
+    void setNotebookModel(NotebookModel * pNotebookModel);
+
+    /**
+     * @brief setTagModel - sets the tag model which note counts are used for
+     * favorited tags instead of querying the local storage whenever the tag
+     * model knows them
+     *
+     * @param pTagModel             The tag model, can be null
+     */
+    void setTagModel(TagModel * pTagModel);
+
 public:
     // AbstractItemModel interface
     virtual QString localUidForItemName(
@@ -411,7 +434,25 @@ private Q_SLOTS:
         ErrorString errorDescription, Tag tag,
         LocalStorageManager::NoteCountOptions options, QUuid requestId);
 
+    // For note counts kept by notebook and tag models:
+    void onNotebookModelDataChanged(
+        const QModelIndex & topLeft, const QModelIndex & bottomRight);
+
+    void onTagModelDataChanged(
+        const QModelIndex & topLeft, const QModelIndex & bottomRight);
+
+    void setNoteCountsFromNotebookModel();
+
 private:
+    // AbstractItemModel interface
+    virtual void startListing() override;
+    virtual void writeSnapshot(QDataStream & out) const override;
+
+    virtual bool readSnapshot(
+        QDataStream & in, QStringList & localUids) override;
+
+    virtual void removeSnapshotItems(const QStringList & localUids) override;
+
     void createConnections(LocalStorageManagerAsync & localStorageManagerAsync);
     void requestNotesList();
     void requestNotebooksList();
@@ -454,6 +495,26 @@ private:
     void checkAndAdjustNoteCountPerTag(
         const QString & tagLocalUid, const bool increment);
 
+    /**
+     * @brief setNoteCountFromNotebookModel - takes the note count for
+     * the favorited notebook from the notebook model
+     *
+     * @return                      True if the notebook model knows the note
+     *                              count for the notebook, false otherwise
+     */
+    bool setNoteCountFromNotebookModel(const QString & notebookLocalUid);
+
+    /**
+     * @brief setNoteCountFromTagModel - takes the note count for the favorited
+     * tag from the tag model
+     *
+     * @return                      True if the tag model knows the note count
+     *                              for the tag, false otherwise
+     */
+    bool setNoteCountFromTagModel(const QString & tagLocalUid);
+
+    void setItemNoteCount(const QString & localUid, const int noteCount);
+
     QVariant dataImpl(const int row, const Column column) const;
 
     QVariant dataAccessibleText(const int row, const Column column) const;
@@ -545,20 +606,27 @@ private:
     TagCache & m_tagCache;
     SavedSearchCache & m_savedSearchCache;
 
+    QPointer<NotebookModel> m_pNotebookModel;
+    QPointer<TagModel> m_pTagModel;
+
     QSet<QString> m_lowerCaseNotebookNames;
     QSet<QString> m_lowerCaseTagNames;
     QSet<QString> m_lowerCaseSavedSearchNames;
 
     size_t m_listNotesOffset = 0;
+    ListPagingPolicy m_listNotesPagingPolicy;
     QUuid m_listNotesRequestId;
 
     size_t m_listNotebooksOffset = 0;
+    ListPagingPolicy m_listNotebooksPagingPolicy;
     QUuid m_listNotebooksRequestId;
 
     size_t m_listTagsOffset = 0;
+    ListPagingPolicy m_listTagsPagingPolicy;
     QUuid m_listTagsRequestId;
 
     size_t m_listSavedSearchesOffset = 0;
+    ListPagingPolicy m_listSavedSearchesPagingPolicy;
     QUuid m_listSavedSearchesRequestId;
 
     QSet<QUuid> m_updateNoteRequestIds;
@@ -595,6 +663,7 @@ private:
     Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
 
     bool m_allItemsListed = false;
+    bool m_noteCountsFromNotebookModelPending = false;
 };
 
 } // namespace quentier
@@ -18,6 +18,7 @@
 
 #include "LogViewerModel.h"
 #include "LogViewerModelFileReaderAsync.h"
+#include "LogViewerModelLogFileIndexer.h"
 
 #include <lib/preferences/keys/Logging.h>
 
@@ -42,9 +43,12 @@
 
 #define LOG_VIEWER_MODEL_COLUMN_COUNT                (6)
 #define LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET  (1000)
-#define LOG_VIEWER_MODEL_LOG_FILE_POLLING_TIMER_MSEC (500)
 #define LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE     (700)
 
+// The current log file is mostly tailed using file system watcher's
+// notifications, polling is only the fallback for when they don't come
+#define LOG_VIEWER_MODEL_LOG_FILE_POLLING_TIMER_MSEC (3000)
+
 #define LVMDEBUG(message)                                                      \
     if (m_internalLogEnabled) {                                                \
         QString msg;                                                           \
@@ -127,6 +131,11 @@ LogViewerModel::~LogViewerModel()
         m_pFileReaderAsync->disconnect(this);
         m_pFileReaderAsync = nullptr;
     }
+
+    if (m_pLogFileIndexer) {
+        m_pLogFileIndexer->disconnect(this);
+        m_pLogFileIndexer = nullptr;
+    }
 }
 
 QString LogViewerModel::logFileName() const
@@ -191,6 +200,8 @@ void LogViewerModel::setLogFileName(
     currentLogFile.close();
 
     m_currentLogFileSize = m_currentLogFileInfo.size();
+
+    m_currentLogFileWatcherNotified = false;
     m_currentLogFileSizePollingTimer.start(
         LOG_VIEWER_MODEL_LOG_FILE_POLLING_TIMER_MSEC, this);
 
@@ -204,8 +215,7 @@ void LogViewerModel::setLogFileName(
              ? m_filteringOptions.m_startLogFilePos.ref()
              : qint64(0));
 
-    requestDataEntriesChunkFromLogFile(
-        startPos, LogFileDataEntryRequestReason::InitialRead);
+    startLogFileIndexing(startPos);
 }
 
 qint64 LogViewerModel::startLogFilePos() const
@@ -389,9 +399,12 @@ bool LogViewerModel::wipeCurrentLogFile(ErrorString & errorDescription)
 
         m_logFileChunksMetadata.clear();
         m_logFileChunkDataCache.clear();
-        m_canReadMoreLogFileChunks = false;
-
         m_logFilePosRequestedToBeRead.clear();
+
+        if (m_pLogFileIndexer) {
+            stopLogFileIndexing();
+            startLogFileIndexing(0);
+        }
     }
 
     endResetModel();
@@ -417,13 +430,11 @@ void LogViewerModel::clear()
 
     m_logFileChunksMetadata.clear();
     m_logFileChunkDataCache.clear();
-
-    m_canReadMoreLogFileChunks = false;
-
     m_logFilePosRequestedToBeRead.clear();
 
     m_currentLogFileSize = 0;
     m_currentLogFileSizePollingTimer.stop();
+    m_currentLogFileWatcherNotified = false;
 
     // NOTE: not stopping the file reader async's thread and not deleting
     // the async file reader immediately, just disconnect from it, mark it for
@@ -434,6 +445,8 @@ void LogViewerModel::clear()
         m_pFileReaderAsync = nullptr;
     }
 
+    stopLogFileIndexing();
+
     // NOTE: not changing anything about the internal log
 
     endResetModel();
@@ -465,18 +478,18 @@ LogViewerModel::dataChunkContainingModelRow(
         return nullptr;
     }
 
-    const auto * pLogFileChunkMetadata =
-        findLogFileChunkMetadataByModelRow(row);
-
-    if (!pLogFileChunkMetadata) {
+    if (row >= m_logEntryStartPositions.size()) {
         return nullptr;
     }
 
+    // Chunks of the indexed log file contain the fixed number of rows
+    int chunkNumber = row / LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
     if (pStartModelRow) {
-        *pStartModelRow = pLogFileChunkMetadata->startModelRow();
+        *pStartModelRow =
+            chunkNumber * LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
     }
 
-    return m_logFileChunkDataCache.get(pLogFileChunkMetadata->number());
+    return m_logFileChunkDataCache.get(chunkNumber);
 }
 
 QString LogViewerModel::dataEntryToString(
@@ -587,12 +600,12 @@ void LogViewerModel::saveModelEntriesToFile(const QString & targetFilePath)
         }
     }
 
-    if (canFetchMore(QModelIndex())) {
-        auto lastIt = indexByNumber.end();
-        --lastIt;
+    auto lastIt = indexByNumber.end();
+    --lastIt;
 
+    if (lastIt->endLogFilePos() < currentLogFileSize) {
         LVMDEBUG(
-            "The model can fetch more entries, requesting "
+            "The log file is not indexed completely yet, requesting "
             << "data entries starting from pos " << lastIt->endLogFilePos());
 
         requestDataEntriesChunkFromLogFile(
@@ -653,16 +666,7 @@ int LogViewerModel::rowCount(const QModelIndex & parent) const
         return 0;
     }
 
-    const auto & indexByNumber =
-        m_logFileChunksMetadata.get<LogFileChunksMetadataByNumber>();
-
-    if (indexByNumber.empty()) {
-        return 0;
-    }
-
-    auto lastIt = indexByNumber.end();
-    --lastIt;
-    return lastIt->endModelRow() + 1;
+    return m_logEntryStartPositions.size();
 }
 
 int LogViewerModel::columnCount(const QModelIndex & parent) const
@@ -731,12 +735,29 @@ QVariant LogViewerModel::data(const QModelIndex & index, int role) const
     const auto * pLogFileChunkMetadata =
         findLogFileChunkMetadataByModelRow(rowIndex);
 
-    if (pLogFileChunkMetadata) {
+    // If only the tail of the chunk is missing and is already being read,
+    // there's no need to read the whole chunk again
+    int startModelRow = 0;
+    const auto * pLogFileDataChunk =
+        dataChunkContainingModelRow(rowIndex, &startModelRow);
+
+    bool chunkTailRequested = pLogFileDataChunk &&
+        m_logFilePosRequestedToBeRead.contains(m_logEntryStartPositions.at(
+            startModelRow + pLogFileDataChunk->size()));
+
+    if (pLogFileChunkMetadata && !chunkTailRequested) {
         const_cast<LogViewerModel *>(this)->requestDataEntriesChunkFromLogFile(
             pLogFileChunkMetadata->startLogFilePos(),
             LogFileDataEntryRequestReason::CacheMiss);
     }
 
+    // Log levels of indexed log entries are known before the entries are read
+    if ((static_cast<Column>(columnIndex) == Column::LogLevel) &&
+        (rowIndex < m_logEntryLogLevels.size()))
+    {
+        return static_cast<qint64>(m_logEntryLogLevels.at(rowIndex));
+    }
+
     return QVariant();
 }
 
@@ -775,53 +796,31 @@ QVariant LogViewerModel::headerData(
     }
 }
 
-bool LogViewerModel::canFetchMore(const QModelIndex & parent) const
-{
-    if (parent.isValid()) {
-        return false;
-    }
-
-    LVMDEBUG(
-        "LogViewerModel::canFetchMore: "
-        << (m_canReadMoreLogFileChunks ? "true" : "false"));
-
-    return m_canReadMoreLogFileChunks;
-}
-
-void LogViewerModel::fetchMore(const QModelIndex & parent)
+void LogViewerModel::onFileChanged(const QString & path)
 {
-    if (parent.isValid()) {
+    if (m_currentLogFileInfo.absoluteFilePath() != path) {
+        // The changed file is not the current log file
         return;
     }
 
-    LVMDEBUG("LogViewerModel::fetchMore");
-
-    qint64 startPos = 0;
-
-    const auto & index =
-        m_logFileChunksMetadata.get<LogFileChunksMetadataByStartLogFilePos>();
-
-    if (!index.empty()) {
-        auto lastIt = index.end();
-        --lastIt;
-
-        startPos = lastIt->endLogFilePos();
-    }
+    LVMDEBUG("LogViewerModel::onFileChanged");
 
-    requestDataEntriesChunkFromLogFile(
-        startPos, LogFileDataEntryRequestReason::FetchMore);
+    m_currentLogFileWatcherNotified = true;
+    processCurrentLogFileChange();
 }
 
-void LogViewerModel::onFileChanged(const QString & path)
+void LogViewerModel::processCurrentLogFileChange()
 {
-    if (m_currentLogFileInfo.absoluteFilePath() != path) {
-        // The changed file is not the current log file
-        return;
-    }
+    QString path = m_currentLogFileInfo.absoluteFilePath();
 
-    LVMDEBUG("LogViewerModel::onFileChanged");
+    // The file might have been replaced with another one in which case
+    // the watch for it might have been dropped
+    if (!m_currentLogFileWatcher.files().contains(path)) {
+        m_currentLogFileWatcher.addPath(path);
+    }
 
     m_currentLogFileInfo.refresh();
+    qint64 fileSize = m_currentLogFileInfo.size();
 
     QFile currentLogFile(path);
     if (!currentLogFile.isOpen() && !currentLogFile.open(QIODevice::ReadOnly)) {
@@ -855,13 +854,21 @@ void LogViewerModel::onFileChanged(const QString & path)
         }
     }
 
-    if (fileStartBytesChanged) {
+    // Log files are only appended to so if the file got smaller than
+    // the already indexed part of it, it was truncated or replaced
+    bool fileTruncated = (fileSize < m_indexedLogFileEndPos) ||
+        (fileSize < m_currentLogFileSize);
+
+    if (fileStartBytesChanged || fileTruncated) {
         // The change within the file is not just the addition of new log entry,
-        // the file's start bytes changed, hence should reset the model
+        // hence should reset the model
 
         LVMDEBUG(
-            "Initial several bytes of the log file have "
-            << "changed, the log file was probably rotated");
+            "The log file was probably rotated or truncated: start bytes "
+            << (fileStartBytesChanged ? "changed" : "didn't change")
+            << ", previous size = " << m_currentLogFileSize
+            << ", new size = " << fileSize
+            << ", indexed end pos = " << m_indexedLogFileEndPos);
 
         m_currentLogFileStartBytesRead = startBytesRead;
 
@@ -876,35 +883,29 @@ void LogViewerModel::onFileChanged(const QString & path)
         m_logFileChunkDataCache.clear();
         m_logFilePosRequestedToBeRead.clear();
 
-        m_canReadMoreLogFileChunks = false;
+        stopLogFileIndexing();
+        startLogFileIndexing(0);
 
-        requestDataEntriesChunkFromLogFile(
-            0, LogFileDataEntryRequestReason::InitialRead);
-
-        m_currentLogFileSize = 0;
+        m_currentLogFileSize = fileSize;
 
         endResetModel();
 
         return;
     }
 
-    // New log entries were appended to the log file, should now be able to
-    // fetch more
-    LVMDEBUG(
-        "The initial bytes of the log file haven't changed "
-        "=> new log entries were added, can read more now");
+    if (fileSize == m_currentLogFileSize) {
+        LVMDEBUG("The size of the log file hasn't changed, nothing to index");
+        return;
+    }
 
-    m_canReadMoreLogFileChunks = true;
+    m_currentLogFileSize = fileSize;
 
-    if (m_logFileChunksMetadata.empty()) {
-        qint64 startPos =
-            (m_filteringOptions.m_startLogFilePos.isSet()
-                 ? m_filteringOptions.m_startLogFilePos.ref()
-                 : qint64(0));
+    // New log entries were appended to the log file, should index them
+    LVMDEBUG(
+        "The initial bytes of the log file haven't changed "
+        "=> new log entries were added, can index them now");
 
-        requestDataEntriesChunkFromLogFile(
-            startPos, LogFileDataEntryRequestReason::InitialRead);
-    }
+    requestLogFileIndexing();
 }
 
 void LogViewerModel::onFileRemoved(const QString & path)
@@ -931,8 +932,9 @@ void LogViewerModel::onFileRemoved(const QString & path)
 
     m_currentLogFileSize = 0;
     m_currentLogFileSizePollingTimer.stop();
+    m_currentLogFileWatcherNotified = false;
 
-    m_canReadMoreLogFileChunks = false;
+    stopLogFileIndexing();
 
     endResetModel();
 }
@@ -1015,111 +1017,42 @@ void LogViewerModel::onLogFileDataEntriesRead(
         return;
     }
 
-    int logFileChunkNumber = 0;
-    int startModelRow = 0;
-    int endModelRow = 0;
-
-    if (!dataEntries.isEmpty()) {
-        auto & indexByStartPos =
-            m_logFileChunksMetadata
-                .get<LogFileChunksMetadataByStartLogFilePos>();
-
-        auto it = findLogFileChunkMetadataIteratorByLogFilePos(fromPos);
-        bool newEntry = (it == indexByStartPos.end());
-        if (newEntry) {
-            const auto & indexByNumber =
-                m_logFileChunksMetadata.get<LogFileChunksMetadataByNumber>();
-
-            if (!indexByNumber.empty()) {
-                auto lastIndexIt = indexByNumber.end();
-                --lastIndexIt;
-                logFileChunkNumber = lastIndexIt->number() + 1;
-                startModelRow = lastIndexIt->endModelRow() + 1;
-            }
-            else {
-                startModelRow = rowCount();
-            }
-
-            endModelRow = startModelRow + dataEntries.size() - 1;
-
-            LVMDEBUG(
-                "Inserting new rows into the model: start row = "
-                << startModelRow << ", end row = " << endModelRow);
-
-            beginInsertRows(QModelIndex(), startModelRow, endModelRow);
-
-            LogFileChunkMetadata metadata(
-                logFileChunkNumber, startModelRow, endModelRow, fromPos,
-                endPos);
-
-            LVMDEBUG("Appending new log file chunk metadata: " << metadata);
-            auto insertResult = m_logFileChunksMetadata.insert(metadata);
-            if (!insertResult.second) {
-                LVMDEBUG(
-                    "The log file chunk metadata was actually "
-                    << "updated, not inserted! Here it is: "
-                    << *insertResult.first);
-            }
-        }
-        else {
-            LogFileChunkMetadata metadata = *it;
-
-            logFileChunkNumber = metadata.number();
-            startModelRow = metadata.startModelRow();
-            endModelRow = startModelRow + dataEntries.size() - 1;
-
-            metadata = LogFileChunkMetadata(
-                logFileChunkNumber, startModelRow, endModelRow, fromPos,
-                endPos);
+    if (reasons.testFlag(LogFileDataEntryRequestReason::CachedChunkTail)) {
+        appendToCachedLogFileChunk(fromPos, dataEntries);
+        return;
+    }
 
-            Q_UNUSED(indexByStartPos.replace(it, metadata))
-            LVMDEBUG("Updated log file chunk metadata: " << metadata);
-        }
+    const auto & indexByStartPos =
+        m_logFileChunksMetadata.get<LogFileChunksMetadataByStartLogFilePos>();
 
-        m_logFileChunkDataCache.put(logFileChunkNumber, dataEntries);
+    auto it = indexByStartPos.find(fromPos);
+    if (it == indexByStartPos.end()) {
         LVMDEBUG(
-            "Put parsed log file data chunk to the LRUCache, "
-            << "chunk number = " << logFileChunkNumber);
-
-        if (newEntry) {
-            LVMDEBUG("End insert rows");
-            endInsertRows();
-        }
-        else {
-            LVMDEBUG(
-                "Notifying the view of the model change: "
-                << "start row = " << startModelRow
-                << ", end row = " << endModelRow);
+            "No indexed log file chunk starts at pos " << fromPos
+            << ", ignoring the read data entries");
+        return;
+    }
 
-            auto startIndex =
-                index(startModelRow, static_cast<int>(Column::Timestamp), {});
+    if (dataEntries.isEmpty()) {
+        return;
+    }
 
-            QModelIndex endIndex =
-                index(endModelRow, static_cast<int>(Column::LogEntry), {});
+    int startModelRow = it->startModelRow();
+    int endModelRow = std::min(
+        it->endModelRow(), startModelRow + dataEntries.size() - 1);
 
-            Q_EMIT dataChanged(startIndex, endIndex);
-        }
+    m_logFileChunkDataCache.put(it->number(), dataEntries);
 
-        LVMDEBUG(
-            "Emitting model rows cached signal: start model "
-            << "row = " << startModelRow
-            << ", end model row = " << endModelRow);
+    LVMDEBUG(
+        "Put indexed log file data chunk to the LRUCache, chunk number = "
+        << it->number() << ", start row = " << startModelRow
+        << ", end row = " << endModelRow);
 
-        Q_EMIT notifyModelRowsCached(startModelRow, endModelRow);
-    }
+    Q_EMIT dataChanged(
+        index(startModelRow, static_cast<int>(Column::Timestamp), {}),
+        index(endModelRow, static_cast<int>(Column::LogEntry), {}));
 
-    if (dataEntries.size() < LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET) {
-        // It appears we've read to the end of the log file
-        LVMDEBUG("It appears the end of the log file was reached");
-        Q_EMIT notifyEndOfLogFileReached();
-        m_canReadMoreLogFileChunks = false;
-    }
-    else {
-        LVMDEBUG(
-            "Received precisely as many data entries as "
-            << "requested, probably more of them can be read");
-        m_canReadMoreLogFileChunks = true;
-    }
+    Q_EMIT notifyModelRowsCached(startModelRow, endModelRow);
 }
 
 void LogViewerModel::requestDataEntriesChunkFromLogFile(
@@ -1138,19 +1071,7 @@ void LogViewerModel::requestDataEntriesChunkFromLogFile(
         return;
     }
 
-    if (!m_pReadLogFileIOThread) {
-        m_pReadLogFileIOThread = new QThread;
-
-        QObject::connect(
-            m_pReadLogFileIOThread, &QThread::finished, this,
-            &QThread::deleteLater);
-
-        QObject::connect(
-            this, &LogViewerModel::destroyed, m_pReadLogFileIOThread,
-            &QThread::quit);
-
-        m_pReadLogFileIOThread->start(QThread::LowPriority);
-    }
+    startReadLogFileIOThread();
 
     if (!m_pFileReaderAsync) {
         m_pFileReaderAsync = new FileReaderAsync(
@@ -1190,6 +1111,216 @@ void LogViewerModel::requestDataEntriesChunkFromLogFile(
         << " log file data entries starting at pos " << startPos);
 }
 
+void LogViewerModel::startReadLogFileIOThread()
+{
+    if (m_pReadLogFileIOThread) {
+        return;
+    }
+
+    m_pReadLogFileIOThread = new QThread;
+
+    QObject::connect(
+        m_pReadLogFileIOThread, &QThread::finished, this,
+        &QThread::deleteLater);
+
+    QObject::connect(
+        this, &LogViewerModel::destroyed, m_pReadLogFileIOThread,
+        &QThread::quit);
+
+    m_pReadLogFileIOThread->start(QThread::LowPriority);
+}
+
+void LogViewerModel::startLogFileIndexing(const qint64 startPos)
+{
+    LVMDEBUG("LogViewerModel::startLogFileIndexing: start pos = " << startPos);
+
+    startReadLogFileIOThread();
+
+    m_indexedLogFileEndPos = startPos;
+    ++m_logFileIndexerGeneration;
+
+    m_pLogFileIndexer = new LogFileIndexer(
+        m_currentLogFileInfo.absoluteFilePath(), m_logFileIndexerGeneration,
+        startPos, m_filteringOptions.m_disabledLogLevels,
+        m_filteringOptions.m_logEntryContentFilter);
+
+    m_pLogFileIndexer->moveToThread(m_pReadLogFileIOThread);
+
+    QObject::connect(
+        m_pReadLogFileIOThread, &QThread::finished, m_pLogFileIndexer,
+        &LogFileIndexer::deleteLater);
+
+    QObject::connect(
+        this, &LogViewerModel::indexLogFile, m_pLogFileIndexer,
+        &LogFileIndexer::onIndexLogFile,
+        Qt::ConnectionType(Qt::UniqueConnection | Qt::QueuedConnection));
+
+    QObject::connect(
+        m_pLogFileIndexer, &LogFileIndexer::logFileIndexed, this,
+        &LogViewerModel::onLogFileIndexed,
+        Qt::ConnectionType(Qt::UniqueConnection | Qt::QueuedConnection));
+
+    requestLogFileIndexing();
+}
+
+void LogViewerModel::stopLogFileIndexing()
+{
+    if (!m_pLogFileIndexer) {
+        return;
+    }
+
+    LVMDEBUG("LogViewerModel::stopLogFileIndexing");
+
+    // NOTE: the indexer might be busy within its thread right now so it is
+    // only disconnected and marked for subsequent deletion
+    m_pLogFileIndexer->disconnect(this);
+    QObject::disconnect(this, nullptr, m_pLogFileIndexer, nullptr);
+    m_pLogFileIndexer->deleteLater();
+    m_pLogFileIndexer = nullptr;
+
+    m_logEntryStartPositions.clear();
+    m_logEntryLogLevels.clear();
+    m_indexedLogFileEndPos = 0;
+    m_logFileIndexingInProgress = false;
+    m_logFileChangedDuringIndexing = false;
+}
+
+void LogViewerModel::requestLogFileIndexing()
+{
+    if (!m_pLogFileIndexer) {
+        return;
+    }
+
+    if (m_logFileIndexingInProgress) {
+        LVMDEBUG(
+            "The log file is being indexed already, will index it again "
+            << "once the current indexing finishes");
+        m_logFileChangedDuringIndexing = true;
+        return;
+    }
+
+    m_logFileIndexingInProgress = true;
+    m_logFileChangedDuringIndexing = false;
+    Q_EMIT indexLogFile();
+}
+
+void LogViewerModel::onLogFileIndexed(
+    quint64 generation, qint64 fromPos, qint64 endPos,
+    QVector<qint64> entryStartPositions, QByteArray entryLogLevels,
+    bool endOfFile, ErrorString errorDescription)
+{
+    LVMDEBUG(
+        "LogViewerModel::onLogFileIndexed: generation = "
+        << generation << ", from pos = " << fromPos
+        << ", end pos = " << endPos << ", num indexed entries = "
+        << entryStartPositions.size()
+        << ", end of file = " << (endOfFile ? "true" : "false")
+        << ", error description = " << errorDescription);
+
+    if (generation != m_logFileIndexerGeneration) {
+        LVMDEBUG(
+            "Skipping the portion indexed by the indexer which was already "
+            << "replaced, current generation = "
+            << m_logFileIndexerGeneration);
+        return;
+    }
+
+    if (!errorDescription.isEmpty()) {
+        m_logFileIndexingInProgress = false;
+
+        ErrorString error(QT_TR_NOOP("Failed to index the log file: "));
+        error.appendBase(errorDescription.base());
+        error.appendBase(errorDescription.additionalBases());
+        error.details() = errorDescription.details();
+        Q_EMIT notifyError(error);
+        return;
+    }
+
+    if (Q_UNLIKELY(fromPos != m_indexedLogFileEndPos)) {
+        LVMDEBUG(
+            "Indexed log file portion doesn't continue the already indexed "
+            << "one which ends at pos " << m_indexedLogFileEndPos);
+        return;
+    }
+
+    m_indexedLogFileEndPos = endPos;
+
+    if (!entryStartPositions.isEmpty()) {
+        int startModelRow = m_logEntryStartPositions.size();
+        int endModelRow = startModelRow + entryStartPositions.size() - 1;
+
+        LVMDEBUG(
+            "Inserting new rows into the model: start row = "
+            << startModelRow << ", end row = " << endModelRow);
+
+        beginInsertRows(QModelIndex(), startModelRow, endModelRow);
+        m_logEntryStartPositions << entryStartPositions;
+        m_logEntryLogLevels.append(entryLogLevels);
+        updateIndexedLogFileChunksMetadata(startModelRow);
+        endInsertRows();
+
+        requestCachedLogFileChunkTail(startModelRow);
+    }
+    else if (!m_logEntryStartPositions.isEmpty()) {
+        // The end position of the last chunk might still have changed
+        updateIndexedLogFileChunksMetadata(m_logEntryStartPositions.size() - 1);
+    }
+
+    if (endOfFile) {
+        LVMDEBUG("The end of the log file was reached by the indexer");
+
+        m_logFileIndexingInProgress = false;
+        if (m_logFileChangedDuringIndexing) {
+            requestLogFileIndexing();
+        }
+
+        Q_EMIT notifyEndOfLogFileReached();
+    }
+}
+
+void LogViewerModel::updateIndexedLogFileChunksMetadata(const int fromRow)
+{
+    int rowCount = m_logEntryStartPositions.size();
+    if (rowCount == 0) {
+        return;
+    }
+
+    auto & indexByNumber =
+        m_logFileChunksMetadata.get<LogFileChunksMetadataByNumber>();
+
+    int firstChunkNumber =
+        fromRow / LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+
+    int lastChunkNumber =
+        (rowCount - 1) / LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+
+    for (int number = firstChunkNumber; number <= lastChunkNumber; ++number) {
+        int startModelRow =
+            number * LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+
+        int endModelRow = std::min(
+            startModelRow + LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET,
+            rowCount) - 1;
+
+        qint64 endLogFilePos =
+            ((endModelRow + 1) < rowCount
+                 ? m_logEntryStartPositions.at(endModelRow + 1)
+                 : m_indexedLogFileEndPos);
+
+        LogFileChunkMetadata metadata(
+            number, startModelRow, endModelRow,
+            m_logEntryStartPositions.at(startModelRow), endLogFilePos);
+
+        auto it = indexByNumber.find(number);
+        if (it == indexByNumber.end()) {
+            Q_UNUSED(indexByNumber.insert(metadata))
+        }
+        else {
+            Q_UNUSED(indexByNumber.replace(it, metadata))
+        }
+    }
+}
+
 void LogViewerModel::timerEvent(QTimerEvent * pEvent)
 {
     if (Q_UNLIKELY(!pEvent)) {
@@ -1202,14 +1333,28 @@ void LogViewerModel::timerEvent(QTimerEvent * pEvent)
             return;
         }
 
+#ifdef Q_OS_LINUX
+        // File system watcher is based on inotify here which reliably reports
+        // appends to the file, once its notification came there's no need
+        // to poll
+        if (m_currentLogFileWatcherNotified) {
+            LVMDEBUG(
+                "File system watcher's notification came, no longer polling "
+                << "the size of the log file");
+            m_currentLogFileSizePollingTimer.stop();
+            return;
+        }
+#endif
+
         // NOTE: it is necessary to create a new object of QFileInfo type
         // because the existing m_currentLogFileInfo has cached value of
         // current log file size, it doesn't update in live regime
         QFileInfo currentLogFileInfo(m_currentLogFileInfo.absoluteFilePath());
-        qint64 size = currentLogFileInfo.size();
-        if (size != m_currentLogFileSize) {
-            m_currentLogFileSize = size;
-            onFileChanged(m_currentLogFileInfo.absoluteFilePath());
+        if (currentLogFileInfo.size() != m_currentLogFileSize) {
+            LVMDEBUG(
+                "The size of the log file changed without file system "
+                << "watcher's notification");
+            processCurrentLogFileChange();
         }
 
         return;
@@ -1218,6 +1363,94 @@ void LogViewerModel::timerEvent(QTimerEvent * pEvent)
     QAbstractTableModel::timerEvent(pEvent);
 }
 
+void LogViewerModel::requestCachedLogFileChunkTail(const int row)
+{
+    int chunkNumber = row / LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+    int startModelRow =
+        chunkNumber * LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+    if (row == startModelRow) {
+        // The row starts a new chunk, it would be read on demand
+        return;
+    }
+
+    const auto * pLogFileDataChunk = m_logFileChunkDataCache.get(chunkNumber);
+    if (!pLogFileDataChunk ||
+        (pLogFileDataChunk->size() != (row - startModelRow)))
+    {
+        return;
+    }
+
+    LVMDEBUG(
+        "Requesting the tail of cached log file chunk " << chunkNumber
+        << " starting from row " << row);
+
+    requestDataEntriesChunkFromLogFile(
+        m_logEntryStartPositions.at(row),
+        LogFileDataEntryRequestReason::CachedChunkTail);
+}
+
+void LogViewerModel::appendToCachedLogFileChunk(
+    const qint64 fromPos, const QVector<Data> & dataEntries)
+{
+    auto positionIt = std::lower_bound(
+        m_logEntryStartPositions.constBegin(),
+        m_logEntryStartPositions.constEnd(), fromPos);
+
+    if ((positionIt == m_logEntryStartPositions.constEnd()) ||
+        (*positionIt != fromPos))
+    {
+        LVMDEBUG(
+            "No indexed log entry starts at pos " << fromPos
+            << ", ignoring the read data entries");
+        return;
+    }
+
+    int row = static_cast<int>(
+        std::distance(m_logEntryStartPositions.constBegin(), positionIt));
+
+    int chunkNumber = row / LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+    int startModelRow =
+        chunkNumber * LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET;
+
+    const auto * pLogFileDataChunk = m_logFileChunkDataCache.get(chunkNumber);
+    if (!pLogFileDataChunk ||
+        (pLogFileDataChunk->size() != (row - startModelRow)))
+    {
+        LVMDEBUG(
+            "Log file chunk " << chunkNumber << " is no longer cached "
+            << "up to row " << row << ", ignoring the read data entries");
+        return;
+    }
+
+    // The entries which are not indexed yet or belong to the next chunk
+    // are not appended
+    int endModelRow = std::min(
+        startModelRow + LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET,
+        m_logEntryStartPositions.size()) - 1;
+
+    int numDataEntries = std::min(dataEntries.size(), endModelRow - row + 1);
+    if (numDataEntries <= 0) {
+        return;
+    }
+
+    QVector<Data> logFileDataChunk = *pLogFileDataChunk;
+    logFileDataChunk << dataEntries.mid(0, numDataEntries);
+    m_logFileChunkDataCache.put(chunkNumber, logFileDataChunk);
+
+    endModelRow = row + numDataEntries - 1;
+
+    LVMDEBUG(
+        "Appended " << numDataEntries << " data entries to the cached log "
+        << "file chunk " << chunkNumber << ", start row = " << row
+        << ", end row = " << endModelRow);
+
+    Q_EMIT dataChanged(
+        index(row, static_cast<int>(Column::Timestamp), {}),
+        index(endModelRow, static_cast<int>(Column::LogEntry), {}));
+
+    Q_EMIT notifyModelRowsCached(row, endModelRow);
+}
+
 QString LogViewerModel::logLevelToString(LogLevel logLevel)
 {
     switch (logLevel) {
@@ -30,6 +30,7 @@
 
 #include <QAbstractTableModel>
 #include <QBasicTimer>
+#include <QByteArray>
 #include <QFile>
 #include <QFileInfo>
 #include <QFlags>
@@ -168,6 +169,7 @@ Q_SIGNALS:
     // private signals
     void startAsyncLogFileReading();
     void readLogFileDataEntries(qint64 fromPos, int maxDataEntries);
+    void indexLogFile();
     void deleteFileReaderAsync();
     void wipeCurrentLogFileFinished();
 
@@ -184,9 +186,6 @@ public:
         int section, Qt::Orientation orientation,
         int role = Qt::DisplayRole) const override;
 
-    virtual bool canFetchMore(const QModelIndex & parent) const override;
-    virtual void fetchMore(const QModelIndex & parent) override;
-
 private Q_SLOTS:
     void onFileChanged(const QString & path);
     void onFileRemoved(const QString & path);
@@ -196,15 +195,19 @@ private Q_SLOTS:
         QVector<LogViewerModel::Data> dataEntries,
         ErrorString errorDescription);
 
+    void onLogFileIndexed(
+        quint64 generation, qint64 fromPos, qint64 endPos,
+        QVector<qint64> entryStartPositions, QByteArray entryLogLevels,
+        bool endOfFile, ErrorString errorDescription);
+
 private:
     struct LogFileDataEntryRequestReason
     {
         enum type
         {
-            InitialRead = 1 << 1,
-            CacheMiss = 1 << 2,
-            FetchMore = 1 << 3,
-            SaveLogEntriesToFile = 1 << 4
+            CacheMiss = 1 << 1,
+            SaveLogEntriesToFile = 1 << 2,
+            CachedChunkTail = 1 << 3
         };
     };
 
@@ -215,13 +218,53 @@ private:
         const qint64 startPos,
         const LogFileDataEntryRequestReason::type reason);
 
-private:
-    virtual void timerEvent(QTimerEvent * pEvent) override;
+    void startReadLogFileIOThread();
+
+    /**
+     * @brief startLogFileIndexing - starts finding log entries within the log
+     * file in background starting from the given position; model rows are
+     * inserted as the entries are found
+     */
+    void startLogFileIndexing(const qint64 startPos);
+    void stopLogFileIndexing();
+
+    /**
+     * @brief requestLogFileIndexing - asks the log file indexer to index
+     * the log entries appended to the log file since the last indexing; if
+     * the indexer is busy, the request is postponed until it finishes so that
+     * bursts of log file change notifications result in a single indexing
+     */
+    void requestLogFileIndexing();
+
+    /**
+     * @brief processCurrentLogFileChange - finds out whether the current log
+     * file was appended to or replaced and either indexes the appended
+     * log entries or resets the model
+     */
+    void processCurrentLogFileChange();
+
+    void updateIndexedLogFileChunksMetadata(const int fromRow);
+
+    /**
+     * @brief requestCachedLogFileChunkTail - if log entries preceding the given
+     * row within its chunk are cached, requests reading only the log entries
+     * starting from this row instead of the whole chunk
+     */
+    void requestCachedLogFileChunkTail(const int row);
+
+    void appendToCachedLogFileChunk(
+        const qint64 fromPos, const QVector<Data> & dataEntries);
 
 private:
     class FileReaderAsync;
+    class LogFileIndexer;
     class LogFileParser;
 
+    friend class LogViewerModelTestHelper;
+
+private:
+    virtual void timerEvent(QTimerEvent * pEvent) override;
+
 private:
     Q_DISABLE_COPY(LogViewerModel)
 
@@ -356,16 +399,34 @@ private:
     LogFileChunksMetadata m_logFileChunksMetadata;
     LRUCache<qint32, QVector<Data>> m_logFileChunkDataCache;
 
-    bool m_canReadMoreLogFileChunks = false;
-
     QHash<qint64, LogFileDataEntryRequestReasons> m_logFilePosRequestedToBeRead;
 
     qint64 m_currentLogFileSize = 0;
+
+    // File system watcher doesn't reliably report appends to the file on all
+    // platforms so the size of the current log file is also polled, although
+    // rarely
     QBasicTimer m_currentLogFileSizePollingTimer;
+    bool m_currentLogFileWatcherNotified = false;
 
     QThread * m_pReadLogFileIOThread = nullptr;
     FileReaderAsync * m_pFileReaderAsync = nullptr;
 
+    // Model rows correspond to log entries found by the log file indexer:
+    // their start positions within the log file and log levels are stored
+    // here
+    LogFileIndexer * m_pLogFileIndexer = nullptr;
+
+    // Incremented for each new indexer so that the results of the replaced
+    // indexer already queued for delivery are ignored
+    quint64 m_logFileIndexerGeneration = 0;
+
+    QVector<qint64> m_logEntryStartPositions;
+    QByteArray m_logEntryLogLevels;
+    qint64 m_indexedLogFileEndPos = 0;
+    bool m_logFileIndexingInProgress = false;
+    bool m_logFileChangedDuringIndexing = false;
+
     QFile m_targetSaveFile;
 
     bool m_internalLogEnabled = false;
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogViewerModelLogFileIndexer.h"
+
+#include <quentier/utility/Compat.h>
+
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QRunnable>
+
+#include <algorithm>
+#include <cstring>
+
+// Size of the log file window memory mapped and indexed at once
+#define LOG_VIEWER_MODEL_LOG_FILE_INDEXER_WINDOW_SIZE (16 * 1024 * 1024)
+
+// Minimal size of the range indexed by a separate thread
+#define LOG_VIEWER_MODEL_LOG_FILE_INDEXER_MIN_RANGE_SIZE (256 * 1024)
+
+namespace quentier {
+
+class LogViewerModel::LogFileIndexer::RangeIndexingTask final :
+    public QRunnable
+{
+public:
+    RangeIndexingTask(
+        const LogFileIndexer & indexer, Range & range,
+        LogViewerModel::LogFileParser & parser) :
+        QRunnable(),
+        m_indexer(indexer), m_range(range), m_parser(parser)
+    {}
+
+    virtual void run() override
+    {
+        m_indexer.indexRange(m_range, m_parser);
+    }
+
+private:
+    const LogFileIndexer & m_indexer;
+    Range & m_range;
+    LogViewerModel::LogFileParser & m_parser;
+};
+
+LogViewerModel::LogFileIndexer::LogFileIndexer(
+    const QString & targetFilePath, const quint64 generation,
+    const qint64 startPos, const QVector<LogLevel> & disabledLogLevels,
+    const QString & logEntryContentFilter, QObject * parent) :
+    QObject(parent),
+    m_targetFile(targetFilePath), m_generation(generation),
+    m_disabledLogLevels(disabledLogLevels),
+    m_filterRegExp(logEntryContentFilter, Qt::CaseSensitive, QRegExp::Wildcard),
+    m_indexedEndPos(startPos),
+    m_windowSize(LOG_VIEWER_MODEL_LOG_FILE_INDEXER_WINDOW_SIZE)
+{}
+
+LogViewerModel::LogFileIndexer::~LogFileIndexer()
+{
+    if (m_targetFile.isOpen()) {
+        m_targetFile.close();
+    }
+}
+
+void LogViewerModel::LogFileIndexer::setMaxThreadCount(
+    const int maxThreadCount)
+{
+    m_threadPool.setMaxThreadCount(maxThreadCount);
+}
+
+void LogViewerModel::LogFileIndexer::onIndexLogFile()
+{
+    qint64 fromPos = m_indexedEndPos;
+
+    if (!m_targetFile.isOpen() && !m_targetFile.open(QIODevice::ReadOnly)) {
+        ErrorString errorDescription(
+            QT_TR_NOOP("Can't open log file for reading"));
+
+        errorDescription.details() =
+            QFileInfo(m_targetFile).absoluteFilePath();
+
+        Q_EMIT logFileIndexed(
+            m_generation, fromPos, fromPos, QVector<qint64>(), QByteArray(),
+            true, errorDescription);
+
+        return;
+    }
+
+    qint64 fileSize = m_targetFile.size();
+    if (fileSize <= m_indexedEndPos) {
+        Q_EMIT logFileIndexed(
+            m_generation, fromPos, fromPos, QVector<qint64>(), QByteArray(),
+            true, ErrorString());
+
+        return;
+    }
+
+    qint64 mapSize = std::min(fileSize - m_indexedEndPos, m_windowSize);
+    uchar * pMappedData = m_targetFile.map(m_indexedEndPos, mapSize);
+    if (Q_UNLIKELY(!pMappedData)) {
+        ErrorString errorDescription(
+            QT_TR_NOOP("Failed to memory map the log file"));
+
+        errorDescription.details() = m_targetFile.errorString();
+
+        Q_EMIT logFileIndexed(
+            m_generation, fromPos, fromPos, QVector<qint64>(), QByteArray(),
+            true, errorDescription);
+
+        return;
+    }
+
+    const char * data = reinterpret_cast<const char *>(pMappedData);
+    bool endOfFile = ((m_indexedEndPos + mapSize) == fileSize);
+
+    // The last line within the window is only indexed when it is complete:
+    // either it continues in the next window or it is still being written
+    const char * indexedEnd = data + mapSize;
+    while ((indexedEnd != data) && (*(indexedEnd - 1) != '\n')) {
+        --indexedEnd;
+    }
+
+    // Whether a log entry passes the content filter depends on all its lines
+    // so the entry must not be split between windows
+    if (!endOfFile && !m_filterRegExp.isEmpty()) {
+        indexedEnd = lastLogEntryStart(data, indexedEnd);
+    }
+
+    std::vector<Range> ranges =
+        splitIntoRanges(data, indexedEnd, m_indexedEndPos);
+
+    while (m_rangeParsers.size() < ranges.size()) {
+        m_rangeParsers.emplace_back(new LogViewerModel::LogFileParser);
+    }
+
+    if (ranges.size() == 1) {
+        indexRange(ranges[0], *m_rangeParsers[0]);
+    }
+    else {
+        for (size_t i = 0, size = ranges.size(); i < size; ++i) {
+            m_threadPool.start(
+                new RangeIndexingTask(*this, ranges[i], *m_rangeParsers[i]));
+        }
+
+        m_threadPool.waitForDone();
+    }
+
+    Q_UNUSED(m_targetFile.unmap(pMappedData))
+
+    QVector<qint64> entryStartPositions;
+    QByteArray entryLogLevels;
+
+    for (const auto & range: ranges) {
+        entryStartPositions << range.m_entryStartPositions;
+        entryLogLevels.append(range.m_entryLogLevels);
+    }
+
+    qint64 indexedSize = indexedEnd - data;
+    if ((indexedSize == 0) && !endOfFile) {
+        // The line or the log entry doesn't fit into the window, need a bigger
+        // one
+        m_windowSize *= 2;
+    }
+
+    m_indexedEndPos += indexedSize;
+
+    Q_EMIT logFileIndexed(
+        m_generation, fromPos, m_indexedEndPos, entryStartPositions,
+        entryLogLevels, endOfFile, ErrorString());
+
+    if (!endOfFile) {
+        QMetaObject::invokeMethod(this, "onIndexLogFile", Qt::QueuedConnection);
+    }
+}
+
+void LogViewerModel::LogFileIndexer::indexRange(
+    Range & range, LogViewerModel::LogFileParser & parser) const
+{
+    if (!range.m_filterRegExp.isEmpty()) {
+        QVector<LogViewerModel::Data> dataEntries;
+
+        parser.parseDataEntriesFromData(
+            range.m_begin, range.m_end, range.m_startPos, m_disabledLogLevels,
+            range.m_filterRegExp, dataEntries, range.m_entryStartPositions);
+
+        range.m_entryLogLevels.reserve(dataEntries.size());
+        for (const auto & dataEntry: qAsConst(dataEntries)) {
+            range.m_entryLogLevels.append(
+                static_cast<char>(dataEntry.m_logLevel));
+        }
+
+        return;
+    }
+
+    const char * lineBegin = range.m_begin;
+    while (lineBegin != range.m_end) {
+        const char * lineBreak = static_cast<const char *>(std::memchr(
+            lineBegin, '\n', static_cast<size_t>(range.m_end - lineBegin)));
+
+        const char * lineEnd = (lineBreak ? lineBreak : range.m_end);
+        const char * nextLineBegin =
+            (lineBreak ? (lineBreak + 1) : range.m_end);
+
+        if ((lineEnd != lineBegin) && (*(lineEnd - 1) == '\r')) {
+            --lineEnd;
+        }
+
+        LogLevel logLevel = LogLevel::Info;
+        if (parser.parseLogEntryStart(lineBegin, lineEnd, logLevel) &&
+            !m_disabledLogLevels.contains(logLevel))
+        {
+            range.m_entryStartPositions.push_back(
+                range.m_startPos + (lineBegin - range.m_begin));
+
+            range.m_entryLogLevels.append(static_cast<char>(logLevel));
+        }
+
+        lineBegin = nextLineBegin;
+    }
+}
+
+std::vector<LogViewerModel::LogFileIndexer::Range>
+LogViewerModel::LogFileIndexer::splitIntoRanges(
+    const char * begin, const char * end, const qint64 startPos) const
+{
+    qint64 size = end - begin;
+
+    qint64 numRanges = std::min(
+        static_cast<qint64>(std::max(m_threadPool.maxThreadCount(), 1)),
+        size / LOG_VIEWER_MODEL_LOG_FILE_INDEXER_MIN_RANGE_SIZE);
+
+    numRanges = std::max(numRanges, qint64(1));
+
+    std::vector<Range> ranges;
+    ranges.reserve(static_cast<size_t>(numRanges));
+
+    const char * rangeBegin = begin;
+    for (qint64 i = 1; i <= numRanges; ++i) {
+        const char * rangeEnd = end;
+        if (i != numRanges) {
+            const char * splitPos = begin + size * i / numRanges;
+            if (splitPos <= rangeBegin) {
+                continue;
+            }
+
+            rangeEnd = nextLogEntryStart(splitPos, end);
+        }
+
+        Range range;
+        range.m_begin = rangeBegin;
+        range.m_end = rangeEnd;
+        range.m_startPos = startPos + (rangeBegin - begin);
+        range.m_filterRegExp = m_filterRegExp;
+        ranges.push_back(range);
+
+        rangeBegin = rangeEnd;
+        if (rangeBegin == end) {
+            break;
+        }
+    }
+
+    return ranges;
+}
+
+const char * LogViewerModel::LogFileIndexer::nextLogEntryStart(
+    const char * pos, const char * end) const
+{
+    while (pos != end) {
+        // Moving to the beginning of the next line
+        const char * lineBreak = static_cast<const char *>(
+            std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+
+        if (!lineBreak) {
+            return end;
+        }
+
+        const char * lineBegin = lineBreak + 1;
+        if (lineBegin == end) {
+            return end;
+        }
+
+        lineBreak = static_cast<const char *>(
+            std::memchr(lineBegin, '\n', static_cast<size_t>(end - lineBegin)));
+
+        if (isLogEntryStart(lineBegin, (lineBreak ? lineBreak : end))) {
+            return lineBegin;
+        }
+
+        pos = lineBegin;
+    }
+
+    return end;
+}
+
+const char * LogViewerModel::LogFileIndexer::lastLogEntryStart(
+    const char * begin, const char * end) const
+{
+    // The data ends with the line break, looking for line starts backwards;
+    // the first line is not considered because its start is the data's one
+    const char * lineEnd = end;
+    while (lineEnd != begin) {
+        const char * lineBegin = lineEnd - 1;
+        while ((lineBegin != begin) && (*(lineBegin - 1) != '\n')) {
+            --lineBegin;
+        }
+
+        if (lineBegin == begin) {
+            break;
+        }
+
+        if (isLogEntryStart(lineBegin, lineEnd - 1)) {
+            return lineBegin;
+        }
+
+        lineEnd = lineBegin;
+    }
+
+    return begin;
+}
+
+bool LogViewerModel::LogFileIndexer::isLogEntryStart(
+    const char * lineBegin, const char * lineEnd) const
+{
+    if ((lineEnd != lineBegin) && (*(lineEnd - 1) == '\r')) {
+        --lineEnd;
+    }
+
+    LogLevel logLevel = LogLevel::Info;
+    return m_parser.parseLogEntryStart(lineBegin, lineEnd, logLevel);
+}
+
+} // namespace quentier
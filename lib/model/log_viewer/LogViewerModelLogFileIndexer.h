@@ -0,0 +1,154 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_LOG_VIEWER_MODEL_LOG_FILE_INDEXER_H
+#define QUENTIER_LIB_MODEL_LOG_VIEWER_MODEL_LOG_FILE_INDEXER_H
+
+#include "LogViewerModel.h"
+#include "LogViewerModelLogFileParser.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QRegExp>
+#include <QThreadPool>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+namespace quentier {
+
+/**
+ * @brief The LogViewerModel::LogFileIndexer class finds the start positions
+ * and log levels of log entries within the log file
+ *
+ * The log file is memory mapped and scanned window by window. After each
+ * window the found entries are reported and the scanning of the next window
+ * is scheduled through the event loop so that requests to read log entries
+ * processed within the same thread are not delayed until the whole file is
+ * indexed. When the end of the file is reached, the indexer waits for the next
+ * request to index the log file, then it continues from where it stopped.
+ *
+ * Each window is split into ranges at log entry boundaries which are indexed
+ * in parallel. Without content filter only the lines starting log entries
+ * are recognized; with content filter the entries need to be parsed
+ * completely to find out whether they pass the filter.
+ */
+class LogViewerModel::LogFileIndexer final : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LogFileIndexer(
+        const QString & targetFilePath, const quint64 generation,
+        const qint64 startPos, const QVector<LogLevel> & disabledLogLevels,
+        const QString & logEntryContentFilter, QObject * parent = nullptr);
+
+    virtual ~LogFileIndexer() override;
+
+    /**
+     * @brief setMaxThreadCount - sets the maximal number of threads indexing
+     * ranges of the log file window in parallel, by default it's the ideal
+     * thread count
+     */
+    void setMaxThreadCount(const int maxThreadCount);
+
+Q_SIGNALS:
+    /**
+     * @brief logFileIndexed - emitted after the next portion of the log file
+     * was indexed
+     *
+     * @param generation            The generation of the indexer passed to
+     *                              its constructor; portions queued for
+     *                              delivery by the indexer which was already
+     *                              replaced are told apart by it
+     * @param fromPos               The log file position from which
+     *                              the portion starts
+     * @param endPos                The log file position up to which the log
+     *                              file was indexed
+     * @param entryStartPositions   Start positions of log entries within
+     *                              the portion, entries with disabled log
+     *                              levels or not passing the content filter
+     *                              are not included
+     * @param entryLogLevels        Log levels of log entries within
+     *                              the portion, one byte per entry
+     * @param endOfFile             True if the end of the log file was
+     *                              reached, false otherwise
+     * @param errorDescription      Non-empty if the log file could not be
+     *                              indexed
+     */
+    void logFileIndexed(
+        quint64 generation, qint64 fromPos, qint64 endPos,
+        QVector<qint64> entryStartPositions, QByteArray entryLogLevels,
+        bool endOfFile, ErrorString errorDescription);
+
+public Q_SLOTS:
+    void onIndexLogFile();
+
+private:
+    struct Range
+    {
+        const char * m_begin = nullptr;
+        const char * m_end = nullptr;
+        qint64 m_startPos = 0;
+
+        // Own copy of the filter for each range because QRegExp keeps
+        // the state of the last match
+        QRegExp m_filterRegExp;
+
+        QVector<qint64> m_entryStartPositions;
+        QByteArray m_entryLogLevels;
+    };
+
+    class RangeIndexingTask;
+
+    void indexRange(
+        Range & range, LogViewerModel::LogFileParser & parser) const;
+
+    /**
+     * @brief splitIntoRanges - splits the data into ranges of approximately
+     * equal sizes, ranges start with lines starting log entries
+     */
+    std::vector<Range> splitIntoRanges(
+        const char * begin, const char * end, const qint64 startPos) const;
+
+    const char * nextLogEntryStart(const char * pos, const char * end) const;
+    const char * lastLogEntryStart(const char * begin, const char * end) const;
+
+    bool isLogEntryStart(const char * lineBegin, const char * lineEnd) const;
+
+private:
+    Q_DISABLE_COPY(LogFileIndexer)
+
+private:
+    QFile m_targetFile;
+    quint64 m_generation;
+    QVector<LogLevel> m_disabledLogLevels;
+    QRegExp m_filterRegExp;
+    LogViewerModel::LogFileParser m_parser;
+
+    // Parsers of ranges indexed in parallel, one per range
+    std::vector<std::unique_ptr<LogViewerModel::LogFileParser>> m_rangeParsers;
+    QThreadPool m_threadPool;
+
+    qint64 m_indexedEndPos;
+    qint64 m_windowSize;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_LOG_VIEWER_MODEL_LOG_FILE_INDEXER_H
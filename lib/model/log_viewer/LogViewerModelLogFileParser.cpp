@@ -21,14 +21,17 @@
 #include <lib/preferences/keys/Logging.h>
 
 #include <quentier/utility/ApplicationSettings.h>
+#include <quentier/utility/Compat.h>
 #include <quentier/utility/DateTime.h>
 #include <quentier/utility/StandardPaths.h>
 
 #include <QCoreApplication>
 #include <QDebug>
-#include <QTextStream>
 #include <QTimeZone>
 
+#include <cstring>
+#include <limits>
+
 #define LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE (700)
 
 #define LVMPDEBUG(message)                                                     \
@@ -68,23 +71,121 @@
 
 namespace quentier {
 
-#define REGEX_QNLOG_DATE                                                       \
-    "^(\\d{4}-\\d{2}-\\d{2}\\s+\\d{2}:\\d{2}:\\d{2}.\\d{1,17})(?:\\s+(\\w+))?"
+// Size of blocks in which the log file is read into the read buffer
+#define LOG_VIEWER_MODEL_LOG_FILE_READ_BLOCK_SIZE (1024 * 1024)
 
-// note: QNLOG_FILE_LINENUMBER_DELIMITER is here incorporated into regex
-#define REGEX_QNLOG_SOURCE_LINENUMBER "([a-zA-Z0-9\\\\\\/_.]+):(\\d+)"
+// Timestamp format written by the logger: "yyyy-MM-dd HH:mm:ss.zzz"
+#define LOG_VIEWER_MODEL_TIMESTAMP_SIZE (23)
 
-// full logline regex
-#define REGEX_QNLOG_LINE                                                       \
-    REGEX_QNLOG_DATE                                                           \
-    "\\s+" REGEX_QNLOG_SOURCE_LINENUMBER                                       \
-    "\\s+"                                                                     \
-    "\\[(\\w+)\\]"                                                             \
-    "(?:\\s+\\[((?:\\w+|:|-|_)+)\\])?:\\s+(.+$)"
+// Lines starting new log entries have the following format, with timezone
+// and component being optional:
+// yyyy-MM-dd HH:mm:ss.zzz <timezone> <source file>:<line> [<level>]
+// [<component>]: <message>
+// Any other lines are continuations of multiline log entries
+
+static inline bool isAsciiDigit(const char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static inline bool isWhitespace(const char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') ||
+        (c == '\v') || (c == '\f');
+}
+
+// Non-ASCII bytes are considered parts of words because they are parts of
+// UTF-8 encoded non-ASCII characters, most of them are letters
+static inline bool isWordChar(const char c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+        isAsciiDigit(c) || (c == '_') ||
+        (static_cast<unsigned char>(c) >= 0x80);
+}
+
+static inline bool isSourceFileNameChar(const char c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+        isAsciiDigit(c) || (c == '_') || (c == '.') || (c == '/') ||
+        (c == '\\');
+}
+
+static inline bool isComponentChar(const char c)
+{
+    return isWordChar(c) || (c == ':') || (c == '-');
+}
+
+template <class Predicate>
+static inline const char * skipChars(
+    const char * begin, const char * end, Predicate predicate)
+{
+    while ((begin != end) && predicate(*begin)) {
+        ++begin;
+    }
+
+    return begin;
+}
+
+static inline bool hasDigits(const char * begin, const int numDigits)
+{
+    for (int i = 0; i < numDigits; ++i) {
+        if (!isAsciiDigit(begin[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static inline int parseDigits(const char * begin, const int numDigits)
+{
+    int result = 0;
+    for (int i = 0; i < numDigits; ++i) {
+        result = result * 10 + (begin[i] - '0');
+    }
+
+    return result;
+}
+
+static bool parseLogLevel(
+    const char * begin, const int size, LogLevel & logLevel)
+{
+    switch (size) {
+    case 4:
+        if (std::memcmp(begin, "Info", 4) == 0) {
+            logLevel = LogLevel::Info;
+            return true;
+        }
+
+        if (std::memcmp(begin, "Warn", 4) == 0) {
+            logLevel = LogLevel::Warning;
+            return true;
+        }
+
+        return false;
+    case 5:
+        if (std::memcmp(begin, "Trace", 5) == 0) {
+            logLevel = LogLevel::Trace;
+            return true;
+        }
+
+        if (std::memcmp(begin, "Debug", 5) == 0) {
+            logLevel = LogLevel::Debug;
+            return true;
+        }
+
+        if (std::memcmp(begin, "Error", 5) == 0) {
+            logLevel = LogLevel::Error;
+            return true;
+        }
+
+        return false;
+    default:
+        return false;
+    }
+}
 
 LogViewerModel::LogFileParser::LogFileParser() :
-    m_logParsingRegex(
-        QStringLiteral(REGEX_QNLOG_LINE), Qt::CaseInsensitive, QRegExp::RegExp),
     m_internalLogFile(
         applicationPersistentStoragePath() +
         QStringLiteral("/logs-quentier/LogViewerModelLogFileParserLog.txt")),
@@ -126,9 +227,7 @@ bool LogViewerModel::LogFileParser::parseDataEntriesFromLogFile(
         return false;
     }
 
-    QTextStream strm(&logFile);
-
-    if (!strm.seek(fromPos)) {
+    if (!logFile.seek(fromPos)) {
         errorDescription.setBase(
             QT_TR_NOOP("Failed to read the data from log "
                        "file: failed to seek at position"));
@@ -138,169 +237,597 @@ bool LogViewerModel::LogFileParser::parseDataEntriesFromLogFile(
         return false;
     }
 
-    QString line;
-    int numFoundMatches = 0;
+    setupContentFilter(filterContentRegExp);
+
+    if (m_readBuffer.size() < LOG_VIEWER_MODEL_LOG_FILE_READ_BLOCK_SIZE) {
+        m_readBuffer.resize(LOG_VIEWER_MODEL_LOG_FILE_READ_BLOCK_SIZE);
+    }
+
+    m_readBufferDataSize = 0;
+    m_readBufferLineStart = 0;
+    m_readBufferStartPos = fromPos;
+    m_readBufferAtEnd = false;
+
+    const char * lineBegin = nullptr;
+    const char * lineEnd = nullptr;
     dataEntries.clear();
     dataEntries.reserve(maxDataEntries);
     ParseLineStatus previousParseLineStatus = ParseLineStatus::FilteredEntry;
-    bool insideEntry = false;
-    while (!strm.atEnd()) {
-        line = strm.readLine();
-        LVMPDEBUG("Processing line " << line);
-
-        auto parseLineStatus = parseLogFileLine(
-            line, previousParseLineStatus, disabledLogLevels,
-            filterContentRegExp, dataEntries, errorDescription);
+    while (true) {
+        auto readLineStatus =
+            readLogFileLine(logFile, lineBegin, lineEnd, errorDescription);
 
-        if (parseLineStatus == ParseLineStatus::Error) {
+        if (readLineStatus == ReadLineStatus::Error) {
             LVMPDEBUG("Returning error: " << errorDescription);
             return false;
         }
 
-        previousParseLineStatus = parseLineStatus;
+        if (readLineStatus == ReadLineStatus::EndOfFile) {
+            break;
+        }
 
-        if (parseLineStatus == ParseLineStatus::FilteredEntry) {
-            if (insideEntry && (numFoundMatches > 0)) {
-                --numFoundMatches;
-                insideEntry = false;
-            }
+        LVMPDEBUG(
+            "Processing line "
+            << QString::fromUtf8(
+                   lineBegin, static_cast<int>(lineEnd - lineBegin)));
 
-            continue;
-        }
-        else if (parseLineStatus == ParseLineStatus::AppendedToLastEntry) {
-            LVMPDEBUG("No new entry created, continuing");
-            continue;
-        }
-        else if (parseLineStatus == ParseLineStatus::CreatedNewEntry) {
-            insideEntry = true;
-            ++numFoundMatches;
+        qint64 linePos =
+            m_readBufferStartPos + (lineBegin - m_readBuffer.constData());
+
+        auto processLineStatus = processLogFileLine(
+            lineBegin, lineEnd, linePos, maxDataEntries, disabledLogLevels,
+            filterContentRegExp, previousParseLineStatus, dataEntries, nullptr);
+
+        if (processLineStatus == ProcessLineStatus::Stop) {
             LVMPDEBUG(
-                "New entry was created, " << numFoundMatches
-                                          << " entries found now");
-
-            if (numFoundMatches >= maxDataEntries) {
-                LVMPDEBUG(
-                    "Exceeded the allowed number of entries "
-                    "to parse, returning");
-                break;
-            }
+                "Exceeded the allowed number of entries to parse, returning");
+            endPos = linePos;
+            LVMPDEBUG("End pos before returning = " << endPos);
+            return true;
         }
     }
 
-    endPos = strm.pos();
+    endPos = m_readBufferStartPos + m_readBufferLineStart;
     LVMPDEBUG("End pos before returning = " << endPos);
     return true;
 }
 
+void LogViewerModel::LogFileParser::parseDataEntriesFromData(
+    const char * begin, const char * end, const qint64 startPos,
+    const QVector<LogLevel> & disabledLogLevels,
+    const QRegExp & filterContentRegExp,
+    QVector<LogViewerModel::Data> & dataEntries,
+    QVector<qint64> & entryStartPositions)
+{
+    LVMPDEBUG(
+        "LogViewerModel::LogFileParser::parseDataEntriesFromData: "
+        << "start pos = " << startPos << ", size = " << (end - begin));
+
+    dataEntries.clear();
+    entryStartPositions.clear();
+
+    setupContentFilter(filterContentRegExp);
+
+    ParseLineStatus previousParseLineStatus = ParseLineStatus::FilteredEntry;
+    const char * lineBegin = begin;
+    while (lineBegin != end) {
+        const char * lineBreak = static_cast<const char *>(
+            std::memchr(lineBegin, '\n', static_cast<size_t>(end - lineBegin)));
+
+        const char * lineEnd = (lineBreak ? lineBreak : end);
+        const char * nextLineBegin = (lineBreak ? (lineBreak + 1) : end);
+
+        if ((lineEnd != lineBegin) && (*(lineEnd - 1) == '\r')) {
+            --lineEnd;
+        }
+
+        Q_UNUSED(processLogFileLine(
+            lineBegin, lineEnd, startPos + (lineBegin - begin), -1,
+            disabledLogLevels, filterContentRegExp, previousParseLineStatus,
+            dataEntries, &entryStartPositions))
+
+        lineBegin = nextLineBegin;
+    }
+}
+
+LogViewerModel::LogFileParser::ProcessLineStatus
+LogViewerModel::LogFileParser::processLogFileLine(
+    const char * lineBegin, const char * lineEnd, const qint64 linePos,
+    const int maxDataEntries, const QVector<LogLevel> & disabledLogLevels,
+    const QRegExp & filterContentRegExp,
+    ParseLineStatus & previousParseLineStatus,
+    QVector<LogViewerModel::Data> & dataEntries,
+    QVector<qint64> * pEntryStartPositions)
+{
+    auto parseLineStatus = parseLogFileLine(
+        lineBegin, lineEnd, previousParseLineStatus, disabledLogLevels,
+        filterContentRegExp, dataEntries);
+
+    previousParseLineStatus = parseLineStatus;
+
+    if (parseLineStatus == ParseLineStatus::CreatedNewEntry) {
+        if ((maxDataEntries >= 0) && (dataEntries.size() > maxDataEntries)) {
+            // The entry should be parsed along with the next portion of
+            // entries; its start is where the parsing continues from then
+            dataEntries.pop_back();
+            return ProcessLineStatus::Stop;
+        }
+
+        LVMPDEBUG(
+            "New entry was created, " << dataEntries.size()
+                                      << " entries found now");
+
+        if (pEntryStartPositions) {
+            pEntryStartPositions->push_back(linePos);
+        }
+    }
+    else if (
+        pEntryStartPositions &&
+        (pEntryStartPositions->size() > dataEntries.size()))
+    {
+        // The last entry was filtered out after a line was appended to it
+        pEntryStartPositions->resize(dataEntries.size());
+    }
+
+    return ProcessLineStatus::Continue;
+}
+
+bool LogViewerModel::LogFileParser::parseLogEntryStart(
+    const char * lineBegin, const char * lineEnd, LogLevel & logLevel) const
+{
+    LogLineTokens tokens;
+    int sourceFileLineNumber = 0;
+    return parseLogEntryStart(
+        lineBegin, lineEnd, tokens, logLevel, sourceFileLineNumber);
+}
+
+bool LogViewerModel::LogFileParser::parseLogEntryStart(
+    const char * lineBegin, const char * lineEnd, LogLineTokens & tokens,
+    LogLevel & logLevel, int & sourceFileLineNumber) const
+{
+    if (!tokenizeLogFileLine(lineBegin, lineEnd, tokens)) {
+        return false;
+    }
+
+    if (!parseLogLevel(
+            tokens.m_logLevel.m_begin, tokens.m_logLevel.m_size, logLevel))
+    {
+        return false;
+    }
+
+    qint64 lineNumber = 0;
+    for (int i = 0; i < tokens.m_sourceFileLineNumber.m_size; ++i) {
+        lineNumber = lineNumber * 10 +
+            (tokens.m_sourceFileLineNumber.m_begin[i] - '0');
+
+        if (lineNumber > std::numeric_limits<int>::max()) {
+            return false;
+        }
+    }
+
+    sourceFileLineNumber = static_cast<int>(lineNumber);
+    return true;
+}
+
+LogViewerModel::LogFileParser::ReadLineStatus
+LogViewerModel::LogFileParser::readLogFileLine(
+    QFile & logFile, const char *& lineBegin, const char *& lineEnd,
+    ErrorString & errorDescription)
+{
+    while (true) {
+        const char * data = m_readBuffer.constData();
+        const char * begin = data + m_readBufferLineStart;
+        const char * end = data + m_readBufferDataSize;
+
+        const char * lineBreak = static_cast<const char *>(
+            std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+
+        if (lineBreak || (m_readBufferAtEnd && (begin != end))) {
+            lineBegin = begin;
+            lineEnd = (lineBreak ? lineBreak : end);
+
+            m_readBufferLineStart = static_cast<int>(
+                (lineBreak ? (lineBreak + 1) : end) - data);
+
+            if ((lineEnd != lineBegin) && (*(lineEnd - 1) == '\r')) {
+                --lineEnd;
+            }
+
+            return ReadLineStatus::Line;
+        }
+
+        if (m_readBufferAtEnd) {
+            return ReadLineStatus::EndOfFile;
+        }
+
+        // Moving the incomplete line to the beginning of the buffer and reading
+        // the next block of the file after it
+        int incompleteLineSize = m_readBufferDataSize - m_readBufferLineStart;
+        if (m_readBufferLineStart > 0) {
+            std::memmove(
+                m_readBuffer.data(), begin,
+                static_cast<size_t>(incompleteLineSize));
+
+            m_readBufferStartPos += m_readBufferLineStart;
+            m_readBufferLineStart = 0;
+            m_readBufferDataSize = incompleteLineSize;
+        }
+
+        if (m_readBufferDataSize == m_readBuffer.size()) {
+            // The line doesn't fit into the buffer, need a bigger one
+            m_readBuffer.resize(m_readBuffer.size() * 2);
+        }
+
+        qint64 bytesRead = logFile.read(
+            m_readBuffer.data() + m_readBufferDataSize,
+            m_readBuffer.size() - m_readBufferDataSize);
+
+        if (Q_UNLIKELY(bytesRead < 0)) {
+            errorDescription.setBase(
+                QT_TR_NOOP("Failed to read the data from log file"));
+
+            errorDescription.details() = logFile.errorString();
+            return ReadLineStatus::Error;
+        }
+
+        if (bytesRead == 0) {
+            m_readBufferAtEnd = true;
+        }
+
+        m_readBufferDataSize += static_cast<int>(bytesRead);
+    }
+}
+
 LogViewerModel::LogFileParser::ParseLineStatus
 LogViewerModel::LogFileParser::parseLogFileLine(
-    const QString & line, const ParseLineStatus previousParseLineStatus,
+    const char * lineBegin, const char * lineEnd,
+    const ParseLineStatus previousParseLineStatus,
     const QVector<LogLevel> & disabledLogLevels,
     const QRegExp & filterContentRegExp,
-    QVector<LogViewerModel::Data> & dataEntries, ErrorString & errorDescription)
+    QVector<LogViewerModel::Data> & dataEntries)
 {
-    int currentIndex = m_logParsingRegex.indexIn(line);
-    if (currentIndex < 0) {
+    LogLineTokens tokens;
+    LogLevel logLevel = LogLevel::Info;
+    int sourceFileLineNumber = 0;
+    if (!parseLogEntryStart(
+            lineBegin, lineEnd, tokens, logLevel, sourceFileLineNumber))
+    {
         if (previousParseLineStatus == ParseLineStatus::FilteredEntry) {
             return ParseLineStatus::FilteredEntry;
         }
 
         if (!dataEntries.isEmpty()) {
             LogViewerModel::Data & lastEntry = dataEntries.back();
-            appendLogEntryLine(lastEntry, line);
 
-            if (!filterContentRegExp.isEmpty() &&
-                (filterContentRegExp.indexIn(lastEntry.m_logEntry) >= 0))
-            {
-                dataEntries.pop_back();
-                return ParseLineStatus::FilteredEntry;
+            appendLogEntryLine(
+                lastEntry,
+                QString::fromUtf8(
+                    lineBegin, static_cast<int>(lineEnd - lineBegin)));
+
+            if (!filterContentRegExp.isEmpty()) {
+                int index =
+                    (m_contentFilterIsPlainText
+                         ? m_contentFilterStringMatcher.indexIn(
+                               lastEntry.m_logEntry)
+                         : filterContentRegExp.indexIn(lastEntry.m_logEntry));
+
+                if (index >= 0) {
+                    dataEntries.pop_back();
+                    return ParseLineStatus::FilteredEntry;
+                }
             }
         }
 
         return ParseLineStatus::AppendedToLastEntry;
     }
 
-    QStringList capturedTexts = m_logParsingRegex.capturedTexts();
+    // Log level is checked first as the cheapest filter: no need to look at
+    // the rest of the entry if it would be filtered out anyway
+    if (disabledLogLevels.contains(logLevel)) {
+        return ParseLineStatus::FilteredEntry;
+    }
 
-    if (capturedTexts.size() != 8) {
-        errorDescription.setBase(
-            QT_TR_NOOP("Error parsing the log file's contents: "
-                       "unexpected number of captures by regex"));
+    if (!filterContentRegExp.isEmpty() && m_contentFilterIsPlainText &&
+        !matchesPlainTextContentFilter(tokens.m_message) &&
+        !matchesPlainTextContentFilter(tokens.m_timestamp) &&
+        !matchesPlainTextContentFilter(tokens.m_sourceFileName))
+    {
+        return ParseLineStatus::FilteredEntry;
+    }
+
+    Data entry;
+    entry.m_logLevel = logLevel;
+    entry.m_sourceFileName = toString(tokens.m_sourceFileName);
+    entry.m_sourceFileLineNumber = sourceFileLineNumber;
 
-        errorDescription.details() += QString::number(capturedTexts.size());
-        return ParseLineStatus::Error;
+    QString message = toString(tokens.m_message);
+
+    if (!filterContentRegExp.isEmpty() && !m_contentFilterIsPlainText &&
+        filterContentRegExp.isValid() &&
+        (filterContentRegExp.indexIn(message) < 0) &&
+        (filterContentRegExp.indexIn(toString(tokens.m_timestamp)) < 0) &&
+        (filterContentRegExp.indexIn(entry.m_sourceFileName) < 0))
+    {
+        return ParseLineStatus::FilteredEntry;
     }
 
-    bool convertedSourceLineNumberToInt = false;
+    entry.m_timestamp = parseTimestamp(tokens.m_timestamp, tokens.m_timeZone);
+    entry.m_component = toString(tokens.m_component);
 
-    int sourceFileLineNumber =
-        capturedTexts[4].toInt(&convertedSourceLineNumberToInt);
+    appendLogEntryLine(entry, message);
+    dataEntries.push_back(entry);
 
-    if (!convertedSourceLineNumberToInt) {
-        errorDescription.setBase(
-            QT_TR_NOOP("Error parsing the log file's contents: failed to "
-                       "convert the source line number to int"));
+    return ParseLineStatus::CreatedNewEntry;
+}
 
-        errorDescription.details() += capturedTexts[3];
-        return ParseLineStatus::Error;
+bool LogViewerModel::LogFileParser::tokenizeLogFileLine(
+    const char * lineBegin, const char * lineEnd, LogLineTokens & tokens) const
+{
+    const char * pos = lineBegin;
+
+    // Date: "yyyy-MM-dd"
+    if ((lineEnd - pos) < 10) {
+        return false;
     }
 
-    Data entry;
-    entry.m_timestamp = QDateTime::fromString(
-        capturedTexts[1], QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"));
+    if (!hasDigits(pos, 4) || (pos[4] != '-') || !hasDigits(pos + 5, 2) ||
+        (pos[7] != '-') || !hasDigits(pos + 8, 2))
+    {
+        return false;
+    }
 
-    // Trying to add timezone info
-    QTimeZone timezone(capturedTexts[2].toLocal8Bit());
-    if (timezone.isValid()) {
-        entry.m_timestamp.setTimeZone(timezone);
+    pos += 10;
+
+    const char * next = skipChars(pos, lineEnd, isWhitespace);
+    if (next == pos) {
+        return false;
     }
 
-    entry.m_sourceFileName = capturedTexts[3];
-    entry.m_sourceFileLineNumber = sourceFileLineNumber;
+    pos = next;
+
+    // Time: "HH:mm:ss", any separator and from 1 to 17 digits of fractional
+    // seconds
+    if ((lineEnd - pos) < 10) {
+        return false;
+    }
+
+    if (!hasDigits(pos, 2) || (pos[2] != ':') || !hasDigits(pos + 3, 2) ||
+        (pos[5] != ':') || !hasDigits(pos + 6, 2))
+    {
+        return false;
+    }
 
-    const QString & logLevel = capturedTexts[5];
-    if (logLevel == QStringLiteral("Trace")) {
-        entry.m_logLevel = LogLevel::Trace;
+    pos += 9;
+
+    next = skipChars(pos, lineEnd, isAsciiDigit);
+    if ((next == pos) || ((next - pos) > 17)) {
+        return false;
     }
-    else if (logLevel == QStringLiteral("Debug")) {
-        entry.m_logLevel = LogLevel::Debug;
+
+    pos = next;
+
+    tokens.m_timestamp.m_begin = lineBegin;
+    tokens.m_timestamp.m_size = static_cast<int>(pos - lineBegin);
+
+    next = skipChars(pos, lineEnd, isWhitespace);
+    if (next == pos) {
+        return false;
     }
-    else if (logLevel == QStringLiteral("Info")) {
-        entry.m_logLevel = LogLevel::Info;
+
+    pos = next;
+
+    // Optional timezone: a word followed by whitespace; source file names
+    // always contain the line number delimiter so they are not confused with
+    // timezones
+    next = skipChars(pos, lineEnd, isWordChar);
+    if (next != pos) {
+        const char * afterTimeZone = skipChars(next, lineEnd, isWhitespace);
+        if (afterTimeZone != next) {
+            tokens.m_timeZone.m_begin = pos;
+            tokens.m_timeZone.m_size = static_cast<int>(next - pos);
+            pos = afterTimeZone;
+        }
     }
-    else if (logLevel == QStringLiteral("Warn")) {
-        entry.m_logLevel = LogLevel::Warning;
+
+    // Source file name and line number: "<source file>:<line number>"
+    next = skipChars(pos, lineEnd, isSourceFileNameChar);
+    if ((next == pos) || (next == lineEnd) || (*next != ':')) {
+        return false;
     }
-    else if (logLevel == QStringLiteral("Error")) {
-        entry.m_logLevel = LogLevel::Error;
+
+    tokens.m_sourceFileName.m_begin = pos;
+    tokens.m_sourceFileName.m_size = static_cast<int>(next - pos);
+    pos = next + 1;
+
+    next = skipChars(pos, lineEnd, isAsciiDigit);
+    if (next == pos) {
+        return false;
     }
-    else {
-        errorDescription.setBase(
-            QT_TR_NOOP("Error parsing the log file's contents: failed to parse "
-                       "the log level"));
 
-        errorDescription.details() += logLevel;
-        return ParseLineStatus::Error;
+    tokens.m_sourceFileLineNumber.m_begin = pos;
+    tokens.m_sourceFileLineNumber.m_size = static_cast<int>(next - pos);
+    pos = next;
+
+    next = skipChars(pos, lineEnd, isWhitespace);
+    if (next == pos) {
+        return false;
     }
 
-    if (disabledLogLevels.contains(entry.m_logLevel)) {
-        return ParseLineStatus::FilteredEntry;
+    pos = next;
+
+    // Log level: "[<level>]"
+    if ((pos == lineEnd) || (*pos != '[')) {
+        return false;
     }
 
-    entry.m_component = capturedTexts[6];
+    ++pos;
 
-    if (!filterContentRegExp.isEmpty() && filterContentRegExp.isValid() &&
-        (filterContentRegExp.indexIn(capturedTexts[7]) < 0) &&
-        (filterContentRegExp.indexIn(capturedTexts[1]) < 0) &&
-        (filterContentRegExp.indexIn(entry.m_sourceFileName) < 0))
+    next = skipChars(pos, lineEnd, isWordChar);
+    if ((next == pos) || (next == lineEnd) || (*next != ']')) {
+        return false;
+    }
+
+    tokens.m_logLevel.m_begin = pos;
+    tokens.m_logLevel.m_size = static_cast<int>(next - pos);
+    pos = next + 1;
+
+    // Optional component: whitespace and "[<component>]"
+    next = skipChars(pos, lineEnd, isWhitespace);
+    if ((next != pos) && (next != lineEnd) && (*next == '[')) {
+        const char * componentBegin = next + 1;
+
+        const char * componentEnd =
+            skipChars(componentBegin, lineEnd, isComponentChar);
+
+        if ((componentEnd != componentBegin) && (componentEnd != lineEnd) &&
+            (*componentEnd == ']'))
+        {
+            tokens.m_component.m_begin = componentBegin;
+
+            tokens.m_component.m_size =
+                static_cast<int>(componentEnd - componentBegin);
+
+            pos = componentEnd + 1;
+        }
+    }
+
+    // Message: ": <message>", the message is not empty
+    if ((pos == lineEnd) || (*pos != ':')) {
+        return false;
+    }
+
+    ++pos;
+
+    next = skipChars(pos, lineEnd, isWhitespace);
+    if (next == pos) {
+        return false;
+    }
+
+    if (next == lineEnd) {
+        // The message consists of whitespace only, at least one whitespace
+        // character must separate it from the colon
+        if ((next - pos) < 2) {
+            return false;
+        }
+
+        --next;
+    }
+
+    tokens.m_message.m_begin = next;
+    tokens.m_message.m_size = static_cast<int>(lineEnd - next);
+    return true;
+}
+
+QDateTime LogViewerModel::LogFileParser::parseTimestamp(
+    const ByteRange & timestamp, const ByteRange & timeZone)
+{
+    QDateTime dateTime;
+
+    const char * pos = timestamp.m_begin;
+    if ((timestamp.m_size == LOG_VIEWER_MODEL_TIMESTAMP_SIZE) &&
+        (pos[10] == ' ') && (pos[19] == '.'))
     {
-        return ParseLineStatus::FilteredEntry;
+        // Fast path for the format written by the logger, all digits were
+        // already checked by the tokenizer
+        QDate date(
+            parseDigits(pos, 4), parseDigits(pos + 5, 2),
+            parseDigits(pos + 8, 2));
+
+        QTime time(
+            parseDigits(pos + 11, 2), parseDigits(pos + 14, 2),
+            parseDigits(pos + 17, 2), parseDigits(pos + 20, 3));
+
+        if (date.isValid() && time.isValid()) {
+            dateTime = QDateTime(date, time);
+        }
+    }
+    else {
+        dateTime = QDateTime::fromString(
+            toString(timestamp), QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"));
     }
 
-    appendLogEntryLine(entry, capturedTexts[7]);
-    dataEntries.push_back(entry);
+    // Trying to add timezone info
+    if (timeZone.m_size > 0) {
+        const QTimeZone & zone = timeZoneForName(timeZone);
+        if (zone.isValid()) {
+            dateTime.setTimeZone(zone);
+        }
+    }
 
-    return ParseLineStatus::CreatedNewEntry;
+    return dateTime;
+}
+
+const QTimeZone & LogViewerModel::LogFileParser::timeZoneForName(
+    const ByteRange & name)
+{
+    // The raw data key is only used for lookup, the inserted key must own
+    // its data
+    auto it = m_timeZonesByName.find(
+        QByteArray::fromRawData(name.m_begin, name.m_size));
+
+    if (it != m_timeZonesByName.end()) {
+        return it.value();
+    }
+
+    QByteArray ianaId(name.m_begin, name.m_size);
+    it = m_timeZonesByName.insert(ianaId, QTimeZone(ianaId));
+    return it.value();
+}
+
+void LogViewerModel::LogFileParser::setupContentFilter(
+    const QRegExp & filterContentRegExp)
+{
+    if (filterContentRegExp == m_contentFilter) {
+        return;
+    }
+
+    m_contentFilter = filterContentRegExp;
+
+    QString pattern = filterContentRegExp.pattern();
+    auto patternSyntax = filterContentRegExp.patternSyntax();
+
+    m_contentFilterIsPlainText = false;
+    if (filterContentRegExp.caseSensitivity() == Qt::CaseSensitive) {
+        if (patternSyntax == QRegExp::FixedString) {
+            m_contentFilterIsPlainText = true;
+        }
+        else if (
+            (patternSyntax == QRegExp::Wildcard) ||
+            (patternSyntax == QRegExp::WildcardUnix))
+        {
+            m_contentFilterIsPlainText = true;
+            for (const QChar c: qAsConst(pattern)) {
+                if ((c == QChar::fromLatin1('*')) ||
+                    (c == QChar::fromLatin1('?')) ||
+                    (c == QChar::fromLatin1('[')) ||
+                    (c == QChar::fromLatin1(']')) ||
+                    (c == QChar::fromLatin1('\\')))
+                {
+                    m_contentFilterIsPlainText = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (m_contentFilterIsPlainText) {
+        m_contentFilterByteMatcher.setPattern(pattern.toUtf8());
+        m_contentFilterStringMatcher.setPattern(pattern);
+        m_contentFilterStringMatcher.setCaseSensitivity(Qt::CaseSensitive);
+    }
+
+    LVMPDEBUG(
+        "Content filter " << pattern << " is "
+                          << (m_contentFilterIsPlainText ? "" : "not ")
+                          << "plain text");
+}
+
+bool LogViewerModel::LogFileParser::matchesPlainTextContentFilter(
+    const ByteRange & range) const
+{
+    // Searching within UTF-8 bytes is equivalent to searching within decoded
+    // text because UTF-8 encoded characters can't match partially
+    return m_contentFilterByteMatcher.indexIn(range.m_begin, range.m_size) >= 0;
 }
 
 void LogViewerModel::LogFileParser::appendLogEntryLine(
@@ -313,6 +840,11 @@ void LogViewerModel::LogFileParser::appendLogEntryLine(
     data.m_logEntry += line;
 }
 
+QString LogViewerModel::LogFileParser::toString(const ByteRange & range)
+{
+    return QString::fromUtf8(range.m_begin, range.m_size);
+}
+
 void LogViewerModel::LogFileParser::setInternalLogEnabled(const bool enabled)
 {
     if (m_internalLogEnabled == enabled) {
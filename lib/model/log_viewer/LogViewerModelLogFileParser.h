@@ -21,7 +21,12 @@
 
 #include "LogViewerModel.h"
 
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QHash>
 #include <QRegExp>
+#include <QStringMatcher>
+#include <QTimeZone>
 
 namespace quentier {
 
@@ -30,6 +35,14 @@ class LogViewerModel::LogFileParser
 public:
     LogFileParser();
 
+    /**
+     * @brief parseDataEntriesFromLogFile - parses no more than maxDataEntries
+     * log entries from the log file starting at fromPos
+     *
+     * @param endPos        The position within the log file at which the next
+     *                      log entry not parsed due to maxDataEntries limit
+     *                      starts or the end of the log file
+     */
     bool parseDataEntriesFromLogFile(
         const qint64 fromPos, const int maxDataEntries,
         const QVector<LogLevel> & disabledLogLevels,
@@ -37,29 +50,202 @@ public:
         QVector<LogViewerModel::Data> & dataEntries, qint64 & endPos,
         ErrorString & errorDescription);
 
+    /**
+     * @brief parseDataEntriesFromData - parses all log entries from the part
+     * of the log file already present in memory, for example, memory mapped
+     *
+     * @param begin                 Pointer to the beginning of the data,
+     *                              the data must start at the beginning
+     *                              of a line
+     * @param end                   Pointer past the end of the data
+     * @param startPos              The position within the log file at which
+     *                              the data starts
+     * @param entryStartPositions   Positions within the log file at which
+     *                              the parsed log entries start
+     */
+    void parseDataEntriesFromData(
+        const char * begin, const char * end, const qint64 startPos,
+        const QVector<LogLevel> & disabledLogLevels,
+        const QRegExp & filterContentRegExp,
+        QVector<LogViewerModel::Data> & dataEntries,
+        QVector<qint64> & entryStartPositions);
+
+    /**
+     * @brief parseLogEntryStart - checks whether the log file line starts
+     * a new log entry without decoding the entry
+     *
+     * @param lineBegin     Pointer to the beginning of the line
+     * @param lineEnd       Pointer past the end of the line without line break
+     *                      characters
+     * @param logLevel      The log level of the entry started by the line
+     * @return              True if the line starts a new log entry, false
+     *                      if it is a continuation of the previous one
+     */
+    bool parseLogEntryStart(
+        const char * lineBegin, const char * lineEnd,
+        LogLevel & logLevel) const;
+
 private:
     enum class ParseLineStatus
     {
         AppendedToLastEntry = 0,
         FilteredEntry,
-        CreatedNewEntry,
+        CreatedNewEntry
+    };
+
+    /**
+     * @brief The ByteRange struct points to a part of a log file line within
+     * the read buffer without copying it
+     */
+    struct ByteRange
+    {
+        const char * m_begin = nullptr;
+        int m_size = 0;
+    };
+
+    /**
+     * @brief The LogLineTokens struct contains the parts of a log file line
+     * which starts a new log entry
+     */
+    struct LogLineTokens
+    {
+        ByteRange m_timestamp;
+        ByteRange m_timeZone;
+        ByteRange m_sourceFileName;
+        ByteRange m_sourceFileLineNumber;
+        ByteRange m_logLevel;
+        ByteRange m_component;
+        ByteRange m_message;
+    };
+
+    enum class ProcessLineStatus
+    {
+        Continue = 0,
+        Stop
+    };
+
+    enum class ReadLineStatus
+    {
+        Line = 0,
+        EndOfFile,
         Error
     };
 
+    /**
+     * @brief readLogFileLine - reads the next line from the log file into
+     * the read buffer
+     *
+     * @param logFile       The log file to read the line from
+     * @param lineBegin     Pointer to the beginning of the line within
+     *                      the read buffer
+     * @param lineEnd       Pointer past the end of the line without line break
+     *                      characters within the read buffer
+     * @return              ReadLineStatus::Line if the line was read,
+     *                      ReadLineStatus::EndOfFile if there are no more
+     *                      lines to read, ReadLineStatus::Error in case of
+     *                      read error
+     */
+    ReadLineStatus readLogFileLine(
+        QFile & logFile, const char *& lineBegin, const char *& lineEnd,
+        ErrorString & errorDescription);
+
+    /**
+     * @brief processLogFileLine - parses the log file line and decides whether
+     * parsing should continue
+     *
+     * @param maxDataEntries        The maximal number of log entries to
+     *                              parse, negative for no limit; when a line
+     *                              starts a log entry over the limit, parsing
+     *                              stops before it
+     * @param pEntryStartPositions  If not null, positions within the log file
+     *                              at which parsed log entries start are
+     *                              collected here
+     */
+    ProcessLineStatus processLogFileLine(
+        const char * lineBegin, const char * lineEnd, const qint64 linePos,
+        const int maxDataEntries, const QVector<LogLevel> & disabledLogLevels,
+        const QRegExp & filterContentRegExp,
+        ParseLineStatus & previousParseLineStatus,
+        QVector<LogViewerModel::Data> & dataEntries,
+        QVector<qint64> * pEntryStartPositions);
+
     ParseLineStatus parseLogFileLine(
-        const QString & line, const ParseLineStatus previousParseLineStatus,
+        const char * lineBegin, const char * lineEnd,
+        const ParseLineStatus previousParseLineStatus,
         const QVector<LogLevel> & disabledLogLevels,
         const QRegExp & filterContentRegExp,
-        QVector<LogViewerModel::Data> & dataEntries,
-        ErrorString & errorDescription);
+        QVector<LogViewerModel::Data> & dataEntries);
+
+    /**
+     * @brief parseLogEntryStart - splits the log file line into parts and
+     * parses its log level and source file line number if the line starts
+     * a new log entry
+     *
+     * Both parsing and indexing of the log file recognize log entry starts
+     * only with this method so that they always agree on where log entries
+     * start.
+     *
+     * @return              True if the line starts a new log entry, false
+     *                      if it is a continuation of the previous one;
+     *                      lines which look like log entry starts but have
+     *                      unknown log level or source file line number
+     *                      not fitting into int are continuations too
+     */
+    bool parseLogEntryStart(
+        const char * lineBegin, const char * lineEnd, LogLineTokens & tokens,
+        LogLevel & logLevel, int & sourceFileLineNumber) const;
+
+    /**
+     * @brief tokenizeLogFileLine - splits the log file line into parts if it
+     * starts a new log entry
+     *
+     * @return              True if the line starts a new log entry, false
+     *                      if it is a continuation of the previous one
+     */
+    bool tokenizeLogFileLine(
+        const char * lineBegin, const char * lineEnd,
+        LogLineTokens & tokens) const;
+
+    QDateTime parseTimestamp(
+        const ByteRange & timestamp, const ByteRange & timeZone);
+
+    const QTimeZone & timeZoneForName(const ByteRange & name);
+
+    /**
+     * @brief setupContentFilter - checks whether the content filter is plain
+     * text i.e. contains no wildcards and if so, prepares to search for it
+     * without decoding log entries
+     */
+    void setupContentFilter(const QRegExp & filterContentRegExp);
+
+    bool matchesPlainTextContentFilter(const ByteRange & range) const;
 
     void appendLogEntryLine(
         LogViewerModel::Data & data, const QString & line) const;
 
     void setInternalLogEnabled(const bool enabled);
 
+    static QString toString(const ByteRange & range);
+
 private:
-    QRegExp m_logParsingRegex;
+    // Buffer the log file is read into by blocks, lines are parsed right
+    // within it
+    QByteArray m_readBuffer;
+    int m_readBufferDataSize = 0;
+    int m_readBufferLineStart = 0;
+    qint64 m_readBufferStartPos = 0;
+    bool m_readBufferAtEnd = false;
+
+    // Time zones are looked up by name for each log entry, constructing
+    // QTimeZone from name is expensive so they are cached
+    QHash<QByteArray, QTimeZone> m_timeZonesByName;
+
+    // Plain text content filter is searched for within UTF-8 bytes of log
+    // entries so that entries not matching it are never decoded
+    QRegExp m_contentFilter;
+    bool m_contentFilterIsPlainText = false;
+    QByteArrayMatcher m_contentFilterByteMatcher;
+    QStringMatcher m_contentFilterStringMatcher;
 
     QFile m_internalLogFile;
     bool m_internalLogEnabled;
@@ -17,14 +17,19 @@
  */
 
 #include "NoteModel.h"
+#include "NotePreviewTextExtractor.h"
 
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/Compat.h>
 #include <quentier/utility/DateTime.h>
 #include <quentier/utility/Size.h>
 
-#include <QImage>
+#include <QElapsedTimer>
+#include <QPixmap>
+#include <QThreadPool>
+#include <QTimerEvent>
 
+#include <algorithm>
 #include <iterator>
 
 // Separate logging macros for the note model - to distinguish the one
@@ -59,8 +64,23 @@ inline QString includedNotesStr(
 #define NMERROR(message)                                                       \
     QNERROR("model:note", includedNotesStr(m_includedNotes) << message)
 
-// Limit for the queries to the local storage
-#define NOTE_LIST_QUERY_LIMIT (10)
+// Bounds for the limit of the queries to the local storage; the actual limit
+// adapts to the observed query durations and to the pace of fetchMore calls
+#define NOTE_LIST_QUERY_MIN_LIMIT (10)
+#define NOTE_LIST_QUERY_MAX_LIMIT (320)
+
+// Listing queries completed faster than this are considered cheap so the limit
+// for the following queries is increased
+#define NOTE_LIST_QUERY_FAST_MSEC (50)
+
+// Listing queries completed slower than this are considered expensive so
+// the limit for the following queries is decreased
+#define NOTE_LIST_QUERY_SLOW_MSEC (250)
+
+// fetchMore calls following each other faster than this indicate fast
+// scrolling through the list of notes so the limit for the queries is
+// increased
+#define NOTE_FETCH_MORE_FAST_SCROLL_MSEC (400)
 
 // Minimum number of notes which the model attempts to load from the local
 // storage
@@ -68,6 +88,13 @@ inline QString includedNotesStr(
 
 #define NOTE_PREVIEW_TEXT_SIZE (500)
 
+// Changes of note counts which can't be applied incrementally are coalesced
+// within this interval into a single request for each count
+#define NOTE_COUNTS_REFRESH_DELAY_MSEC (500)
+
+// Max amount of memory taken by decoded note thumbnails
+#define NOTE_THUMBNAIL_CACHE_MAX_COST_IN_BYTES (32 * 1024 * 1024)
+
 #define NUM_NOTE_MODEL_COLUMNS (12)
 
 #define REPORT_ERROR(error, ...)                                               \
@@ -87,9 +114,16 @@ NoteModel::NoteModel(
     m_account(account), m_includedNotes(includedNotes),
     m_noteSortingMode(noteSortingMode),
     m_localStorageManagerAsync(localStorageManagerAsync), m_cache(noteCache),
+    m_thumbnailCache(NOTE_THUMBNAIL_CACHE_MAX_COST_IN_BYTES),
     m_notebookCache(notebookCache), m_pFilters(pFilters),
-    m_maxNoteCount(NOTE_MIN_CACHE_SIZE * 2)
-{}
+    m_maxNoteCount(NOTE_MIN_CACHE_SIZE * 2),
+    m_targetLoadedNoteCount(NOTE_MIN_CACHE_SIZE),
+    m_listNotesQueryLimit(NOTE_LIST_QUERY_MIN_LIMIT)
+{
+    QObject::connect(
+        &m_thumbnailCache, &NoteThumbnailCache::thumbnailReady, this,
+        &NoteModel::onThumbnailReady);
+}
 
 NoteModel::~NoteModel() {}
 
@@ -187,6 +221,11 @@ const NoteModelItem * NoteModel::itemForIndex(const QModelIndex & index) const
     return itemAtRow(index.row());
 }
 
+NoteThumbnailCache & NoteModel::thumbnailCache() const
+{
+    return m_thumbnailCache;
+}
+
 bool NoteModel::hasFilters() const
 {
     return !m_pFilters->isEmpty();
@@ -374,6 +413,16 @@ qint32 NoteModel::totalAccountNotesCount() const
     return m_totalAccountNotesCount;
 }
 
+size_t NoteModel::listNotesRoundTripCount() const
+{
+    return m_listNotesRoundTripCount;
+}
+
+qint64 NoteModel::timeToFirstScreenMsec() const
+{
+    return m_timeToFirstScreenMsec;
+}
+
 QModelIndex NoteModel::createNoteItem(
     const QString & notebookLocalUid, ErrorString & errorDescription)
 {
@@ -437,6 +486,7 @@ QModelIndex NoteModel::createNoteItem(
     item.setModificationTimestamp(item.creationTimestamp());
     item.setDirty(true);
     item.setSynchronizable(m_account.type() != Account::Type::Local);
+    updateTitleSortKey(item);
 
     int row = rowForNewItem(item);
     beginInsertRows(QModelIndex(), row, row);
@@ -812,9 +862,19 @@ void NoteModel::sort(int column, Qt::SortOrder order)
         setSortingColumnAndOrder(column, order);
     }
 
-    if (m_isStarted) {
-        resetModel();
+    if (!m_isStarted) {
+        return;
+    }
+
+    if (allNotesLoaded()) {
+        NMDEBUG(
+            "All notes conforming to filters are loaded, sorting them "
+            << "in memory");
+        sortLoadedNoteItems();
+        return;
     }
+
+    resetModel();
 }
 
 bool NoteModel::canFetchMore(const QModelIndex & parent) const
@@ -860,7 +920,31 @@ void NoteModel::fetchMore(const QModelIndex & parent)
         return;
     }
 
-    m_maxNoteCount += NOTE_LIST_QUERY_LIMIT;
+    if (m_fetchMoreTimer.isValid() &&
+        (m_fetchMoreTimer.elapsed() < NOTE_FETCH_MORE_FAST_SCROLL_MSEC))
+    {
+        m_listNotesQueryLimit = std::min(
+            m_listNotesQueryLimit * 2, size_t(NOTE_LIST_QUERY_MAX_LIMIT));
+
+        NMDEBUG(
+            "Detected fast scrolling, increased list notes query limit to "
+            << m_listNotesQueryLimit);
+    }
+
+    m_fetchMoreTimer.start();
+
+    m_maxNoteCount += m_listNotesQueryLimit;
+
+    m_targetLoadedNoteCount = std::max(
+        m_targetLoadedNoteCount, m_data.size() + m_listNotesQueryLimit);
+
+    if (m_listNotesRequestId != QUuid()) {
+        NMDEBUG(
+            "List notes request is already in flight, more notes would be "
+            << "requested after its completion");
+        return;
+    }
+
     requestNotesList();
 }
 
@@ -911,24 +995,8 @@ void NoteModel::onAddNoteComplete(Note note, QUuid requestId)
         noteIncluded |= (m_includedNotes != IncludedNotes::Deleted);
     }
 
-    if (noteIncluded && (m_getFullNoteCountPerAccountRequestId == QUuid())) {
-        ++m_totalAccountNotesCount;
-
-        NMTRACE(
-            "Note count per account increased to " << m_totalAccountNotesCount);
-
-        Q_EMIT noteCountPerAccountUpdated(m_totalAccountNotesCount);
-    }
-
-    if (noteIncluded && (m_getNoteCountRequestId == QUuid()) &&
-        noteConformsToFilter(note))
-    {
-        ++m_totalFilteredNotesCount;
-
-        NMTRACE(
-            "Filtered notes count increased to " << m_totalFilteredNotesCount);
-
-        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+    if (noteIncluded) {
+        updateNoteCounts(1, noteConformsToFilter(note));
     }
 
     auto it = m_addNoteRequestIds.find(requestId);
@@ -974,16 +1042,37 @@ void NoteModel::onUpdateNoteComplete(
         (!note.hasDeletionTimestamp() &&
          (m_includedNotes == IncludedNotes::Deleted));
 
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    bool noteWithinModel =
+        (localUidIndex.find(note.localUid()) != localUidIndex.end());
+
     if (shouldRemoveNoteFromModel) {
+        if (noteWithinModel) {
+            // The note was counted but it's no longer included into the model
+            updateNoteCounts(-1, true);
+        }
+        else {
+            // It's unknown whether the note not loaded into the model was
+            // counted before the update
+            scheduleNoteCountsRefresh();
+        }
+
         removeItemByLocalUid(note.localUid());
     }
+    else if (!noteWithinModel && noteInclusionMightHaveChanged(note, options))
+    {
+        // The note not loaded into the model might have just become included
+        // into it, for example, due to restoring from trash
+        scheduleNoteCountsRefresh();
+    }
+
+    m_thumbnailCache.invalidate(note.localUid());
 
     auto it = m_updateNoteRequestIds.find(requestId);
     if (it != m_updateNoteRequestIds.end()) {
         NMDEBUG("This update was initiated by the note model");
         Q_UNUSED(m_updateNoteRequestIds.erase(it))
 
-        const auto & localUidIndex = m_data.get<ByLocalUid>();
         auto itemIt = localUidIndex.find(note.localUid());
         if (itemIt != localUidIndex.end()) {
             const auto & item = *itemIt;
@@ -1009,7 +1098,6 @@ void NoteModel::onUpdateNoteComplete(
 
     if (!shouldRemoveNoteFromModel) {
         if (!(options & LocalStorageManager::UpdateNoteOption::UpdateTags)) {
-            const auto & localUidIndex = m_data.get<ByLocalUid>();
             auto noteItemIt = localUidIndex.find(note.localUid());
             if (noteItemIt != localUidIndex.end()) {
                 const auto & item = *noteItemIt;
@@ -1146,7 +1234,7 @@ void NoteModel::onListNotesComplete(
         << ", num found notes = " << foundNotes.size()
         << ", request id = " << requestId);
 
-    onListNotesCompleteImpl(foundNotes);
+    onListNotesCompleteImpl(limit, foundNotes);
 }
 
 void NoteModel::onListNotesFailed(
@@ -1212,7 +1300,7 @@ void NoteModel::onListNotesPerNotebooksAndTagsComplete(
         << ", num found notes = " << foundNotes.size()
         << ", request id = " << requestId);
 
-    onListNotesCompleteImpl(foundNotes);
+    onListNotesCompleteImpl(limit, foundNotes);
 }
 
 void NoteModel::onListNotesPerNotebooksAndTagsFailed(
@@ -1278,7 +1366,7 @@ void NoteModel::onListNotesByLocalUidsComplete(
         << ", num found notes = " << foundNotes.size()
         << ", request id = " << requestId);
 
-    onListNotesCompleteImpl(foundNotes);
+    onListNotesCompleteImpl(limit, foundNotes);
 }
 
 void NoteModel::onListNotesByLocalUidsFailed(
@@ -1434,21 +1522,28 @@ void NoteModel::onExpungeNoteComplete(Note note, QUuid requestId)
         "NoteModel::onExpungeNoteComplete: note = " << note << "\nRequest id = "
                                                     << requestId);
 
-    if (m_getFullNoteCountPerAccountRequestId == QUuid()) {
-        requestTotalNotesCountPerAccount();
-    }
-
-    if (m_getNoteCountRequestId == QUuid()) {
-        requestTotalFilteredNotesCount();
-    }
+    m_thumbnailCache.invalidate(note.localUid());
 
     auto it = m_expungeNoteRequestIds.find(requestId);
     if (it != m_expungeNoteRequestIds.end()) {
         Q_UNUSED(m_expungeNoteRequestIds.erase(it))
+
+        // The note was expunged from the model so it was counted
+        updateNoteCounts(-1, true);
         return;
     }
 
-    removeItemByLocalUid(note.localUid());
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    if (localUidIndex.find(note.localUid()) != localUidIndex.end()) {
+        // The note is within the model so it was counted
+        updateNoteCounts(-1, true);
+        removeItemByLocalUid(note.localUid());
+        return;
+    }
+
+    // The note might have been counted despite not being loaded into
+    // the model, need to recount
+    scheduleNoteCountsRefresh();
 }
 
 void NoteModel::onExpungeNoteFailed(
@@ -1647,6 +1742,68 @@ void NoteModel::onFindTagFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
+void NoteModel::onListTagsComplete(
+    LocalStorageManager::ListObjectsOptions flag, size_t limit, size_t offset,
+    LocalStorageManager::ListTagsOrder order,
+    LocalStorageManager::OrderDirection orderDirection,
+    QString linkedNotebookGuid, QList<Tag> tags, QUuid requestId)
+{
+    if (requestId != m_listTagsRequestId) {
+        return;
+    }
+
+    NMDEBUG(
+        "NoteModel::onListTagsComplete: flag = "
+        << flag << ", limit = " << limit << ", offset = " << offset
+        << ", order = " << order << ", direction = " << orderDirection
+        << ", linked notebook guid = " << linkedNotebookGuid
+        << ", num found tags = " << tags.size()
+        << ", request id = " << requestId);
+
+    m_listTagsRequestId = QUuid();
+    m_allTagsListed = true;
+
+    // Collecting the notes affected by listed tags first so that each note's
+    // tag names are updated once rather than once per each of its tags
+    QSet<QString> affectedNoteLocalUids;
+    for (const auto & tag: qAsConst(tags)) {
+        setTagData(tag);
+
+        auto noteIt = m_noteLocalUidsByTagLocalUid.find(tag.localUid());
+        if (noteIt != m_noteLocalUidsByTagLocalUid.end()) {
+            affectedNoteLocalUids.unite(noteIt.value());
+        }
+    }
+
+    updateTagNamesForNotes(affectedNoteLocalUids);
+    findTagsNotFoundByListing();
+}
+
+void NoteModel::onListTagsFailed(
+    LocalStorageManager::ListObjectsOptions flag, size_t limit, size_t offset,
+    LocalStorageManager::ListTagsOrder order,
+    LocalStorageManager::OrderDirection orderDirection,
+    QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
+{
+    if (requestId != m_listTagsRequestId) {
+        return;
+    }
+
+    NMWARNING(
+        "NoteModel::onListTagsFailed: flag = "
+        << flag << ", limit = " << limit << ", offset = " << offset
+        << ", order = " << order << ", direction = " << orderDirection
+        << ", linked notebook guid = " << linkedNotebookGuid
+        << ", error description = " << errorDescription
+        << ", request id = " << requestId);
+
+    m_listTagsRequestId = QUuid();
+
+    // Falling back to searching for the tags individually
+    m_allTagsListed = true;
+    findTagsNotFoundByListing();
+}
+
 void NoteModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
     NMTRACE(
@@ -1683,6 +1840,99 @@ void NoteModel::onExpungeTagComplete(
     }
 }
 
+void NoteModel::onThumbnailReady(QString noteLocalUid)
+{
+    NMTRACE("NoteModel::onThumbnailReady: note local uid = " << noteLocalUid);
+
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto it = localUidIndex.find(noteLocalUid);
+    if (it == localUidIndex.end()) {
+        NMTRACE("The note is no longer within the model");
+        return;
+    }
+
+    const auto & index = m_data.get<ByIndex>();
+    auto indexIt = m_data.project<ByIndex>(it);
+    int row = static_cast<int>(std::distance(index.begin(), indexIt));
+
+    auto modelIndex = createIndex(row, Columns::ThumbnailImage);
+    Q_EMIT dataChanged(modelIndex, modelIndex);
+}
+
+void NoteModel::onPreviewTextExtracted(
+    QString noteLocalUid, quint64 requestId, QString previewText)
+{
+    NMTRACE(
+        "NoteModel::onPreviewTextExtracted: note local uid = "
+        << noteLocalUid << ", request id = " << requestId);
+
+    auto requestIt = m_previewTextRequestIdByNoteLocalUid.find(noteLocalUid);
+    if ((requestIt == m_previewTextRequestIdByNoteLocalUid.end()) ||
+        (requestIt.value() != requestId))
+    {
+        NMTRACE("Preview text request is outdated");
+        return;
+    }
+
+    Q_UNUSED(m_previewTextRequestIdByNoteLocalUid.erase(requestIt))
+
+    // The note might be waiting for its notebook data before being added to
+    // or updated within the model; the preview text is kept within the pending
+    // item so that it is not lost or overwritten with the outdated one
+    for (auto pendingIt = m_noteItemsPendingNotebookDataUpdate.begin(),
+              pendingEnd = m_noteItemsPendingNotebookDataUpdate.end();
+         pendingIt != pendingEnd; ++pendingIt)
+    {
+        auto & pendingItem = pendingIt.value();
+        if (pendingItem.localUid() == noteLocalUid) {
+            pendingItem.setPreviewText(previewText);
+            updateTitleSortKey(pendingItem);
+        }
+    }
+
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto it = localUidIndex.find(noteLocalUid);
+    if (it == localUidIndex.end()) {
+        NMTRACE("The note is no longer within the model");
+        return;
+    }
+
+    if (it->previewText() == previewText) {
+        return;
+    }
+
+    NoteModelItem item = *it;
+    item.setPreviewText(previewText);
+
+    // The sort key is computed within the GUI thread as QCollator is not
+    // thread-safe
+    updateTitleSortKey(item);
+
+    const auto & index = m_data.get<ByIndex>();
+    auto indexIt = m_data.project<ByIndex>(it);
+    int row = static_cast<int>(std::distance(index.begin(), indexIt));
+
+    Q_UNUSED(localUidIndex.replace(it, item))
+
+    auto modelIndexFrom = createIndex(row, Columns::Title);
+    auto modelIndexTo = createIndex(row, Columns::PreviewText);
+    Q_EMIT dataChanged(modelIndexFrom, modelIndexTo);
+
+    auto column = sortingColumn();
+    if (!((column == Columns::Title) && item.title().isEmpty()) &&
+        (column != Columns::PreviewText))
+    {
+        return;
+    }
+
+    ErrorString errorDescription;
+    if (!updateItemRowWithRespectToSorting(item, errorDescription)) {
+        NMWARNING(
+            "Could not update note model item's row: "
+            << errorDescription << "; item: " << item);
+    }
+}
+
 void NoteModel::connectToLocalStorage()
 {
     NMDEBUG("NoteModel::connectToLocalStorage");
@@ -1739,6 +1989,10 @@ void NoteModel::connectToLocalStorage()
         this, &NoteModel::findTag, &m_localStorageManagerAsync,
         &LocalStorageManagerAsync::onFindTagRequest);
 
+    QObject::connect(
+        this, &NoteModel::listTags, &m_localStorageManagerAsync,
+        &LocalStorageManagerAsync::onListTagsRequest);
+
     // LocalStorageManagerAsync's signals to local slots
     QObject::connect(
         &m_localStorageManagerAsync, &LocalStorageManagerAsync::addNoteComplete,
@@ -1859,6 +2113,15 @@ void NoteModel::connectToLocalStorage()
         &m_localStorageManagerAsync, &LocalStorageManagerAsync::findTagFailed,
         this, &NoteModel::onFindTagFailed);
 
+    QObject::connect(
+        &m_localStorageManagerAsync,
+        &LocalStorageManagerAsync::listTagsComplete, this,
+        &NoteModel::onListTagsComplete);
+
+    QObject::connect(
+        &m_localStorageManagerAsync, &LocalStorageManagerAsync::listTagsFailed,
+        this, &NoteModel::onListTagsFailed);
+
     QObject::connect(
         &m_localStorageManagerAsync, &LocalStorageManagerAsync::addTagComplete,
         this, &NoteModel::onAddTagComplete);
@@ -1909,6 +2172,17 @@ void NoteModel::onNoteAddedOrUpdated(
     NoteModelItem item;
     noteToItem(note, item);
 
+    const auto * pNotebookData = findNotebookDataForNoteItem(note, item);
+    if (!pNotebookData) {
+        return;
+    }
+
+    addOrUpdateNoteItem(item, *pNotebookData, fromNotesListing);
+}
+
+const NoteModel::NotebookData * NoteModel::findNotebookDataForNoteItem(
+    const Note & note, const NoteModelItem & item)
+{
     auto notebookIt =
         m_notebookDataByNotebookLocalUid.find(item.notebookLocalUid());
     if (notebookIt == m_notebookDataByNotebookLocalUid.end()) {
@@ -1920,52 +2194,44 @@ void NoteModel::onNoteAddedOrUpdated(
         }
     }
 
-    if (notebookIt == m_notebookDataByNotebookLocalUid.end()) {
-        bool findNotebookRequestSent = false;
-
-        Q_UNUSED(m_noteItemsPendingNotebookDataUpdate.insert(
-            item.notebookLocalUid(), item))
-
-        auto it = m_findNotebookRequestForNotebookLocalUid.left.find(
-            item.notebookLocalUid());
+    if (notebookIt != m_notebookDataByNotebookLocalUid.end()) {
+        return &(notebookIt.value());
+    }
 
-        if (it != m_findNotebookRequestForNotebookLocalUid.left.end()) {
-            findNotebookRequestSent = true;
-        }
+    Q_UNUSED(m_noteItemsPendingNotebookDataUpdate.insert(
+        item.notebookLocalUid(), item))
 
-        if (!findNotebookRequestSent) {
-            Notebook notebook;
-            if (note.hasNotebookLocalUid()) {
-                notebook.setLocalUid(note.notebookLocalUid());
-            }
-            else {
-                notebook.setLocalUid(QString());
-                notebook.setGuid(note.notebookGuid());
-            }
+    auto it = m_findNotebookRequestForNotebookLocalUid.left.find(
+        item.notebookLocalUid());
 
-            auto requestId = QUuid::createUuid();
+    if (it != m_findNotebookRequestForNotebookLocalUid.left.end()) {
+        NMTRACE(
+            "The request to find notebook for this note has already "
+            << "been sent");
+        return nullptr;
+    }
 
-            Q_UNUSED(m_findNotebookRequestForNotebookLocalUid.insert(
-                LocalUidToRequestIdBimap::value_type(
-                    item.notebookLocalUid(), requestId)))
+    Notebook notebook;
+    if (note.hasNotebookLocalUid()) {
+        notebook.setLocalUid(note.notebookLocalUid());
+    }
+    else {
+        notebook.setLocalUid(QString());
+        notebook.setGuid(note.notebookGuid());
+    }
 
-            NMTRACE(
-                "Emitting the request to find notebook local uid: = "
-                << item.notebookLocalUid() << ", request id = " << requestId);
+    auto requestId = QUuid::createUuid();
 
-            Q_EMIT findNotebook(notebook, requestId);
-        }
-        else {
-            NMTRACE(
-                "The request to find notebook for this note has already "
-                << "been sent");
-        }
+    Q_UNUSED(m_findNotebookRequestForNotebookLocalUid.insert(
+        LocalUidToRequestIdBimap::value_type(
+            item.notebookLocalUid(), requestId)))
 
-        return;
-    }
+    NMTRACE(
+        "Emitting the request to find notebook local uid: = "
+        << item.notebookLocalUid() << ", request id = " << requestId);
 
-    const auto & notebookData = notebookIt.value();
-    addOrUpdateNoteItem(item, notebookData, fromNotesListing);
+    Q_EMIT findNotebook(notebook, requestId);
+    return nullptr;
 }
 
 void NoteModel::noteToItem(const Note & note, NoteModelItem & item)
@@ -1976,12 +2242,15 @@ void NoteModel::noteToItem(const Note & note, NoteModelItem & item)
         item.setGuid(note.guid());
     }
 
+    // NOTE: notebook and tag references are interned as they are repeated
+    // across many notes
+
     if (note.hasNotebookGuid()) {
-        item.setNotebookGuid(note.notebookGuid());
+        item.setNotebookGuid(m_stringPool.intern(note.notebookGuid()));
     }
 
     if (note.hasNotebookLocalUid()) {
-        item.setNotebookLocalUid(note.notebookLocalUid());
+        item.setNotebookLocalUid(m_stringPool.intern(note.notebookLocalUid()));
     }
 
     if (note.hasTitle()) {
@@ -1989,16 +2258,24 @@ void NoteModel::noteToItem(const Note & note, NoteModelItem & item)
     }
 
     if (note.hasContent()) {
-        QString previewText = note.plainText();
-        previewText.truncate(NOTE_PREVIEW_TEXT_SIZE);
-        item.setPreviewText(previewText);
+        // The preview text is extracted from note's content in background;
+        // until then the item keeps the preview text it had within the model
+        const auto & localUidIndex = m_data.get<ByLocalUid>();
+        auto it = localUidIndex.find(item.localUid());
+        if (it != localUidIndex.end()) {
+            item.setPreviewText(it->previewText());
+        }
+
+        requestPreviewText(note.localUid(), note.content());
     }
 
+    updateTitleSortKey(item);
+
     item.setThumbnailData(note.thumbnailData());
 
     if (note.hasTagLocalUids()) {
         const QStringList & tagLocalUids = note.tagLocalUids();
-        item.setTagLocalUids(tagLocalUids);
+        item.setTagLocalUids(m_stringPool.intern(tagLocalUids));
 
         QStringList tagNames;
         tagNames.reserve(tagLocalUids.size());
@@ -2017,8 +2294,7 @@ void NoteModel::noteToItem(const Note & note, NoteModelItem & item)
     }
 
     if (note.hasTagGuids()) {
-        const QStringList tagGuids = note.tagGuids();
-        item.setTagGuids(tagGuids);
+        item.setTagGuids(m_stringPool.intern(note.tagGuids()));
     }
 
     if (note.hasCreationTimestamp()) {
@@ -2094,6 +2370,29 @@ void NoteModel::noteToItem(const Note & note, NoteModelItem & item)
     item.setSizeInBytes(static_cast<quint64>(sizeInBytes));
 }
 
+void NoteModel::requestPreviewText(
+    const QString & noteLocalUid, const QString & noteContent)
+{
+    quint64 requestId = ++m_lastPreviewTextRequestId;
+    m_previewTextRequestIdByNoteLocalUid[noteLocalUid] = requestId;
+
+    auto * pExtractor = new NotePreviewTextExtractor(
+        noteLocalUid, requestId, noteContent, NOTE_PREVIEW_TEXT_SIZE);
+
+    QObject::connect(
+        pExtractor, &NotePreviewTextExtractor::previewTextExtracted, this,
+        &NoteModel::onPreviewTextExtracted, Qt::QueuedConnection);
+
+    QThreadPool::globalInstance()->start(pExtractor);
+}
+
+void NoteModel::updateTitleSortKey(NoteModelItem & item) const
+{
+    const QString & title = item.title();
+    item.setTitleSortKey(
+        m_collator.sortKey(title.isEmpty() ? item.previewText() : title));
+}
+
 bool NoteModel::noteConformsToFilter(const Note & note) const
 {
     if (Q_UNLIKELY(!note.hasNotebookLocalUid())) {
@@ -2141,41 +2440,140 @@ bool NoteModel::noteConformsToFilter(const Note & note) const
     return true;
 }
 
-void NoteModel::onListNotesCompleteImpl(const QList<Note> foundNotes)
+void NoteModel::onListNotesCompleteImpl(
+    const size_t limit, const QList<Note> foundNotes)
 {
-    bool fromNotesListing = true;
+    const bool fromNotesListing = true;
+
+    onListNotesRequestCompleted(limit, foundNotes.size());
+
+    // Requesting the next page before processing the current one so that
+    // the local storage can list it while the current page is being applied
+    size_t numPendingItems = static_cast<size_t>(foundNotes.size());
+    if (!foundNotes.isEmpty() &&
+        (m_data.size() + numPendingItems < m_targetLoadedNoteCount))
+    {
+        NMTRACE("Prefetching the next page of notes");
+        requestNotesList(numPendingItems);
+    }
+
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+
+    std::vector<NoteModelItem> newItems;
+    newItems.reserve(static_cast<size_t>(foundNotes.size()));
 
     for (const auto & foundNote: qAsConst(foundNotes)) {
-        onNoteAddedOrUpdated(foundNote, fromNotesListing);
+        if (Q_UNLIKELY(!foundNote.hasNotebookLocalUid())) {
+            NMWARNING(
+                "Skipping the note not having the notebook local uid: "
+                << foundNote);
+            continue;
+        }
+
+        NoteModelItem item;
+        noteToItem(foundNote, item);
+
+        const auto * pNotebookData =
+            findNotebookDataForNoteItem(foundNote, item);
+
+        if (!pNotebookData) {
+            continue;
+        }
+
+        if (localUidIndex.find(item.localUid()) != localUidIndex.end()) {
+            addOrUpdateNoteItem(item, *pNotebookData, fromNotesListing);
+            continue;
+        }
+
+        item.setNotebookName(pNotebookData->m_name);
+        newItems.push_back(std::move(item));
     }
 
-    m_listNotesOffset += static_cast<size_t>(foundNotes.size());
-    m_listNotesRequestId = QUuid();
+    addNoteItemsFromListing(std::move(newItems));
 
-    if (!foundNotes.isEmpty() && (m_data.size() < NOTE_MIN_CACHE_SIZE)) {
+    if (!foundNotes.isEmpty() && (m_data.size() < m_targetLoadedNoteCount) &&
+        (m_listNotesRequestId == QUuid()))
+    {
         NMTRACE(
             "The number of found notes is greater than zero, "
             << "requesting more notes from the local storage");
         requestNotesList();
     }
-    else {
+
+    if (m_listNotesRequestId == QUuid()) {
+        if (m_firstScreenTimer.isValid()) {
+            m_timeToFirstScreenMsec = m_firstScreenTimer.elapsed();
+            m_firstScreenTimer.invalidate();
+
+            NMDEBUG(
+                "Loaded the first batch of notes within "
+                << m_timeToFirstScreenMsec << " msec using "
+                << m_listNotesRoundTripCount << " list notes requests");
+        }
+
         NMDEBUG("Emitting minimalNotesBatchLoaded signal");
         Q_EMIT minimalNotesBatchLoaded();
     }
 }
 
+void NoteModel::onListNotesRequestCompleted(
+    const size_t limit, const int numFoundNotes)
+{
+    ++m_listNotesRoundTripCount;
+
+    m_listNotesOffset += static_cast<size_t>(std::max(numFoundNotes, 0));
+    m_listNotesRequestId = QUuid();
+
+    qint64 elapsed = m_listNotesTimer.elapsed();
+
+    NMTRACE(
+        "List notes request completed within "
+        << elapsed << " msec, limit = " << limit
+        << ", num found notes = " << numFoundNotes);
+
+    // Adapt the limit only by full pages: a partial page means there are no
+    // more notes to list
+    if (static_cast<size_t>(std::max(numFoundNotes, 0)) < limit) {
+        return;
+    }
+
+    if (elapsed < NOTE_LIST_QUERY_FAST_MSEC) {
+        m_listNotesQueryLimit = std::min(
+            m_listNotesQueryLimit * 2, size_t(NOTE_LIST_QUERY_MAX_LIMIT));
+    }
+    else if (elapsed > NOTE_LIST_QUERY_SLOW_MSEC) {
+        m_listNotesQueryLimit = std::max(
+            m_listNotesQueryLimit / 2, size_t(NOTE_LIST_QUERY_MIN_LIMIT));
+    }
+}
+
 void NoteModel::requestNotesListAndCount()
 {
     NMDEBUG("NoteModel::requestNotesListAndCount");
 
+    m_firstScreenTimer.start();
+    m_timeToFirstScreenMsec = -1;
+
     requestNotesList();
     requestNotesCount();
 }
 
-void NoteModel::requestNotesList()
+void NoteModel::requestNotesList(const size_t numPendingItems)
 {
-    NMDEBUG("NoteModel::requestNotesList");
-
+    NMDEBUG(
+        "NoteModel::requestNotesList: num pending items = "
+        << numPendingItems);
+
+    // Not listing more notes than the model can hold: the notes listed beyond
+    // the max note count would be dropped and never listed again
+    size_t numItems = m_data.size() + numPendingItems;
+    if (numItems >= m_maxNoteCount) {
+        NMDEBUG("The model already holds max allowed number of notes");
+        return;
+    }
+
+    size_t limit = std::min(m_listNotesQueryLimit, m_maxNoteCount - numItems);
+
     LocalStorageManager::ListObjectsOptions flags =
         LocalStorageManager::ListObjectsOption::ListAll;
 
@@ -2210,13 +2608,15 @@ void NoteModel::requestNotesList()
         order = LocalStorageManager::ListNotesOrder::ByTitle;
         direction = LocalStorageManager::OrderDirection::Descending;
         break;
-    // NOTE: no sorting by side is supported by the local storage so leaving
-    // it as is for now
+    // NOTE: no sorting by size is supported by the local storage so leaving
+    // it as is for now; once all notes are loaded, sorting by size is done
+    // in memory
     default:
         break;
     }
 
     m_listNotesRequestId = QUuid::createUuid();
+    m_listNotesTimer.start();
 
     if (!hasFilters()) {
         NMDEBUG(
@@ -2231,15 +2631,15 @@ void NoteModel::requestNotesList()
 #else
             LocalStorageManager::GetNoteOptions(0),
 #endif
-            NOTE_LIST_QUERY_LIMIT, m_listNotesOffset, order, direction,
-            QString(), m_listNotesRequestId);
+            limit, m_listNotesOffset, order, direction, QString(),
+            m_listNotesRequestId);
 
         return;
     }
 
     const auto & filteredNoteLocalUids = m_pFilters->filteredNoteLocalUids();
     if (!filteredNoteLocalUids.isEmpty()) {
-        int end = static_cast<int>(m_listNotesOffset) + NOTE_LIST_QUERY_LIMIT;
+        int end = static_cast<int>(m_listNotesOffset + limit);
         end = std::min(end, filteredNoteLocalUids.size());
 
         auto beginIt = filteredNoteLocalUids.begin();
@@ -2270,8 +2670,7 @@ void NoteModel::requestNotesList()
 #else
             LocalStorageManager::GetNoteOptions(0),
 #endif
-            flags, NOTE_LIST_QUERY_LIMIT, 0, order, direction,
-            m_listNotesRequestId);
+            flags, limit, 0, order, direction, m_listNotesRequestId);
 
         return;
     }
@@ -2294,7 +2693,7 @@ void NoteModel::requestNotesList()
 #else
         LocalStorageManager::GetNoteOptions(0),
 #endif
-        flags, NOTE_LIST_QUERY_LIMIT, m_listNotesOffset, order, direction,
+        flags, limit, m_listNotesOffset, order, direction,
         m_listNotesRequestId);
 }
 
@@ -2364,6 +2763,140 @@ void NoteModel::requestTotalFilteredNotesCount()
         notebookLocalUids, tagLocalUids, options, m_getNoteCountRequestId);
 }
 
+void NoteModel::updateNoteCounts(
+    const qint32 delta, const bool affectsFilteredNotesCount)
+{
+    NMTRACE(
+        "NoteModel::updateNoteCounts: delta = "
+        << delta << ", affects filtered notes count = "
+        << (affectsFilteredNotesCount ? "true" : "false"));
+
+    // If the count is being requested or is about to be requested, it's
+    // unknown whether the pending result would take the change into account
+    // so the count needs to be requested once again
+    if (m_getFullNoteCountPerAccountRequestId.isNull() &&
+        !m_noteCountPerAccountRefreshPending)
+    {
+        m_totalAccountNotesCount =
+            std::max(m_totalAccountNotesCount + delta, qint32(0));
+
+        NMTRACE(
+            "Note count per account updated to " << m_totalAccountNotesCount);
+
+        Q_EMIT noteCountPerAccountUpdated(m_totalAccountNotesCount);
+    }
+    else {
+        scheduleNoteCountsRefresh(true, false);
+    }
+
+    if (!affectsFilteredNotesCount) {
+        return;
+    }
+
+    if (m_getNoteCountRequestId.isNull() &&
+        !m_filteredNotesCountRefreshPending)
+    {
+        m_totalFilteredNotesCount =
+            std::max(m_totalFilteredNotesCount + delta, qint32(0));
+
+        NMTRACE(
+            "Filtered notes count updated to " << m_totalFilteredNotesCount);
+
+        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+    }
+    else {
+        scheduleNoteCountsRefresh(false, true);
+    }
+}
+
+void NoteModel::scheduleNoteCountsRefresh(
+    const bool noteCountPerAccount, const bool filteredNotesCount)
+{
+    m_noteCountPerAccountRefreshPending |= noteCountPerAccount;
+    m_filteredNotesCountRefreshPending |= filteredNotesCount;
+
+    // Not restarting the active timer so that continuous changes, for example
+    // during the sync, don't postpone the refresh indefinitely
+    if (!m_noteCountsRefreshTimer.isActive()) {
+        NMTRACE("Scheduling note counts refresh");
+        m_noteCountsRefreshTimer.start(NOTE_COUNTS_REFRESH_DELAY_MSEC, this);
+    }
+}
+
+bool NoteModel::noteInclusionMightHaveChanged(
+    const Note & note,
+    const LocalStorageManager::UpdateNoteOptions options) const
+{
+    // The previous version of the note not loaded into the model is only
+    // known if the note is cached. The cache is shared with other models
+    // though so the model which has performed the update might have already
+    // replaced the cached note with the updated one. In either case
+    // the inclusion of the note into the model might have changed
+    const auto * pPreviousNote = m_cache.get(note.localUid());
+    if (!pPreviousNote || (*pPreviousNote == note)) {
+        return true;
+    }
+
+    if (pPreviousNote->hasDeletionTimestamp() != note.hasDeletionTimestamp()) {
+        return true;
+    }
+
+    QString previousNotebookLocalUid =
+        (pPreviousNote->hasNotebookLocalUid()
+             ? pPreviousNote->notebookLocalUid()
+             : QString());
+
+    QString notebookLocalUid =
+        (note.hasNotebookLocalUid() ? note.notebookLocalUid() : QString());
+
+    if (previousNotebookLocalUid != notebookLocalUid) {
+        return true;
+    }
+
+    if (!(options & LocalStorageManager::UpdateNoteOption::UpdateTags)) {
+        return false;
+    }
+
+    QStringList previousTagLocalUids =
+        (pPreviousNote->hasTagLocalUids() ? pPreviousNote->tagLocalUids()
+                                          : QStringList());
+
+    QStringList tagLocalUids =
+        (note.hasTagLocalUids() ? note.tagLocalUids() : QStringList());
+
+    return previousTagLocalUids != tagLocalUids;
+}
+
+void NoteModel::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() != m_noteCountsRefreshTimer.timerId()) {
+        QAbstractItemModel::timerEvent(pEvent);
+        return;
+    }
+
+    m_noteCountsRefreshTimer.stop();
+
+    NMDEBUG(
+        "Refreshing note counts: per account = "
+        << (m_noteCountPerAccountRefreshPending ? "true" : "false")
+        << ", filtered = "
+        << (m_filteredNotesCountRefreshPending ? "true" : "false"));
+
+    if (m_noteCountPerAccountRefreshPending) {
+        m_noteCountPerAccountRefreshPending = false;
+        requestTotalNotesCountPerAccount();
+    }
+
+    if (m_filteredNotesCountRefreshPending) {
+        m_filteredNotesCountRefreshPending = false;
+        requestTotalFilteredNotesCount();
+    }
+}
+
 void NoteModel::findNoteToRestoreFailedUpdate(const Note & note)
 {
     NMDEBUG(
@@ -2392,11 +2925,18 @@ void NoteModel::clearModel()
     m_data.clear();
     m_totalFilteredNotesCount = 0;
     m_maxNoteCount = NOTE_MIN_CACHE_SIZE * 2;
+    m_targetLoadedNoteCount = NOTE_MIN_CACHE_SIZE;
+    m_listNotesQueryLimit = NOTE_LIST_QUERY_MIN_LIMIT;
+    m_listNotesRoundTripCount = 0;
+    m_fetchMoreTimer.invalidate();
     m_listNotesOffset = 0;
     m_listNotesRequestId = QUuid();
     m_getNoteCountRequestId = QUuid();
     m_totalAccountNotesCount = 0;
     m_getFullNoteCountPerAccountRequestId = QUuid();
+    m_noteCountsRefreshTimer.stop();
+    m_noteCountPerAccountRefreshPending = false;
+    m_filteredNotesCountRefreshPending = false;
     m_notebookDataByNotebookLocalUid.clear();
     m_findNotebookRequestForNotebookLocalUid.clear();
     m_localUidsOfNewNotesBeingAddedToLocalStorage.clear();
@@ -2409,11 +2949,88 @@ void NoteModel::clearModel()
     m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.clear();
     m_tagDataByTagLocalUid.clear();
     m_findTagRequestForTagLocalUid.clear();
-    m_tagLocalUidToNoteLocalUid.clear();
+    m_listTagsRequestId = QUuid();
+    m_allTagsListed = false;
+    m_noteLocalUidsByTagLocalUid.clear();
+    m_previewTextRequestIdByNoteLocalUid.clear();
+    m_stringPool.clear();
+    m_thumbnailCache.clear();
 
     endResetModel();
 }
 
+bool NoteModel::allNotesLoaded() const
+{
+    if ((m_getNoteCountRequestId != QUuid()) ||
+        (m_listNotesRequestId != QUuid()))
+    {
+        return false;
+    }
+
+    return m_data.size() >= static_cast<size_t>(m_totalFilteredNotesCount);
+}
+
+void NoteModel::sortLoadedNoteItems()
+{
+    NMDEBUG("NoteModel::sortLoadedNoteItems");
+
+    Q_EMIT layoutAboutToBeChanged();
+
+    auto & index = m_data.get<ByIndex>();
+
+    auto persistentIndices = persistentIndexList();
+    QVector<std::pair<QString, int>> localUidsToUpdateWithColumns;
+    localUidsToUpdateWithColumns.reserve(persistentIndices.size());
+
+    for (const auto & modelIndex: qAsConst(persistentIndices)) {
+        int row = modelIndex.row();
+        if (!modelIndex.isValid() || (row < 0) ||
+            (row >= static_cast<int>(index.size())))
+        {
+            localUidsToUpdateWithColumns
+                << std::pair<QString, int>(QString(), modelIndex.column());
+            continue;
+        }
+
+        const auto & item = index[static_cast<size_t>(row)];
+
+        localUidsToUpdateWithColumns
+            << std::make_pair(item.localUid(), modelIndex.column());
+    }
+
+    std::vector<boost::reference_wrapper<const NoteModelItem>> items(
+        index.begin(), index.end());
+
+    std::stable_sort(
+        items.begin(), items.end(),
+        NoteComparator(sortingColumn(), sortOrder()));
+
+    index.rearrange(items.begin());
+
+    QModelIndexList replacementIndices;
+    replacementIndices.reserve(localUidsToUpdateWithColumns.size());
+
+    for (const auto & pair: qAsConst(localUidsToUpdateWithColumns)) {
+        const QString & localUid = pair.first;
+        if (localUid.isEmpty()) {
+            replacementIndices << QModelIndex();
+            continue;
+        }
+
+        auto newIndex = indexForLocalUid(localUid);
+        if (!newIndex.isValid()) {
+            replacementIndices << QModelIndex();
+            continue;
+        }
+
+        replacementIndices << createIndex(newIndex.row(), pair.second);
+    }
+
+    changePersistentIndexList(persistentIndices, replacementIndices);
+
+    Q_EMIT layoutChanged();
+}
+
 void NoteModel::resetModel()
 {
     NMDEBUG("NoteModel::resetModel");
@@ -2475,35 +3092,27 @@ void NoteModel::processTagExpunging(const QString & tagLocalUid)
 
     Q_UNUSED(m_tagDataByTagLocalUid.erase(tagDataIt))
 
-    auto noteIt = m_tagLocalUidToNoteLocalUid.find(tagLocalUid);
-    if (noteIt == m_tagLocalUidToNoteLocalUid.end()) {
+    auto noteIt = m_noteLocalUidsByTagLocalUid.find(tagLocalUid);
+    if (noteIt == m_noteLocalUidsByTagLocalUid.end()) {
         return;
     }
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
 
-    QStringList affectedNotesLocalUids;
-    while (noteIt != m_tagLocalUidToNoteLocalUid.end()) {
-        if (noteIt.key() != tagLocalUid) {
-            break;
-        }
-
-        affectedNotesLocalUids << noteIt.value();
-        ++noteIt;
-    }
-
-    Q_UNUSED(m_tagLocalUidToNoteLocalUid.remove(tagLocalUid))
+    const QSet<QString> affectedNotesLocalUids = noteIt.value();
+    Q_UNUSED(m_noteLocalUidsByTagLocalUid.erase(noteIt))
 
     NMTRACE(
         "Affected notes local uids: "
-        << affectedNotesLocalUids.join(QStringLiteral(", ")));
+        << QStringList(affectedNotesLocalUids.values())
+               .join(QStringLiteral(", ")));
 
     for (const auto & noteLocalUid: qAsConst(affectedNotesLocalUids)) {
         auto noteItemIt = localUidIndex.find(noteLocalUid);
         if (Q_UNLIKELY(noteItemIt == localUidIndex.end())) {
             NMDEBUG(
                 "Can't find the note pointed to by the expunged "
-                << "tag by local uid: note local uid = " << noteIt.value());
+                << "tag by local uid: note local uid = " << noteLocalUid);
             continue;
         }
 
@@ -2754,9 +3363,13 @@ QVariant NoteModel::dataImpl(const int row, const Columns::type column) const
         return item.previewText();
     case Columns::ThumbnailImage:
     {
-        QImage thumbnail;
-        Q_UNUSED(thumbnail.loadFromData(item.thumbnailData(), "PNG"))
-        return thumbnail;
+        // If the thumbnail is not decoded yet, the decoding is started
+        // in background and dataChanged is emitted once it's finished
+        const auto * pThumbnail = m_thumbnailCache.thumbnail(
+            item.localUid(), item.thumbnailDataHash(), item.thumbnailData(),
+            QSize());
+
+        return (pThumbnail ? QVariant::fromValue(*pThumbnail) : QVariant());
     }
     case Columns::NotebookName:
         return item.notebookName();
@@ -2940,6 +3553,7 @@ bool NoteModel::setDataImpl(
         QString title = value.toString();
         dirty |= (title != item.title());
         item.setTitle(title);
+        updateTitleSortKey(item);
         break;
     }
     case Columns::Synchronizable:
@@ -3564,49 +4178,186 @@ void NoteModel::checkMaxNoteCountAndRemoveLastNoteIfNeeded()
 void NoteModel::checkAddedNoteItemsPendingNotebookData(
     const QString & notebookLocalUid, const NotebookData & notebookData)
 {
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    std::vector<NoteModelItem> newItems;
+
     auto it = m_noteItemsPendingNotebookDataUpdate.find(notebookLocalUid);
     while (it != m_noteItemsPendingNotebookDataUpdate.end()) {
         if (it.key() != notebookLocalUid) {
             break;
         }
 
-        addOrUpdateNoteItem(it.value(), notebookData, true);
+        auto & item = it.value();
+        if (localUidIndex.find(item.localUid()) != localUidIndex.end()) {
+            addOrUpdateNoteItem(item, notebookData, true);
+        }
+        else {
+            item.setNotebookName(notebookData.m_name);
+            newItems.push_back(item);
+        }
+
         it = m_noteItemsPendingNotebookDataUpdate.erase(it);
     }
+
+    addNoteItemsFromListing(std::move(newItems));
 }
 
-void NoteModel::findTagNamesForItem(NoteModelItem & item)
+void NoteModel::addNoteItemsFromListing(std::vector<NoteModelItem> items)
 {
-    NMTRACE("NoteModel::findTagNamesForItem: " << item);
+    NMTRACE("NoteModel::addNoteItemsFromListing: " << items.size() << " items");
 
-    const auto & tagLocalUids = item.tagLocalUids();
-    for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
-        bool alreadyGotNoteLocalUidMapped = false;
+    QSet<QString> localUids;
+    localUids.reserve(static_cast<int>(items.size()));
 
-        auto tagToNoteIt = m_tagLocalUidToNoteLocalUid.find(tagLocalUid);
-        while (tagToNoteIt != m_tagLocalUidToNoteLocalUid.end()) {
-            if (tagToNoteIt.key() != tagLocalUid) {
-                break;
+    auto removeIt = std::remove_if(
+        items.begin(), items.end(), [&](const NoteModelItem & item) {
+            if (!noteItemConformsToIncludedNotes(item)) {
+                return true;
             }
 
-            if (tagToNoteIt.value() == item.localUid()) {
-                alreadyGotNoteLocalUidMapped = true;
-                break;
+            if (localUids.contains(item.localUid())) {
+                return true;
             }
 
-            ++tagToNoteIt;
-        }
+            Q_UNUSED(localUids.insert(item.localUid()))
+            return false;
+        });
+
+    items.erase(removeIt, items.end());
+    if (items.empty()) {
+        return;
+    }
 
-        if (!alreadyGotNoteLocalUidMapped) {
-            Q_UNUSED(m_tagLocalUidToNoteLocalUid.insert(
-                tagLocalUid, item.localUid()))
+    QElapsedTimer timer;
+    timer.start();
 
+    NoteComparator comparator(sortingColumn(), sortOrder());
+    std::stable_sort(items.begin(), items.end(), comparator);
+
+    auto & index = m_data.get<ByIndex>();
+
+    /**
+     * Both the existing rows and the new items are sorted so the rows before
+     * which the new items need to be inserted are non-decreasing; the new items
+     * landing at the same row form a contiguous range of rows to insert
+     */
+    struct InsertionRange
+    {
+        int m_row = 0;
+        size_t m_itemsBegin = 0;
+        size_t m_itemsEnd = 0;
+    };
+
+    std::vector<InsertionRange> insertionRanges;
+
+    auto searchBeginIt = index.begin();
+    size_t numItemsToInsert = 0;
+    for (size_t i = 0, size = items.size(); i < size; ++i) {
+        auto positionIt = std::lower_bound(
+            searchBeginIt, index.end(), items[i], comparator);
+
+        searchBeginIt = positionIt;
+
+        int row = static_cast<int>(std::distance(index.begin(), positionIt));
+        if (static_cast<size_t>(row) + i >= m_maxNoteCount) {
             NMDEBUG(
-                "Tag local uid " << tagLocalUid << " points to note model item "
-                                 << item.localUid()
-                                 << ", title = " << item.title());
+                "Skip adding " << (size - i) << " notes: their rows would "
+                               << "be larger than or equal to the max note "
+                               << "count " << m_maxNoteCount);
+            break;
+        }
+
+        if (insertionRanges.empty() || (insertionRanges.back().m_row != row)) {
+            InsertionRange range;
+            range.m_row = row;
+            range.m_itemsBegin = i;
+            insertionRanges.push_back(range);
         }
 
+        insertionRanges.back().m_itemsEnd = i + 1;
+        ++numItemsToInsert;
+    }
+
+    if (insertionRanges.empty()) {
+        return;
+    }
+
+    items.erase(
+        items.begin() + static_cast<std::ptrdiff_t>(numItemsToInsert),
+        items.end());
+
+    /**
+     * All the new items to be inserted land within the max note count so if
+     * the total number of rows exceeds it, the excess rows are the last
+     * existing ones; they are removed before the insertion at once
+     */
+    size_t numRows = index.size() + numItemsToInsert;
+    if (numRows > m_maxNoteCount) {
+        int lastRow = static_cast<int>(index.size()) - 1;
+        int firstRow = lastRow - static_cast<int>(numRows - m_maxNoteCount) + 1;
+
+        NMDEBUG(
+            "Removing rows [" << firstRow << ", " << lastRow
+                              << "] to keep the note model within the max "
+                              << "note count");
+
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+        Q_UNUSED(index.erase(index.begin() + firstRow, index.end()))
+        endRemoveRows();
+    }
+
+    for (auto & item: items) {
+        findTagNamesForItem(item);
+    }
+
+    // Inserting from the last range to the first one so that the rows of
+    // the ranges which are not yet inserted don't change
+    for (auto it = insertionRanges.rbegin(), end = insertionRanges.rend();
+         it != end; ++it)
+    {
+        const auto & range = *it;
+        int count = static_cast<int>(range.m_itemsEnd - range.m_itemsBegin);
+
+        NMTRACE("Inserting " << count << " new items at row " << range.m_row);
+
+        beginInsertRows(QModelIndex(), range.m_row, range.m_row + count - 1);
+
+        index.insert(
+            index.begin() + range.m_row,
+            items.begin() + static_cast<std::ptrdiff_t>(range.m_itemsBegin),
+            items.begin() + static_cast<std::ptrdiff_t>(range.m_itemsEnd));
+
+        endInsertRows();
+    }
+
+    NMDEBUG(
+        "Added " << numItemsToInsert << " note items using "
+                 << insertionRanges.size() << " rows insertion signals within "
+                 << timer.elapsed() << " msec");
+}
+
+bool NoteModel::noteItemConformsToIncludedNotes(
+    const NoteModelItem & item) const
+{
+    switch (m_includedNotes) {
+    case IncludedNotes::Deleted:
+        return item.deletionTimestamp() >= 0;
+    case IncludedNotes::NonDeleted:
+        return item.deletionTimestamp() < 0;
+    default:
+        return true;
+    }
+}
+
+void NoteModel::findTagNamesForItem(NoteModelItem & item)
+{
+    NMTRACE("NoteModel::findTagNamesForItem: " << item);
+
+    const auto & tagLocalUids = item.tagLocalUids();
+    for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
+        Q_UNUSED(
+            m_noteLocalUidsByTagLocalUid[tagLocalUid].insert(item.localUid()))
+
         auto tagDataIt = m_tagDataByTagLocalUid.find(tagLocalUid);
         if (tagDataIt != m_tagDataByTagLocalUid.end()) {
             NMTRACE(
@@ -3619,27 +4370,84 @@ void NoteModel::findTagNamesForItem(NoteModelItem & item)
         NMTRACE(
             "Tag data for tag local uid " << tagLocalUid << " was not found");
 
-        auto requestIt = m_findTagRequestForTagLocalUid.left.find(tagLocalUid);
-        if (requestIt != m_findTagRequestForTagLocalUid.left.end()) {
-            NMTRACE(
-                "The request to find tag corresponding to local uid "
-                << tagLocalUid << " has already been sent: request id = "
-                << requestIt->second);
+        if (!m_allTagsListed) {
+            // All tags are listed within a single request; the tag would be
+            // searched for individually only if the listing doesn't find it
+            if (m_listTagsRequestId.isNull()) {
+                requestTagsList();
+            }
+
             continue;
         }
 
-        auto requestId = QUuid::createUuid();
-        Q_UNUSED(m_findTagRequestForTagLocalUid.insert(
-            LocalUidToRequestIdBimap::value_type(tagLocalUid, requestId)))
+        requestTag(tagLocalUid);
+    }
+}
 
-        Tag tag;
-        tag.setLocalUid(tagLocalUid);
+void NoteModel::requestTag(const QString & tagLocalUid)
+{
+    auto requestIt = m_findTagRequestForTagLocalUid.left.find(tagLocalUid);
+    if (requestIt != m_findTagRequestForTagLocalUid.left.end()) {
+        NMTRACE(
+            "The request to find tag corresponding to local uid "
+            << tagLocalUid << " has already been sent: request id = "
+            << requestIt->second);
+        return;
+    }
 
-        NMDEBUG(
-            "Emitting the request to find tag: tag local uid = "
-            << tagLocalUid << ", request id = " << requestId);
+    auto requestId = QUuid::createUuid();
+    Q_UNUSED(m_findTagRequestForTagLocalUid.insert(
+        LocalUidToRequestIdBimap::value_type(tagLocalUid, requestId)))
+
+    Tag tag;
+    tag.setLocalUid(tagLocalUid);
+
+    NMDEBUG(
+        "Emitting the request to find tag: tag local uid = "
+        << tagLocalUid << ", request id = " << requestId);
+
+    Q_EMIT findTag(tag, requestId);
+}
+
+void NoteModel::requestTagsList()
+{
+    NMTRACE("NoteModel::requestTagsList");
+
+    LocalStorageManager::ListObjectsOptions flags =
+        LocalStorageManager::ListObjectsOption::ListAll;
+
+    auto order = LocalStorageManager::ListTagsOrder::NoOrder;
+    auto direction = LocalStorageManager::OrderDirection::Ascending;
+
+    m_listTagsRequestId = QUuid::createUuid();
+
+    NMDEBUG(
+        "Emitting the request to list all tags: request id = "
+        << m_listTagsRequestId);
+
+    // NOTE: zero limit means listing all tags at once
+    Q_EMIT listTags(flags, 0, 0, order, direction, {}, m_listTagsRequestId);
+}
 
-        Q_EMIT findTag(tag, requestId);
+void NoteModel::findTagsNotFoundByListing()
+{
+    NMTRACE("NoteModel::findTagsNotFoundByListing");
+
+    // The tags referenced by notes but not found by the listing might have
+    // been added after the listing was done; such tags are searched for
+    // individually
+    QStringList tagLocalUids;
+    for (auto it = m_noteLocalUidsByTagLocalUid.constBegin(),
+              end = m_noteLocalUidsByTagLocalUid.constEnd();
+         it != end; ++it)
+    {
+        if (!m_tagDataByTagLocalUid.contains(it.key())) {
+            tagLocalUids << it.key();
+        }
+    }
+
+    for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
+        requestTag(tagLocalUid);
     }
 }
 
@@ -3647,47 +4455,44 @@ void NoteModel::updateTagData(const Tag & tag)
 {
     NMTRACE("NoteModel::updateTagData: tag local uid = " << tag.localUid());
 
-    bool hasName = tag.hasName();
-    bool hasGuid = tag.hasGuid();
+    setTagData(tag);
+
+    auto noteIt = m_noteLocalUidsByTagLocalUid.find(tag.localUid());
+    if (noteIt == m_noteLocalUidsByTagLocalUid.end()) {
+        return;
+    }
+
+    updateTagNamesForNotes(noteIt.value());
+}
 
+void NoteModel::setTagData(const Tag & tag)
+{
     auto & tagData = m_tagDataByTagLocalUid[tag.localUid()];
 
-    if (hasName) {
+    if (tag.hasName()) {
         tagData.m_name = tag.name();
     }
     else {
         tagData.m_name.resize(0);
     }
 
-    if (hasGuid) {
+    if (tag.hasGuid()) {
         tagData.m_guid = tag.guid();
     }
     else {
         tagData.m_guid.resize(0);
     }
+}
 
-    auto noteIt = m_tagLocalUidToNoteLocalUid.find(tag.localUid());
-    if (noteIt == m_tagLocalUidToNoteLocalUid.end()) {
-        return;
-    }
+void NoteModel::updateTagNamesForNotes(const QSet<QString> & noteLocalUids)
+{
+    NMTRACE(
+        "NoteModel::updateTagNamesForNotes: "
+        << QStringList(noteLocalUids.values()).join(QStringLiteral(", ")));
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
 
-    QStringList affectedNotesLocalUids;
-    while (noteIt != m_tagLocalUidToNoteLocalUid.end()) {
-        if (noteIt.key() != tag.localUid()) {
-            break;
-        }
-
-        affectedNotesLocalUids << noteIt.value();
-        ++noteIt;
-    }
-
-    NMTRACE(
-        "Affected notes local uids: "
-        << affectedNotesLocalUids.join(QStringLiteral(", ")));
-
-    for (const auto & noteLocalUid: qAsConst(affectedNotesLocalUids)) {
+    for (const auto & noteLocalUid: noteLocalUids) {
         auto noteItemIt = localUidIndex.find(noteLocalUid);
         if (Q_UNLIKELY(noteItemIt == localUidIndex.end())) {
             NMDEBUG(
@@ -3805,6 +4610,24 @@ void NoteModel::NoteFilters::clearFilteredNoteLocalUids()
     m_filteredNoteLocalUids.clear();
 }
 
+int NoteModel::NoteComparator::compareTitlesOrPreviewTexts(
+    const NoteModelItem & lhs, const NoteModelItem & rhs) const
+{
+    const auto * pLeftSortKey = lhs.titleSortKey();
+    const auto * pRightSortKey = rhs.titleSortKey();
+    if (Q_LIKELY(pLeftSortKey && pRightSortKey)) {
+        return pLeftSortKey->compare(*pRightSortKey);
+    }
+
+    const QString & leftTitleOrPreview =
+        (lhs.title().isEmpty() ? lhs.previewText() : lhs.title());
+
+    const QString & rightTitleOrPreview =
+        (rhs.title().isEmpty() ? rhs.previewText() : rhs.title());
+
+    return leftTitleOrPreview.localeAwareCompare(rightTitleOrPreview);
+}
+
 bool NoteModel::NoteComparator::operator()(
     const NoteModelItem & lhs, const NoteModelItem & rhs) const
 {
@@ -3825,37 +4648,9 @@ bool NoteModel::NoteComparator::operator()(
         greater = (lhs.deletionTimestamp() > rhs.deletionTimestamp());
         break;
     case Columns::Title:
-    {
-        QString leftTitleOrPreview = lhs.title();
-        if (leftTitleOrPreview.isEmpty()) {
-            leftTitleOrPreview = lhs.previewText();
-        }
-
-        QString rightTitleOrPreview = rhs.title();
-        if (rightTitleOrPreview.isEmpty()) {
-            rightTitleOrPreview = rhs.previewText();
-        }
-
-        int compareResult =
-            leftTitleOrPreview.localeAwareCompare(rightTitleOrPreview);
-        less = (compareResult < 0);
-        greater = (compareResult > 0);
-        break;
-    }
     case Columns::PreviewText:
     {
-        QString leftTitleOrPreview = lhs.title();
-        if (leftTitleOrPreview.isEmpty()) {
-            leftTitleOrPreview = lhs.previewText();
-        }
-
-        QString rightTitleOrPreview = rhs.title();
-        if (rightTitleOrPreview.isEmpty()) {
-            rightTitleOrPreview = rhs.previewText();
-        }
-
-        int compareResult =
-            leftTitleOrPreview.localeAwareCompare(rightTitleOrPreview);
+        int compareResult = compareTitlesOrPreviewTexts(lhs, rhs);
         less = (compareResult < 0);
         greater = (compareResult > 0);
         break;
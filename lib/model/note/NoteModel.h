@@ -21,7 +21,9 @@
 
 #include "NoteCache.h"
 #include "NoteModelItem.h"
+#include "NoteThumbnailCache.h"
 
+#include <lib/model/common/StringPool.h>
 #include <lib/model/notebook/NotebookCache.h>
 #include <lib/utility/IStartable.h>
 
@@ -30,6 +32,10 @@
 #include <quentier/utility/SuppressWarnings.h>
 
 #include <QAbstractItemModel>
+#include <QBasicTimer>
+#include <QCollator>
+#include <QElapsedTimer>
+#include <QHash>
 
 SAVE_WARNINGS
 
@@ -46,6 +52,7 @@ RESTORE_WARNINGS
 #include <boost/multi_index_container.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace quentier {
 
@@ -155,6 +162,12 @@ public:
     const NoteModelItem * itemAtRow(const int row) const;
     const NoteModelItem * itemForIndex(const QModelIndex & index) const;
 
+    /**
+     * @brief thumbnailCache - the cache of decoded note thumbnails shared
+     * between the note model and the delegates painting its items
+     */
+    NoteThumbnailCache & thumbnailCache() const;
+
 public:
     // Note filtering API
 
@@ -189,6 +202,19 @@ public:
      */
     qint32 totalAccountNotesCount() const;
 
+    /**
+     * @brief Number of list notes requests to the local storage completed
+     * since the last reset of the model
+     */
+    size_t listNotesRoundTripCount() const;
+
+    /**
+     * @brief Time in milliseconds between the start of notes listing and
+     * the emission of minimalNotesBatchLoaded signal; -1 if the first batch of
+     * notes has not been loaded yet
+     */
+    qint64 timeToFirstScreenMsec() const;
+
 public:
     /**
      * @brief createNoteItem - attempts to create a new note within the notebook
@@ -425,6 +451,12 @@ Q_SIGNALS:
     void findNotebook(Notebook notebook, QUuid requestId);
     void findTag(Tag tag, QUuid requestId);
 
+    void listTags(
+        LocalStorageManager::ListObjectsOptions flag, size_t limit,
+        size_t offset, LocalStorageManager::ListTagsOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QString linkedNotebookGuid, QUuid requestId);
+
 private Q_SLOTS:
     // Slots for response to events from local storage
     void onAddNoteComplete(Note note, QUuid requestId);
@@ -529,12 +561,30 @@ private Q_SLOTS:
     void onFindTagFailed(
         Tag tag, ErrorString errorDescription, QUuid requestId);
 
+    void onListTagsComplete(
+        LocalStorageManager::ListObjectsOptions flag, size_t limit,
+        size_t offset, LocalStorageManager::ListTagsOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QString linkedNotebookGuid, QList<Tag> tags, QUuid requestId);
+
+    void onListTagsFailed(
+        LocalStorageManager::ListObjectsOptions flag, size_t limit,
+        size_t offset, LocalStorageManager::ListTagsOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QString linkedNotebookGuid, ErrorString errorDescription,
+        QUuid requestId);
+
     void onAddTagComplete(Tag tag, QUuid requestId);
     void onUpdateTagComplete(Tag tag, QUuid requestId);
 
     void onExpungeTagComplete(
         Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId);
 
+    void onThumbnailReady(QString noteLocalUid);
+
+    void onPreviewTextExtracted(
+        QString noteLocalUid, quint64 requestId, QString previewText);
+
 private:
     void connectToLocalStorage();
     void disconnectFromLocalStorage();
@@ -543,20 +593,90 @@ private:
         const Note & note, const bool fromNotesListing = false);
 
     void noteToItem(const Note & note, NoteModelItem & item);
+    void updateTitleSortKey(NoteModelItem & item) const;
+
+    /**
+     * @brief requestPreviewText - starts the extraction of the preview text
+     * from note's content in background; once extracted, the preview text is
+     * set to the note's item if the note is still within the model and its
+     * content hasn't changed since the request
+     */
+    void requestPreviewText(
+        const QString & noteLocalUid, const QString & noteContent);
     bool noteConformsToFilter(const Note & note) const;
-    void onListNotesCompleteImpl(const QList<Note> foundNotes);
+    void onListNotesCompleteImpl(
+        const size_t limit, const QList<Note> foundNotes);
+
+    /**
+     * @brief onListNotesRequestCompleted - updates the listing offset and
+     * adapts the limit for further list notes requests to the duration of
+     * the completed one
+     */
+    void onListNotesRequestCompleted(
+        const size_t limit, const int numFoundNotes);
 
     void requestNotesListAndCount();
-    void requestNotesList();
+
+    /**
+     * @brief requestNotesList - requests the next page of notes from the local
+     * storage
+     * @param numPendingItems       The number of listed notes not yet added
+     *                              to the model
+     */
+    void requestNotesList(const size_t numPendingItems = 0);
     void requestNotesCount();
     void requestTotalNotesCountPerAccount();
     void requestTotalFilteredNotesCount();
 
+    /**
+     * @brief updateNoteCounts - applies the known change of note counts
+     * incrementally or, if a count is being requested at the moment,
+     * schedules its refresh
+     */
+    void updateNoteCounts(
+        const qint32 delta, const bool affectsFilteredNotesCount);
+
+    /**
+     * @brief scheduleNoteCountsRefresh - schedules the requests of note counts
+     * from the local storage; requests scheduled within a short interval are
+     * merged into one
+     */
+    void scheduleNoteCountsRefresh(
+        const bool noteCountPerAccount = true,
+        const bool filteredNotesCount = true);
+
+    /**
+     * @brief noteInclusionMightHaveChanged - checks whether the update of
+     * the note not loaded into the model could have changed whether the note
+     * is included into the model i.e. whether its deletion state, notebook
+     * or tags have changed; if the previous state of the note is unknown,
+     * the inclusion is considered to have possibly changed
+     */
+    bool noteInclusionMightHaveChanged(
+        const Note & note,
+        const LocalStorageManager::UpdateNoteOptions options) const;
+
+    virtual void timerEvent(QTimerEvent * pEvent) override;
+
     void findNoteToRestoreFailedUpdate(const Note & note);
 
     void clearModel();
     void resetModel();
 
+    /**
+     * @return              True if all notes conforming to the current filters
+     *                      are loaded into the model and no listing or note
+     *                      count requests are pending, false otherwise
+     */
+    bool allNotesLoaded() const;
+
+    /**
+     * @brief sortLoadedNoteItems - sorts the loaded note items in memory
+     * according to the current sorting column and order, without re-listing
+     * the notes from the local storage
+     */
+    void sortLoadedNoteItems();
+
     LocalStorageManager::NoteCountOptions noteCountOptions() const;
 
     /**
@@ -608,19 +728,32 @@ private:
     struct ByNotebookLocalUid
     {};
 
+    struct StringHash
+    {
+        std::size_t operator()(const QString & str) const
+        {
+            return qHash(str);
+        }
+    };
+
+    // NOTE: local uids are looked up by hash rather than by ordered
+    // comparisons of UUID-length strings as lookups by local uid are
+    // very frequent and the order of local uids is never used
     using NoteData = boost::multi_index_container<
         NoteModelItem,
         boost::multi_index::indexed_by<
             boost::multi_index::random_access<boost::multi_index::tag<ByIndex>>,
-            boost::multi_index::ordered_unique<
+            boost::multi_index::hashed_unique<
                 boost::multi_index::tag<ByLocalUid>,
                 boost::multi_index::const_mem_fun<
-                    NoteModelItem, const QString &, &NoteModelItem::localUid>>,
-            boost::multi_index::ordered_non_unique<
+                    NoteModelItem, const QString &, &NoteModelItem::localUid>,
+                StringHash>,
+            boost::multi_index::hashed_non_unique<
                 boost::multi_index::tag<ByNotebookLocalUid>,
                 boost::multi_index::const_mem_fun<
                     NoteModelItem, const QString &,
-                    &NoteModelItem::notebookLocalUid>>>>;
+                    &NoteModelItem::notebookLocalUid>,
+                StringHash>>>;
 
     using NoteDataByIndex = NoteData::index<ByIndex>::type;
     using NoteDataByLocalUid = NoteData::index<ByLocalUid>::type;
@@ -640,6 +773,10 @@ private:
         bool operator()(
             const NoteModelItem & lhs, const NoteModelItem & rhs) const;
 
+    private:
+        int compareTitlesOrPreviewTexts(
+            const NoteModelItem & lhs, const NoteModelItem & rhs) const;
+
     private:
         Columns::type m_sortedColumn;
         Qt::SortOrder m_sortOrder;
@@ -671,6 +808,28 @@ private:
         NoteModelItem & item, const NotebookData & notebookData,
         const bool fromNotesListing);
 
+    /**
+     * @brief addNoteItemsFromListing - inserts a batch of new note items
+     * (i.e. those not yet present within the model) at once: the batch is
+     * sorted once according to the current sorting criteria and then merged
+     * into the model, with a single rows insertion signal per each contiguous
+     * range of new rows
+     *
+     * @param items         New note items with notebook names already set
+     */
+    void addNoteItemsFromListing(std::vector<NoteModelItem> items);
+
+    /**
+     * @return              Pointer to the notebook data corresponding to
+     *                      the note item or nullptr if there's no such data
+     *                      yet; in the latter case the item is put aside until
+     *                      the notebook is found within the local storage
+     */
+    const NotebookData * findNotebookDataForNoteItem(
+        const Note & note, const NoteModelItem & item);
+
+    bool noteItemConformsToIncludedNotes(const NoteModelItem & item) const;
+
     void checkMaxNoteCountAndRemoveLastNoteIfNeeded();
 
     void checkAddedNoteItemsPendingNotebookData(
@@ -678,7 +837,19 @@ private:
 
     void findTagNamesForItem(NoteModelItem & item);
 
+    /**
+     * @brief requestTagsList - requests all tags from the local storage
+     * within a single request so that the names of tags referenced by notes
+     * don't need to be found one by one
+     */
+    void requestTagsList();
+    void requestTag(const QString & tagLocalUid);
+
+    void findTagsNotFoundByListing();
+
     void updateTagData(const Tag & tag);
+    void setTagData(const Tag & tag);
+    void updateTagNamesForNotes(const QSet<QString> & noteLocalUids);
 
 private:
     Account m_account;
@@ -693,7 +864,14 @@ private:
     NoteData m_data;
     qint32 m_totalFilteredNotesCount = 0;
 
+    // Used to compute the sort keys for note items' titles
+    QCollator m_collator;
+
     NoteCache & m_cache;
+
+    // Mutable because thumbnails are decoded and cached on demand from const
+    // methods
+    mutable NoteThumbnailCache m_thumbnailCache;
     NotebookCache & m_notebookCache;
 
     std::unique_ptr<NoteFilters> m_pFilters;
@@ -703,13 +881,31 @@ private:
     // Can be increased through calls to fetchMore()
     size_t m_maxNoteCount;
 
+    // The number of notes which the model is loading without waiting for
+    // further fetchMore() calls
+    size_t m_targetLoadedNoteCount;
+
+    // The limit for list notes requests adapted to their durations and
+    // to the pace of fetchMore() calls
+    size_t m_listNotesQueryLimit;
+
     size_t m_listNotesOffset = 0;
     QUuid m_listNotesRequestId;
+    QElapsedTimer m_listNotesTimer;
+    QElapsedTimer m_fetchMoreTimer;
+
+    size_t m_listNotesRoundTripCount = 0;
+    QElapsedTimer m_firstScreenTimer;
+    qint64 m_timeToFirstScreenMsec = -1;
     QUuid m_getNoteCountRequestId;
 
     qint32 m_totalAccountNotesCount = 0;
     QUuid m_getFullNoteCountPerAccountRequestId;
 
+    QBasicTimer m_noteCountsRefreshTimer;
+    bool m_noteCountPerAccountRefreshPending = false;
+    bool m_filteredNotesCountRefreshPending = false;
+
     QHash<QString, NotebookData> m_notebookDataByNotebookLocalUid;
     LocalUidToRequestIdBimap m_findNotebookRequestForNotebookLocalUid;
 
@@ -731,7 +927,18 @@ private:
     QHash<QString, TagData> m_tagDataByTagLocalUid;
 
     LocalUidToRequestIdBimap m_findTagRequestForTagLocalUid;
-    QMultiHash<QString, QString> m_tagLocalUidToNoteLocalUid;
+
+    QUuid m_listTagsRequestId;
+    bool m_allTagsListed = false;
+
+    // Local uids of notes referencing each tag
+    QHash<QString, QSet<QString>> m_noteLocalUidsByTagLocalUid;
+
+    // Interns notebook and tag local uids and guids shared by note items
+    StringPool m_stringPool;
+
+    quint64 m_lastPreviewTextRequestId = 0;
+    QHash<QString, quint64> m_previewTextRequestIdByNoteLocalUid;
 };
 
 } // namespace quentier
@@ -22,14 +22,23 @@
 #include <quentier/utility/Printable.h>
 
 #include <QByteArray>
+#include <QCollatorSortKey>
+#include <QHash>
 #include <QStringList>
 
+#include <memory>
+
 namespace quentier {
 
 class NoteModelItem final : public Printable
 {
 public:
-    NoteModelItem() = default;
+    NoteModelItem() :
+        m_isSynchronizable(false), m_isDirty(true), m_isFavorited(false),
+        m_isActive(true), m_hasResources(false), m_canUpdateTitle(true),
+        m_canUpdateContent(true), m_canEmail(true), m_canShare(true),
+        m_canSharePublicly(true)
+    {}
 
     virtual ~NoteModelItem() override = default;
 
@@ -93,6 +102,28 @@ public:
         m_previewText = std::move(previewText);
     }
 
+    /**
+     * @brief titleSortKey - collation sort key for note's title or, if
+     * the title is empty, for note's preview text
+     *
+     * The key is computed by NoteModel once per title/preview text change
+     * so that sorting by title doesn't need locale aware comparison
+     * of strings on each comparison
+     *
+     * @return                  Pointer to the sort key or nullptr if it was
+     *                          not computed
+     */
+    const QCollatorSortKey * titleSortKey() const
+    {
+        return m_pTitleSortKey.get();
+    }
+
+    void setTitleSortKey(QCollatorSortKey titleSortKey)
+    {
+        m_pTitleSortKey =
+            std::make_shared<const QCollatorSortKey>(std::move(titleSortKey));
+    }
+
     const QByteArray & thumbnailData() const
     {
         return m_thumbnailData;
@@ -101,6 +132,17 @@ public:
     void setThumbnailData(QByteArray thumbnailData)
     {
         m_thumbnailData = std::move(thumbnailData);
+        m_thumbnailDataHash = qHash(m_thumbnailData);
+    }
+
+    /**
+     * @brief thumbnailDataHash - hash of note's thumbnail data computed once
+     * per thumbnail data change, identifies the content of decoded thumbnails
+     * within NoteThumbnailCache
+     */
+    uint thumbnailDataHash() const
+    {
+        return m_thumbnailDataHash;
     }
 
     const QString & notebookName() const
@@ -316,7 +358,9 @@ private:
     QString m_notebookGuid;
     QString m_title;
     QString m_previewText;
+    std::shared_ptr<const QCollatorSortKey> m_pTitleSortKey;
     QByteArray m_thumbnailData;
+    uint m_thumbnailDataHash = 0;
     QString m_notebookName;
     QStringList m_tagLocalUids;
     QStringList m_tagGuids;
@@ -327,16 +371,17 @@ private:
     qint64 m_deletionTimestamp = -1;
     quint64 m_sizeInBytes = 0;
 
-    bool m_isSynchronizable = false;
-    bool m_isDirty = true;
-    bool m_isFavorited = false;
-    bool m_isActive = true;
-    bool m_hasResources = false;
-    bool m_canUpdateTitle = true;
-    bool m_canUpdateContent = true;
-    bool m_canEmail = true;
-    bool m_canShare = true;
-    bool m_canSharePublicly = true;
+    // Flags are packed into bit fields as the model might hold a lot of items
+    bool m_isSynchronizable : 1;
+    bool m_isDirty : 1;
+    bool m_isFavorited : 1;
+    bool m_isActive : 1;
+    bool m_hasResources : 1;
+    bool m_canUpdateTitle : 1;
+    bool m_canUpdateContent : 1;
+    bool m_canEmail : 1;
+    bool m_canShare : 1;
+    bool m_canSharePublicly : 1;
 };
 
 } // namespace quentier
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotePreviewTextExtractor.h"
+
+#include <quentier/logging/QuentierLogger.h>
+
+#include <QXmlStreamReader>
+
+namespace quentier {
+
+NotePreviewTextExtractor::NotePreviewTextExtractor(
+    const QString & noteLocalUid, const quint64 requestId,
+    const QString & noteContent, const int maxPreviewTextSize,
+    QObject * parent) :
+    QObject(parent),
+    QRunnable(), m_noteLocalUid(noteLocalUid), m_requestId(requestId),
+    m_noteContent(noteContent), m_maxPreviewTextSize(maxPreviewTextSize)
+{}
+
+QString NotePreviewTextExtractor::extractPreviewText(
+    const QString & noteContent, const int maxPreviewTextSize)
+{
+    QString previewText;
+    previewText.reserve(maxPreviewTextSize);
+
+    QXmlStreamReader reader(noteContent);
+    bool skipIteration = false;
+
+    while (!reader.atEnd() && (previewText.size() < maxPreviewTextSize)) {
+        Q_UNUSED(reader.readNext())
+
+        if (reader.isStartElement()) {
+            const auto name = reader.name();
+            if ((name == QStringLiteral("en-media")) ||
+                (name == QStringLiteral("en-crypt")))
+            {
+                skipIteration = true;
+            }
+
+            continue;
+        }
+
+        if (reader.isEndElement()) {
+            const auto name = reader.name();
+            if ((name == QStringLiteral("en-media")) ||
+                (name == QStringLiteral("en-crypt")))
+            {
+                skipIteration = false;
+            }
+
+            continue;
+        }
+
+        if (!skipIteration && reader.isCharacters()) {
+            previewText += reader.text();
+        }
+    }
+
+    if (reader.hasError()) {
+        QNDEBUG(
+            "model:note",
+            "Error while extracting the preview text from note content: "
+                << reader.errorString());
+    }
+
+    previewText.truncate(maxPreviewTextSize);
+    return previewText;
+}
+
+void NotePreviewTextExtractor::run()
+{
+    QNTRACE(
+        "model:note",
+        "NotePreviewTextExtractor::run: note local uid = " << m_noteLocalUid);
+
+    QString previewText =
+        extractPreviewText(m_noteContent, m_maxPreviewTextSize);
+
+    Q_EMIT previewTextExtracted(m_noteLocalUid, m_requestId, previewText);
+}
+
+} // namespace quentier
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTE_PREVIEW_TEXT_EXTRACTOR_H
+#define QUENTIER_LIB_MODEL_NOTE_PREVIEW_TEXT_EXTRACTOR_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QString>
+
+namespace quentier {
+
+/**
+ * @brief The NotePreviewTextExtractor class extracts the preview text from
+ * note's ENML content within a thread pool's thread
+ */
+class NotePreviewTextExtractor final : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    explicit NotePreviewTextExtractor(
+        const QString & noteLocalUid, const quint64 requestId,
+        const QString & noteContent, const int maxPreviewTextSize,
+        QObject * parent = nullptr);
+
+    /**
+     * @brief extractPreviewText - collects the plain text from ENML content
+     * skipping en-media and en-crypt elements; unlike Note::plainText, stops
+     * scanning the content as soon as enough text is collected
+     * @param noteContent           ENML content of the note
+     * @param maxPreviewTextSize    Max size of the returned text
+     * @return                      The preview text, no longer than
+     *                              maxPreviewTextSize
+     */
+    static QString extractPreviewText(
+        const QString & noteContent, const int maxPreviewTextSize);
+
+Q_SIGNALS:
+    void previewTextExtracted(
+        QString noteLocalUid, quint64 requestId, QString previewText);
+
+private:
+    virtual void run() override;
+
+private:
+    QString m_noteLocalUid;
+    quint64 m_requestId;
+    QString m_noteContent;
+    int m_maxPreviewTextSize;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_NOTE_PREVIEW_TEXT_EXTRACTOR_H
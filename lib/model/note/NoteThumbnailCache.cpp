@@ -0,0 +1,175 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteThumbnailCache.h"
+#include "NoteThumbnailDecoder.h"
+
+#include <quentier/logging/QuentierLogger.h>
+
+#include <QThreadPool>
+
+namespace quentier {
+
+uint qHash(const NoteThumbnailCache::Key & key, uint seed) noexcept
+{
+    // Fractional device pixel ratios are distinguished up to 1/100
+    return qHash(key.m_noteLocalUid, seed) ^ key.m_thumbnailDataHash ^
+        qHash((key.m_size.width() << 16) ^ key.m_size.height(), seed) ^
+        qHash(qRound(key.m_devicePixelRatio * 100), seed);
+}
+
+NoteThumbnailCache::NoteThumbnailCache(
+    const int maxCostInBytes, QObject * parent) :
+    QObject(parent),
+    m_cache(maxCostInBytes)
+{}
+
+const QPixmap * NoteThumbnailCache::thumbnail(
+    const QString & noteLocalUid, const uint thumbnailDataHash,
+    const QByteArray & thumbnailData, const QSize & size,
+    const qreal devicePixelRatio)
+{
+    if (thumbnailData.isEmpty()) {
+        return nullptr;
+    }
+
+    Key key;
+    key.m_noteLocalUid = noteLocalUid;
+    key.m_thumbnailDataHash = thumbnailDataHash;
+    key.m_size = size;
+    key.m_devicePixelRatio = devicePixelRatio;
+
+    const auto * pPixmap = m_cache.object(key);
+    if (pPixmap) {
+        return pPixmap;
+    }
+
+    if (m_pendingKeys.contains(key) || m_failedKeys.contains(key)) {
+        return nullptr;
+    }
+
+    QNTRACE(
+        "model:note",
+        "Starting the decoding of thumbnail for note with local uid "
+            << noteLocalUid);
+
+    Q_UNUSED(m_pendingKeys.insert(key))
+
+    auto * pDecoder = new NoteThumbnailDecoder(
+        noteLocalUid, thumbnailDataHash, thumbnailData, size,
+        devicePixelRatio);
+
+    QObject::connect(
+        pDecoder, &NoteThumbnailDecoder::thumbnailDecoded, this,
+        &NoteThumbnailCache::onThumbnailDecoded, Qt::QueuedConnection);
+
+    QThreadPool::globalInstance()->start(pDecoder);
+    return nullptr;
+}
+
+void NoteThumbnailCache::invalidate(const QString & noteLocalUid)
+{
+    QNTRACE(
+        "model:note",
+        "NoteThumbnailCache::invalidate: note local uid = " << noteLocalUid);
+
+    const auto keys = m_cache.keys();
+    for (const auto & key: keys) {
+        if (key.m_noteLocalUid == noteLocalUid) {
+            Q_UNUSED(m_cache.remove(key))
+        }
+    }
+
+    for (auto it = m_failedKeys.begin(); it != m_failedKeys.end();) {
+        if (it->m_noteLocalUid == noteLocalUid) {
+            it = m_failedKeys.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+
+    // Thumbnails being decoded at the moment would be discarded once decoded
+    for (auto it = m_pendingKeys.begin(); it != m_pendingKeys.end();) {
+        if (it->m_noteLocalUid == noteLocalUid) {
+            it = m_pendingKeys.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+}
+
+void NoteThumbnailCache::clear()
+{
+    QNTRACE("model:note", "NoteThumbnailCache::clear");
+
+    m_cache.clear();
+    m_pendingKeys.clear();
+    m_failedKeys.clear();
+}
+
+void NoteThumbnailCache::onThumbnailDecoded(
+    QString noteLocalUid, uint thumbnailDataHash, QSize size,
+    qreal devicePixelRatio, QImage image)
+{
+    Key key;
+    key.m_noteLocalUid = std::move(noteLocalUid);
+    key.m_thumbnailDataHash = thumbnailDataHash;
+    key.m_size = size;
+    key.m_devicePixelRatio = devicePixelRatio;
+
+    auto it = m_pendingKeys.find(key);
+    if (it == m_pendingKeys.end()) {
+        QNTRACE(
+            "model:note",
+            "Discarding the decoded thumbnail invalidated during decoding: "
+                << "note local uid = " << key.m_noteLocalUid);
+        return;
+    }
+
+    Q_UNUSED(m_pendingKeys.erase(it))
+
+    if (image.isNull()) {
+        Q_UNUSED(m_failedKeys.insert(key))
+        return;
+    }
+
+    // QPixmap can only be created within the GUI thread so the decoding thread
+    // produces QImage which is converted to QPixmap here
+    auto * pPixmap = new QPixmap(QPixmap::fromImage(image));
+    pPixmap->setDevicePixelRatio(devicePixelRatio);
+
+    int cost = pPixmap->width() * pPixmap->height() * pPixmap->depth() / 8;
+
+    // NOTE: QCache takes ownership of the pixmap and deletes it right away
+    // if its cost exceeds the max cost of the cache
+    if (!m_cache.insert(key, pPixmap, cost)) {
+        Q_UNUSED(m_failedKeys.insert(key))
+        QNDEBUG(
+            "model:note",
+            "The thumbnail of note with local uid "
+                << key.m_noteLocalUid
+                << " is too large for the thumbnail cache");
+        return;
+    }
+
+    Q_EMIT thumbnailReady(key.m_noteLocalUid);
+}
+
+} // namespace quentier
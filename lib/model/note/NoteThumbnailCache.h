@@ -0,0 +1,125 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTE_THUMBNAIL_CACHE_H
+#define QUENTIER_LIB_MODEL_NOTE_THUMBNAIL_CACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+
+namespace quentier {
+
+/**
+ * @brief The NoteThumbnailCache class is a bounded LRU cache of decoded
+ * and scaled note thumbnails
+ *
+ * The thumbnails are keyed by note local uid, the hash of thumbnail data,
+ * the size to which the thumbnail is scaled and the device pixel ratio of
+ * the paint device. Thumbnails missing from the cache
+ * are decoded in background; once the decoding is finished, thumbnailReady
+ * signal is emitted. The cache is bounded by the amount of memory taken by
+ * decoded thumbnails: the least recently used ones are evicted first.
+ */
+class NoteThumbnailCache final : public QObject
+{
+    Q_OBJECT
+public:
+    explicit NoteThumbnailCache(
+        const int maxCostInBytes, QObject * parent = nullptr);
+
+    /**
+     * @brief thumbnail - looks up the decoded thumbnail within the cache
+     *
+     * If no thumbnail corresponding to the passed in data is cached, its
+     * decoding is started in background unless it's already in progress
+     *
+     * @param noteLocalUid          The local uid of the note
+     * @param thumbnailDataHash     The hash of note's thumbnail data
+     * @param thumbnailData         Note's PNG thumbnail data
+     * @param size                  The size in device independent pixels
+     *                              to which the thumbnail should be scaled;
+     *                              invalid size means no scaling
+     * @param devicePixelRatio      The device pixel ratio of the paint device
+     *                              on which the thumbnail would be drawn
+     * @return                      Pointer to the cached thumbnail or nullptr
+     *                              if it's not decoded yet or could not be
+     *                              decoded; the pointer may become dangling
+     *                              on the next call to any non-const method
+     *                              of the cache so it must not be stored
+     */
+    const QPixmap * thumbnail(
+        const QString & noteLocalUid, const uint thumbnailDataHash,
+        const QByteArray & thumbnailData, const QSize & size,
+        const qreal devicePixelRatio = 1.0);
+
+    /**
+     * @brief invalidate - removes all cached thumbnails of the note
+     */
+    void invalidate(const QString & noteLocalUid);
+
+    void clear();
+
+Q_SIGNALS:
+    void thumbnailReady(QString noteLocalUid);
+
+private Q_SLOTS:
+    void onThumbnailDecoded(
+        QString noteLocalUid, uint thumbnailDataHash, QSize size,
+        qreal devicePixelRatio, QImage image);
+
+private:
+    struct Key
+    {
+        bool operator==(const Key & other) const
+        {
+            return (m_thumbnailDataHash == other.m_thumbnailDataHash) &&
+                (m_size == other.m_size) &&
+                qFuzzyCompare(m_devicePixelRatio, other.m_devicePixelRatio) &&
+                (m_noteLocalUid == other.m_noteLocalUid);
+        }
+
+        QString m_noteLocalUid;
+        uint m_thumbnailDataHash = 0;
+        QSize m_size;
+        qreal m_devicePixelRatio = 1.0;
+    };
+
+    friend uint qHash(const Key & key, uint seed) noexcept;
+
+private:
+    QCache<Key, QPixmap> m_cache;
+
+    // Keys of thumbnails being decoded at the moment, used to prevent
+    // the concurrent decoding of the same thumbnail
+    QSet<Key> m_pendingKeys;
+
+    // Keys of thumbnails which could not be decoded, used to prevent
+    // the repeated attempts to decode broken thumbnails
+    QSet<Key> m_failedKeys;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_NOTE_THUMBNAIL_CACHE_H
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteThumbnailDecoder.h"
+
+#include <quentier/logging/QuentierLogger.h>
+
+namespace quentier {
+
+NoteThumbnailDecoder::NoteThumbnailDecoder(
+    const QString & noteLocalUid, const uint thumbnailDataHash,
+    const QByteArray & thumbnailData, const QSize & size,
+    const qreal devicePixelRatio, QObject * parent) :
+    QObject(parent),
+    QRunnable(), m_noteLocalUid(noteLocalUid),
+    m_thumbnailDataHash(thumbnailDataHash), m_thumbnailData(thumbnailData),
+    m_size(size), m_devicePixelRatio(devicePixelRatio)
+{}
+
+void NoteThumbnailDecoder::run()
+{
+    QNTRACE(
+        "model:note",
+        "NoteThumbnailDecoder::run: note local uid = "
+            << m_noteLocalUid << ", width = " << m_size.width()
+            << ", height = " << m_size.height()
+            << ", device pixel ratio = " << m_devicePixelRatio);
+
+    QSize pixelSize = m_size * m_devicePixelRatio;
+
+    QImage image;
+    if (!image.loadFromData(m_thumbnailData, "PNG")) {
+        QNWARNING(
+            "model:note",
+            "Failed to decode the thumbnail of note with local uid "
+                << m_noteLocalUid);
+    }
+    else if (pixelSize.isValid() && (image.size() != pixelSize)) {
+        image = image.scaled(
+            pixelSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    Q_EMIT thumbnailDecoded(
+        m_noteLocalUid, m_thumbnailDataHash, m_size, m_devicePixelRatio, image);
+}
+
+} // namespace quentier
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTE_THUMBNAIL_DECODER_H
+#define QUENTIER_LIB_MODEL_NOTE_THUMBNAIL_DECODER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QObject>
+#include <QRunnable>
+#include <QSize>
+#include <QString>
+
+namespace quentier {
+
+/**
+ * @brief The NoteThumbnailDecoder class decodes note's PNG thumbnail
+ * and scales it to the requested size in device pixels within a thread pool's
+ * thread
+ */
+class NoteThumbnailDecoder final : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    explicit NoteThumbnailDecoder(
+        const QString & noteLocalUid, const uint thumbnailDataHash,
+        const QByteArray & thumbnailData, const QSize & size,
+        const qreal devicePixelRatio, QObject * parent = nullptr);
+
+Q_SIGNALS:
+    /**
+     * @brief thumbnailDecoded signal is emitted when the thumbnail is decoded;
+     * the image is null if the thumbnail data could not be decoded
+     */
+    void thumbnailDecoded(
+        QString noteLocalUid, uint thumbnailDataHash, QSize size,
+        qreal devicePixelRatio, QImage image);
+
+private:
+    virtual void run() override;
+
+private:
+    QString m_noteLocalUid;
+    uint m_thumbnailDataHash;
+    QByteArray m_thumbnailData;
+    QSize m_size;
+    qreal m_devicePixelRatio;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_NOTE_THUMBNAIL_DECODER_H
@@ -29,6 +29,9 @@
 
 #include <QDataStream>
 #include <QMimeData>
+#include <QVector>
+
+#include <utility>
 
 namespace quentier {
 
@@ -48,12 +51,10 @@ NotebookModel::NotebookModel(
     LocalStorageManagerAsync & localStorageManagerAsync, NotebookCache & cache,
     QObject * parent) :
     AbstractItemModel(account, parent),
-    m_cache(cache)
+    m_cache(cache), m_listNotebooksPagingPolicy(NOTEBOOK_LIST_LIMIT),
+    m_listLinkedNotebooksPagingPolicy(LINKED_NOTEBOOK_LIST_LIMIT)
 {
     createConnections(localStorageManagerAsync);
-
-    requestNotebooksList();
-    requestLinkedNotebooksList();
 }
 
 NotebookModel::~NotebookModel()
@@ -731,6 +732,30 @@ bool NotebookModel::allNotebooksListed() const
     return m_allNotebooksListed && m_allLinkedNotebooksListed;
 }
 
+int NotebookModel::noteCountForNotebook(const QString & notebookLocalUid) const
+{
+    if (!allNotebooksListed()) {
+        return -1;
+    }
+
+    // While any note count request is in flight it's unknown which notebooks
+    // would have their note counts changed by it
+    if (!m_noteCountPerNotebookRequestIds.isEmpty() ||
+        !m_noteCountsBatches.isEmpty() ||
+        m_noteCountForAllNotebooksPending)
+    {
+        return -1;
+    }
+
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto it = localUidIndex.find(notebookLocalUid);
+    if (it == localUidIndex.end()) {
+        return -1;
+    }
+
+    return it->noteCount();
+}
+
 void NotebookModel::favoriteNotebook(const QModelIndex & index)
 {
     QNDEBUG(
@@ -1680,40 +1705,13 @@ void NotebookModel::sort(int column, Qt::SortOrder order)
 
     m_sortOrder = order;
 
-    Q_EMIT layoutAboutToBeChanged();
+    Q_EMIT layoutAboutToBeChanged(
+        QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
-    auto & localUidIndex = m_data.get<ByLocalUid>();
-    for (auto & item: localUidIndex) {
-        updateItemRowWithRespectToSorting(const_cast<NotebookItem &>(item));
-    }
+    sortItems();
 
-    for (auto it = m_stackItems.begin(), end = m_stackItems.end(); it != end;
-         ++it) {
-        updateItemRowWithRespectToSorting(const_cast<StackItem &>(it.value()));
-    }
-
-    for (auto it = m_linkedNotebookItems.begin(),
-              end = m_linkedNotebookItems.end();
-         it != end; ++it)
-    {
-        updateItemRowWithRespectToSorting(
-            const_cast<LinkedNotebookRootItem &>(it.value()));
-    }
-
-    for (auto it = m_stackItemsByLinkedNotebookGuid.begin(),
-              end = m_stackItemsByLinkedNotebookGuid.end();
-         it != end; ++it)
-    {
-        StackItems & stackItems = it.value();
-        for (auto sit = stackItems.begin(), send = stackItems.end();
-             sit != send; ++sit) {
-            updateItemRowWithRespectToSorting(
-                const_cast<StackItem &>(sit.value()));
-        }
-    }
-
-    updatePersistentModelIndices();
-    Q_EMIT layoutChanged();
+    Q_EMIT layoutChanged(
+        QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 }
 
 QStringList NotebookModel::mimeTypes() const
@@ -2074,20 +2072,30 @@ void NotebookModel::onListNotebooksComplete(
             << ", num found notebooks = " << foundNotebooks.size()
             << ", request id = " << requestId);
 
-    for (const auto & notebook: qAsConst(foundNotebooks)) {
-        onNotebookAddedOrUpdated(notebook);
-        requestNoteCountForNotebook(notebook);
-    }
-
     m_listNotebooksRequestId = QUuid();
 
-    if (!foundNotebooks.isEmpty()) {
+    bool hasMorePages = m_listNotebooksPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundNotebooks.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:notebook",
-            "The number of found notebooks is not empty, "
-                << "requesting more notebooks from the local storage");
+            "The page of found notebooks is full, requesting more "
+                << "notebooks from the local storage");
+
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listNotebooksOffset += static_cast<size_t>(foundNotebooks.size());
         requestNotebooksList();
+    }
+
+    for (const auto & notebook: qAsConst(foundNotebooks)) {
+        onNotebookAddedOrUpdated(notebook);
+    }
+
+    requestNoteCountsForNotebooks(foundNotebooks);
+
+    if (hasMorePages) {
         return;
     }
 
@@ -2122,6 +2130,9 @@ void NotebookModel::onListNotebooksFailed(
 
     m_listNotebooksRequestId = QUuid();
 
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -2170,6 +2181,10 @@ void NotebookModel::onGetNoteCountPerNotebookComplete(
 {
     Q_UNUSED(options)
 
+    if (onBatchedNoteCountReceived(requestId, notebook.localUid(), noteCount)) {
+        return;
+    }
+
     auto it = m_noteCountPerNotebookRequestIds.find(requestId);
     if (it == m_noteCountPerNotebookRequestIds.end()) {
         return;
@@ -2181,6 +2196,7 @@ void NotebookModel::onGetNoteCountPerNotebookComplete(
             << "note count = " << noteCount << ", notebook = " << notebook
             << "\nRequest id = " << requestId);
 
+    quint64 sequenceNumber = it.value();
     Q_UNUSED(m_noteCountPerNotebookRequestIds.erase(it))
 
     QString notebookLocalUid = notebook.localUid();
@@ -2194,6 +2210,13 @@ void NotebookModel::onGetNoteCountPerNotebookComplete(
         return;
     }
 
+    if (!checkNoteCountSequenceNumber(notebookLocalUid, sequenceNumber)) {
+        QNTRACE(
+            "model:notebook",
+            "The received note count is older than the one already set");
+        return;
+    }
+
     NotebookItem item = *itemIt;
     item.setNoteCount(noteCount);
 
@@ -2206,6 +2229,18 @@ void NotebookModel::onGetNoteCountPerNotebookFailed(
 {
     Q_UNUSED(options)
 
+    // The note count which failed to be received within the batch is left
+    // intact while the rest of the batch is applied
+    if (onBatchedNoteCountReceived(requestId, notebook.localUid(), -1)) {
+        QNWARNING(
+            "model:notebook",
+            "NotebookModel::onGetNoteCountPerNotebookFailed: "
+                << "error description = " << errorDescription
+                << ", notebook: " << notebook
+                << "\nRequest id = " << requestId);
+        return;
+    }
+
     auto it = m_noteCountPerNotebookRequestIds.find(requestId);
     if (it == m_noteCountPerNotebookRequestIds.end()) {
         return;
@@ -2217,6 +2252,7 @@ void NotebookModel::onGetNoteCountPerNotebookFailed(
             << "error description = " << errorDescription
             << ", notebook: " << notebook << "\nRequest id = " << requestId);
 
+    quint64 sequenceNumber = it.value();
     Q_UNUSED(m_noteCountPerNotebookRequestIds.erase(it))
 
     // Not much can be done here - will just attempt ot "remove" the count from
@@ -2233,6 +2269,10 @@ void NotebookModel::onGetNoteCountPerNotebookFailed(
         return;
     }
 
+    if (!checkNoteCountSequenceNumber(notebookLocalUid, sequenceNumber)) {
+        return;
+    }
+
     NotebookItem item = *itemIt;
     item.setNoteCount(-1);
 
@@ -2438,26 +2478,31 @@ void NotebookModel::onListAllLinkedNotebooksComplete(
             << ", order = " << order << ", order direction = " << orderDirection
             << ", request id = " << requestId);
 
-    for (auto it = foundLinkedNotebooks.constBegin(),
-              end = foundLinkedNotebooks.constEnd();
-         it != end; ++it)
-    {
-        onLinkedNotebookAddedOrUpdated(*it);
-    }
-
     m_listLinkedNotebooksRequestId = QUuid();
 
-    if (!foundLinkedNotebooks.isEmpty()) {
+    bool hasMorePages = m_listLinkedNotebooksPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundLinkedNotebooks.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:notebook",
-            "The number of found linked notebooks is not "
-                << "empty, requesting more linked notebooks from the local "
-                << "storage");
+            "The page of found linked notebooks is full, requesting more "
+                << "linked notebooks from the local storage");
 
         m_listLinkedNotebooksOffset +=
             static_cast<size_t>(foundLinkedNotebooks.size());
 
         requestLinkedNotebooksList();
+    }
+
+    for (auto it = foundLinkedNotebooks.constBegin(),
+              end = foundLinkedNotebooks.constEnd();
+         it != end; ++it)
+    {
+        onLinkedNotebookAddedOrUpdated(*it);
+    }
+
+    if (hasMorePages) {
         return;
     }
 
@@ -2492,6 +2537,155 @@ void NotebookModel::onListAllLinkedNotebooksFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
+void NotebookModel::startListing()
+{
+    QNDEBUG("model:notebook", "NotebookModel::startListing");
+
+    requestNotebooksList();
+    requestLinkedNotebooksList();
+}
+
+void NotebookModel::writeSnapshot(QDataStream & out) const
+{
+    out << m_linkedNotebookUsernamesByGuids;
+
+    QList<const NotebookItem *> items;
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & item: localUidIndex) {
+        if (!m_notebookItemsNotYetInLocalStorageUids.contains(item.localUid()))
+        {
+            items << &item;
+        }
+    }
+
+    out << static_cast<quint32>(items.size());
+    for (const auto * pItem: qAsConst(items)) {
+        out << pItem->localUid() << pItem->guid()
+            << pItem->linkedNotebookGuid() << pItem->name() << pItem->stack()
+            << static_cast<qint32>(pItem->noteCount())
+            << pItem->isSynchronizable() << pItem->isDirty()
+            << pItem->isDefault() << pItem->isLastUsed()
+            << pItem->isPublished() << pItem->isFavorited()
+            << pItem->isUpdatable() << pItem->nameIsUpdatable()
+            << pItem->canCreateNotes() << pItem->canUpdateNotes();
+    }
+}
+
+bool NotebookModel::readSnapshot(QDataStream & in, QStringList & localUids)
+{
+    QHash<QString, QString> linkedNotebookUsernamesByGuids;
+    in >> linkedNotebookUsernamesByGuids;
+
+    quint32 numItems = 0;
+    in >> numItems;
+
+    QList<std::pair<Notebook, qint32>> notebooksWithNoteCounts;
+    for (quint32 i = 0; i < numItems && in.status() == QDataStream::Ok; ++i) {
+        QString localUid;
+        QString guid;
+        QString linkedNotebookGuid;
+        QString name;
+        QString stack;
+        qint32 noteCount = 0;
+        bool isSynchronizable = false;
+        bool isDirty = false;
+        bool isDefault = false;
+        bool isLastUsed = false;
+        bool isPublished = false;
+        bool isFavorited = false;
+        bool isUpdatable = false;
+        bool nameIsUpdatable = false;
+        bool canCreateNotes = false;
+        bool canUpdateNotes = false;
+
+        in >> localUid >> guid >> linkedNotebookGuid >> name >> stack >>
+            noteCount >> isSynchronizable >> isDirty >> isDefault >>
+            isLastUsed >> isPublished >> isFavorited >> isUpdatable >>
+            nameIsUpdatable >> canCreateNotes >> canUpdateNotes;
+
+        Notebook notebook;
+        notebook.setLocalUid(localUid);
+
+        if (!guid.isEmpty()) {
+            notebook.setGuid(guid);
+        }
+
+        if (!linkedNotebookGuid.isEmpty()) {
+            notebook.setLinkedNotebookGuid(linkedNotebookGuid);
+        }
+
+        if (!stack.isEmpty()) {
+            notebook.setStack(stack);
+        }
+
+        notebook.setName(name);
+        notebook.setLocal(!isSynchronizable);
+        notebook.setDirty(isDirty);
+        notebook.setDefaultNotebook(isDefault);
+        notebook.setLastUsed(isLastUsed);
+        notebook.setPublished(isPublished);
+        notebook.setFavorited(isFavorited);
+
+        if (!canCreateNotes || !canUpdateNotes || !isUpdatable ||
+            !nameIsUpdatable)
+        {
+            notebook.setCanCreateNotes(canCreateNotes);
+            notebook.setCanUpdateNotes(canUpdateNotes);
+            notebook.setCanUpdateNotebook(isUpdatable);
+            notebook.setCanRenameNotebook(nameIsUpdatable);
+        }
+
+        notebooksWithNoteCounts << std::make_pair(notebook, noteCount);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    for (auto it = linkedNotebookUsernamesByGuids.constBegin(),
+              end = linkedNotebookUsernamesByGuids.constEnd();
+         it != end; ++it)
+    {
+        LinkedNotebook linkedNotebook;
+        linkedNotebook.setGuid(it.key());
+        linkedNotebook.setUsername(it.value());
+        onLinkedNotebookAddedOrUpdated(linkedNotebook);
+    }
+
+    // NOTE: restored notebooks are deliberately not put into the cache as they
+    // lack the fields which the model doesn't keep
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & pair: qAsConst(notebooksWithNoteCounts)) {
+        const auto & notebook = pair.first;
+        if (localUidIndex.find(notebook.localUid()) != localUidIndex.end()) {
+            continue;
+        }
+
+        onNotebookAdded(notebook);
+        localUids << notebook.localUid();
+
+        auto itemIt = localUidIndex.find(notebook.localUid());
+        if (itemIt != localUidIndex.end()) {
+            NotebookItem item(*itemIt);
+            item.setNoteCount(pair.second);
+            localUidIndex.replace(itemIt, item);
+        }
+    }
+
+    return true;
+}
+
+void NotebookModel::removeSnapshotItems(const QStringList & localUids)
+{
+    Q_EMIT aboutToRemoveNotebooks();
+
+    for (const auto & localUid: localUids) {
+        removeItemByLocalUid(localUid);
+    }
+
+    Q_EMIT removedNotebooks();
+}
+
 void NotebookModel::createConnections(
     LocalStorageManagerAsync & localStorageManagerAsync)
 {
@@ -2647,8 +2841,10 @@ void NotebookModel::requestNotebooksList()
             << "offset = " << m_listNotebooksOffset
             << ", request id = " << m_listNotebooksRequestId);
 
+    size_t limit = m_listNotebooksPagingPolicy.onPageRequested();
+
     Q_EMIT listNotebooks(
-        flags, NOTEBOOK_LIST_LIMIT, m_listNotebooksOffset, order, direction, {},
+        flags, limit, m_listNotebooksOffset, order, direction, {},
         m_listNotebooksRequestId);
 }
 
@@ -2659,7 +2855,8 @@ void NotebookModel::requestNoteCountForNotebook(const Notebook & notebook)
         "NotebookModel::requestNoteCountForNotebook: " << notebook);
 
     QUuid requestId = QUuid::createUuid();
-    Q_UNUSED(m_noteCountPerNotebookRequestIds.insert(requestId))
+    m_noteCountPerNotebookRequestIds[requestId] =
+        ++m_lastNoteCountSequenceNumber;
     QNTRACE(
         "model:notebook",
         "Emitting request to get the note count per "
@@ -2671,16 +2868,212 @@ void NotebookModel::requestNoteCountForNotebook(const Notebook & notebook)
     Q_EMIT requestNoteCountPerNotebook(notebook, options, requestId);
 }
 
+void NotebookModel::requestNoteCountsForNotebooks(
+    const QList<Notebook> & notebooks, const bool allNotebooks)
+{
+    QNTRACE(
+        "model:notebook",
+        "NotebookModel::requestNoteCountsForNotebooks: "
+            << notebooks.size() << " notebooks, all notebooks = "
+            << (allNotebooks ? "true" : "false"));
+
+    if (notebooks.isEmpty()) {
+        return;
+    }
+
+    NoteCountsBatch batch;
+    batch.m_sequenceNumber = ++m_lastNoteCountSequenceNumber;
+    batch.m_allNotebooks = allNotebooks;
+
+    QVector<QUuid> requestIds;
+    requestIds.reserve(notebooks.size());
+
+    for (int i = 0, size = notebooks.size(); i < size; ++i) {
+        QUuid requestId = QUuid::createUuid();
+        requestIds << requestId;
+        Q_UNUSED(batch.m_requestIds.insert(requestId))
+
+        m_noteCountsBatchSequenceNumberByRequestId[requestId] =
+            batch.m_sequenceNumber;
+    }
+
+    m_noteCountsBatches[batch.m_sequenceNumber] = batch;
+
+    LocalStorageManager::NoteCountOptions options(
+        LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+
+    // The local storage has no query returning note counts for several
+    // notebooks at once (unlike for tags) so only the results are coalesced
+    for (int i = 0, size = notebooks.size(); i < size; ++i) {
+        Q_EMIT requestNoteCountPerNotebook(
+            notebooks.at(i), options, requestIds.at(i));
+    }
+
+    QNTRACE(
+        "model:notebook",
+        "Note count batches in progress: " << m_noteCountsBatches.size());
+}
+
 void NotebookModel::requestNoteCountForAllNotebooks()
 {
     QNTRACE("model:notebook", "NotebookModel::requestNoteCountForAllNotebooks");
 
+    for (const auto & batch: qAsConst(m_noteCountsBatches)) {
+        if (!batch.m_allNotebooks) {
+            continue;
+        }
+
+        // The counts received within the current batch might not reflect
+        // the changes which caused this request so all counts would be
+        // requested once again after the current batch is complete
+        QNTRACE(
+            "model:notebook",
+            "Note counts batch for all notebooks is in progress, "
+                << "postponing the request");
+        m_noteCountForAllNotebooksPending = true;
+        return;
+    }
+
+    m_noteCountForAllNotebooksPending = false;
+
     const auto & localUidIndex = m_data.get<ByLocalUid>();
+
+    QList<Notebook> notebooks;
+    notebooks.reserve(static_cast<int>(localUidIndex.size()));
+
     for (const auto & item: localUidIndex) {
         Notebook notebook;
         notebook.setLocalUid(item.localUid());
-        requestNoteCountForNotebook(notebook);
+        notebooks << notebook;
+    }
+
+    requestNoteCountsForNotebooks(notebooks, true);
+}
+
+bool NotebookModel::onBatchedNoteCountReceived(
+    const QUuid & requestId, const QString & notebookLocalUid,
+    const int noteCount)
+{
+    auto it = m_noteCountsBatchSequenceNumberByRequestId.find(requestId);
+    if (it == m_noteCountsBatchSequenceNumberByRequestId.end()) {
+        return false;
+    }
+
+    quint64 sequenceNumber = it.value();
+    Q_UNUSED(m_noteCountsBatchSequenceNumberByRequestId.erase(it))
+
+    auto batchIt = m_noteCountsBatches.find(sequenceNumber);
+    if (Q_UNLIKELY(batchIt == m_noteCountsBatches.end())) {
+        return true;
     }
+
+    auto & batch = batchIt.value();
+    Q_UNUSED(batch.m_requestIds.remove(requestId))
+
+    if (noteCount >= 0) {
+        batch.m_noteCountsByNotebookLocalUid[notebookLocalUid] = noteCount;
+    }
+
+    if (!batch.m_requestIds.isEmpty()) {
+        return true;
+    }
+
+    // The batch must no longer be pending when its counts are applied:
+    // noteCountForNotebook is called from slots connected to dataChanged
+    // and it doesn't report counts while any batch is pending
+    NoteCountsBatch completeBatch = batch;
+    Q_UNUSED(m_noteCountsBatches.erase(batchIt))
+
+    bool allNotebooks = completeBatch.m_allNotebooks;
+    applyBatchedNoteCounts(completeBatch);
+
+    if (allNotebooks && m_noteCountForAllNotebooksPending) {
+        requestNoteCountForAllNotebooks();
+    }
+
+    return true;
+}
+
+void NotebookModel::applyBatchedNoteCounts(const NoteCountsBatch & batch)
+{
+    QNDEBUG(
+        "model:notebook",
+        "NotebookModel::applyBatchedNoteCounts: "
+            << batch.m_noteCountsByNotebookLocalUid.size()
+            << " note counts, sequence number = " << batch.m_sequenceNumber);
+
+    QSet<const INotebookModelItem *> parentItems;
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+
+    for (auto it = batch.m_noteCountsByNotebookLocalUid.constBegin(),
+              end = batch.m_noteCountsByNotebookLocalUid.constEnd();
+         it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(it.key());
+        if (itemIt == localUidIndex.end()) {
+            QNDEBUG(
+                "model:notebook",
+                "Can't find the notebook item by local uid: " << it.key());
+            continue;
+        }
+
+        if (!checkNoteCountSequenceNumber(it.key(), batch.m_sequenceNumber)) {
+            QNTRACE(
+                "model:notebook",
+                "Skipping the outdated note count for notebook with local "
+                    << "uid " << it.key());
+            continue;
+        }
+
+        if (itemIt->noteCount() == it.value()) {
+            continue;
+        }
+
+        NotebookItem item = *itemIt;
+        item.setNoteCount(it.value());
+        localUidIndex.replace(itemIt, item);
+
+        const auto * pParentItem = itemIt->parent();
+        if (pParentItem) {
+            Q_UNUSED(parentItems.insert(pParentItem))
+        }
+    }
+
+    for (const auto * pParentItem: qAsConst(parentItems)) {
+        int numChildren = pParentItem->childrenCount();
+        if (numChildren == 0) {
+            continue;
+        }
+
+        auto parentIndex = indexForItem(pParentItem);
+
+        auto modelIndexFrom =
+            index(0, static_cast<int>(Column::NoteCount), parentIndex);
+
+        auto modelIndexTo = index(
+            numChildren - 1, static_cast<int>(Column::NoteCount), parentIndex);
+
+        Q_EMIT dataChanged(modelIndexFrom, modelIndexTo);
+    }
+}
+
+bool NotebookModel::checkNoteCountSequenceNumber(
+    const QString & notebookLocalUid, const quint64 sequenceNumber)
+{
+    auto it =
+        m_noteCountSequenceNumberByNotebookLocalUid.find(notebookLocalUid);
+    if (it == m_noteCountSequenceNumberByNotebookLocalUid.end()) {
+        m_noteCountSequenceNumberByNotebookLocalUid[notebookLocalUid] =
+            sequenceNumber;
+        return true;
+    }
+
+    if (it.value() > sequenceNumber) {
+        return false;
+    }
+
+    it.value() = sequenceNumber;
+    return true;
 }
 
 void NotebookModel::requestLinkedNotebooksList()
@@ -2700,9 +3093,11 @@ void NotebookModel::requestLinkedNotebooksList()
             << "offset = " << m_listLinkedNotebooksOffset
             << ", request id = " << m_listLinkedNotebooksRequestId);
 
+    size_t limit = m_listLinkedNotebooksPagingPolicy.onPageRequested();
+
     Q_EMIT listAllLinkedNotebooks(
-        LINKED_NOTEBOOK_LIST_LIMIT, m_listLinkedNotebooksOffset, order,
-        direction, m_listLinkedNotebooksRequestId);
+        limit, m_listLinkedNotebooksOffset, order, direction,
+        m_listLinkedNotebooksRequestId);
 }
 
 QVariant NotebookModel::dataImpl(
@@ -2903,6 +3298,7 @@ NotebookModel::RemoveRowsScopeGuard::~RemoveRowsScopeGuard()
 
 void NotebookModel::onNotebookAddedOrUpdated(const Notebook & notebook)
 {
+    confirmSnapshotItem(notebook.localUid());
     m_cache.put(notebook.localUid(), notebook);
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
@@ -3883,17 +4279,70 @@ void NotebookModel::updateItemRowWithRespectToSorting(
                                << "; item: " << modelItem);
 }
 
-void NotebookModel::updatePersistentModelIndices()
+void NotebookModel::sortItems()
 {
-    QNTRACE("model:notebook", "NotebookModel::updatePersistentModelIndices");
+    QNTRACE("model:notebook", "NotebookModel::sortItems");
+
+    if (!m_pInvisibleRootItem) {
+        return;
+    }
+
+    // Each item's children are sorted only once, the rows permutations are
+    // kept to remap persistent model indices without looking up the rows
+    // of their items
+    QHash<const INotebookModelItem *, QVector<int>> newRowsByParentItem;
+
+    QVector<INotebookModelItem *> parentItems;
+    parentItems << m_pInvisibleRootItem;
+
+    while (!parentItems.isEmpty()) {
+        auto * pParentItem = parentItems.takeLast();
+
+        const auto children = pParentItem->children();
+        for (auto * pChildItem: children) {
+            if (pChildItem && pChildItem->hasChildren()) {
+                parentItems << pChildItem;
+            }
+        }
+
+        if (children.size() < 2) {
+            continue;
+        }
+
+        if (m_sortOrder == Qt::AscendingOrder) {
+            newRowsByParentItem[pParentItem] =
+                pParentItem->sortChildren(LessByName());
+        }
+        else {
+            newRowsByParentItem[pParentItem] =
+                pParentItem->sortChildren(GreaterByName());
+        }
+    }
 
-    // Ensure any persistent model indices would be updated appropriately
     auto indices = persistentIndexList();
+
+    QModelIndexList replacementIndices;
+    replacementIndices.reserve(indices.size());
+
     for (const auto & index: qAsConst(indices)) {
-        auto * pItem = itemForId(static_cast<IndexId>(index.internalId()));
-        auto replacementIndex = indexForItem(pItem);
-        changePersistentIndex(index, replacementIndex);
+        const auto * pItem =
+            itemForId(static_cast<IndexId>(index.internalId()));
+
+        const auto * pParentItem = (pItem ? pItem->parent() : nullptr);
+
+        auto it = newRowsByParentItem.constFind(pParentItem);
+        if ((it == newRowsByParentItem.constEnd()) ||
+            (index.row() >= it.value().size()))
+        {
+            replacementIndices << index;
+            continue;
+        }
+
+        replacementIndices << createIndex(
+            it.value().at(index.row()), index.column(), index.internalId());
     }
+
+    changePersistentIndexList(indices, replacementIndices);
 }
 
 bool NotebookModel::incrementNoteCountForNotebook(
@@ -4868,7 +5317,7 @@ bool NotebookModel::updateNoteCountPerNotebookIndex(
 bool NotebookModel::LessByName::operator()(
     const NotebookItem & lhs, const NotebookItem & rhs) const
 {
-    return (lhs.nameUpper().localeAwareCompare(rhs.nameUpper()) <= 0);
+    return (lhs.nameUpper().localeAwareCompare(rhs.nameUpper()) < 0);
 }
 
 #define ITEM_PTR_LESS(lhs, rhs)                                                \
@@ -4960,7 +5409,7 @@ bool NotebookModel::LessByName::operator()(
     QString lhsName = modelItemName(lhs);
     QString rhsName = modelItemName(rhs);
 
-    return (lhsName.localeAwareCompare(rhsName) <= 0);
+    return (lhsName.localeAwareCompare(rhsName) < 0);
 }
 
 bool NotebookModel::LessByName::operator()(
@@ -4972,7 +5421,7 @@ bool NotebookModel::LessByName::operator()(
 bool NotebookModel::LessByName::operator()(
     const StackItem & lhs, const StackItem & rhs) const
 {
-    return (lhs.name().toUpper().localeAwareCompare(rhs.name().toUpper()) <= 0);
+    return (lhs.name().toUpper().localeAwareCompare(rhs.name().toUpper()) < 0);
 }
 
 bool NotebookModel::LessByName::operator()(
@@ -4986,7 +5435,7 @@ bool NotebookModel::LessByName::operator()(
     const LinkedNotebookRootItem & rhs) const
 {
     return (
-        lhs.username().toUpper().localeAwareCompare(rhs.username().toUpper()) <=
+        lhs.username().toUpper().localeAwareCompare(rhs.username().toUpper()) <
         0);
 }
 
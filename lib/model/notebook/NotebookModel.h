@@ -27,6 +27,7 @@
 #include "StackItem.h"
 
 #include <lib/model/common/AbstractItemModel.h>
+#include <lib/model/common/ListPagingPolicy.h>
 
 #include <quentier/local_storage/LocalStorageManagerAsync.h>
 #include <quentier/types/Account.h>
@@ -265,6 +266,18 @@ public:
      */
     bool allNotebooksListed() const;
 
+    /**
+     * @brief noteCountForNotebook - provides the number of notes per notebook
+     * kept by the model
+     *
+     * @param notebookLocalUid      The local uid of the notebook which note
+     *                              count is required
+     * @return                      The number of notes within the notebook or
+     *                              -1 if the notebook is not within the model
+     *                              or its note count is not known yet
+     */
+    int noteCountForNotebook(const QString & notebookLocalUid) const;
+
     /**
      * @brief favoriteNotebook - marks the notebook pointed to by the index as
      * favorited
@@ -545,10 +558,73 @@ private Q_SLOTS:
         ErrorString errorDescription, QUuid requestId);
 
 private:
+    // AbstractItemModel interface
+    virtual void startListing() override;
+    virtual void writeSnapshot(QDataStream & out) const override;
+
+    virtual bool readSnapshot(
+        QDataStream & in, QStringList & localUids) override;
+
+    virtual void removeSnapshotItems(const QStringList & localUids) override;
+
     void createConnections(LocalStorageManagerAsync & localStorageManagerAsync);
     void requestNotebooksList();
     void requestNoteCountForNotebook(const Notebook & notebook);
+
+    /**
+     * @brief requestNoteCountsForNotebooks - requests note counts for several
+     * notebooks and coalesces the results into a single batch: the local
+     * storage is still queried once per notebook but the received counts are
+     * accumulated and applied to notebook items at once when the whole batch
+     * is complete
+     *
+     * @param notebooks         Notebooks to request note counts for
+     * @param allNotebooks      True if the batch is requested for all
+     *                          notebooks within the model, false otherwise
+     */
+    void requestNoteCountsForNotebooks(
+        const QList<Notebook> & notebooks, const bool allNotebooks = false);
+
+    /**
+     * @brief requestNoteCountForAllNotebooks - requests note counts for all
+     * notebooks within the model, coalescing the results into a single batch;
+     * if some batch is already in progress, postpones the request until that
+     * batch is complete
+     */
     void requestNoteCountForAllNotebooks();
+
+    /**
+     * @param noteCount     The received note count; negative value means
+     *                      the note count could not be received so the item
+     *                      keeps its previous note count
+     * @return              True if the request id belongs to some batch of
+     *                      note count requests, false otherwise
+     */
+    bool onBatchedNoteCountReceived(
+        const QUuid & requestId, const QString & notebookLocalUid,
+        const int noteCount);
+
+    struct NoteCountsBatch;
+
+    /**
+     * @brief applyBatchedNoteCounts - sets note counts accumulated within
+     * the complete batch to notebook items, emits one dataChanged signal
+     * per parent item
+     */
+    void applyBatchedNoteCounts(const NoteCountsBatch & batch);
+
+    /**
+     * @brief checkNoteCountSequenceNumber - checks that the note count
+     * requested with the given sequence number is not older than the note
+     * count already set to the notebook item and if so, records the sequence
+     * number as the one of the notebook item's note count
+     *
+     * @return              True if the note count should be set to the item,
+     *                      false if it is outdated
+     */
+    bool checkNoteCountSequenceNumber(
+        const QString & notebookLocalUid, const quint64 sequenceNumber);
+
     void requestLinkedNotebooksList();
 
     QVariant dataImpl(
@@ -588,7 +664,13 @@ private:
 
     void updateItemRowWithRespectToSorting(INotebookModelItem & modelItem);
 
-    void updatePersistentModelIndices();
+    /**
+     * @brief sortItems - sorts the children of each item within the model
+     * according to the current sort order and remaps persistent model indices
+     * through the resulting row permutations; must be called between
+     * layoutAboutToBeChanged and layoutChanged signals
+     */
+    void sortItems();
 
     // Returns true if successfully incremented the note count for the notebook
     // item with the corresponding local uid
@@ -813,6 +895,15 @@ private:
         const StackItem & stackItem, const int column,
         Qt::ItemFlags flags) const;
 
+private:
+    struct NoteCountsBatch
+    {
+        quint64 m_sequenceNumber = 0;
+        bool m_allNotebooks = false;
+        QSet<QUuid> m_requestIds;
+        QHash<QString, int> m_noteCountsByNotebookLocalUid;
+    };
+
 private:
     NotebookData m_data;
 
@@ -838,6 +929,7 @@ private:
     NotebookCache & m_cache;
 
     size_t m_listNotebooksOffset = 0;
+    ListPagingPolicy m_listNotebooksPagingPolicy;
     QUuid m_listNotebooksRequestId;
     QSet<QUuid> m_notebookItemsNotYetInLocalStorageUids;
 
@@ -848,11 +940,25 @@ private:
     QSet<QUuid> m_findNotebookToRestoreFailedUpdateRequestIds;
     QSet<QUuid> m_findNotebookToPerformUpdateRequestIds;
 
-    QSet<QUuid> m_noteCountPerNotebookRequestIds;
+    // Each note count request gets a sequence number so that the note count
+    // from the older request is not set to the item over the note count from
+    // the newer one which happened to be received earlier
+    quint64 m_lastNoteCountSequenceNumber = 0;
+    QHash<QString, quint64> m_noteCountSequenceNumberByNotebookLocalUid;
+
+    // Sequence numbers by request ids
+    QHash<QUuid, quint64> m_noteCountPerNotebookRequestIds;
+
+    // Batches by their sequence numbers and their sequence numbers by request
+    // ids
+    QHash<quint64, NoteCountsBatch> m_noteCountsBatches;
+    QHash<QUuid, quint64> m_noteCountsBatchSequenceNumberByRequestId;
+    bool m_noteCountForAllNotebooksPending = false;
 
     QHash<QString, QString> m_linkedNotebookUsernamesByGuids;
 
     size_t m_listLinkedNotebooksOffset = 0;
+    ListPagingPolicy m_listLinkedNotebooksPagingPolicy;
     QUuid m_listLinkedNotebooksRequestId;
 
     Column m_sortedColumn = Column::Name;
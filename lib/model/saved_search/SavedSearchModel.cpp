@@ -27,6 +27,8 @@
 #include <quentier/utility/Compat.h>
 #include <quentier/utility/UidGenerator.h>
 
+#include <QDataStream>
+
 #include <algorithm>
 #include <limits>
 
@@ -49,10 +51,9 @@ SavedSearchModel::SavedSearchModel(
     LocalStorageManagerAsync & localStorageManagerAsync,
     SavedSearchCache & cache, QObject * parent) :
     AbstractItemModel(account, parent),
-    m_cache(cache)
+    m_listSavedSearchesPagingPolicy(SAVED_SEARCH_LIST_LIMIT), m_cache(cache)
 {
     createConnections(localStorageManagerAsync);
-    requestSavedSearchesList();
 }
 
 SavedSearchModel::~SavedSearchModel() = default;
@@ -1195,20 +1196,28 @@ void SavedSearchModel::onListSavedSearchesComplete(
             << ", num found searches = " << foundSearches.size()
             << ", request id = " << requestId);
 
-    for (const auto & foundSearch: qAsConst(foundSearches)) {
-        onSavedSearchAddedOrUpdated(foundSearch);
-    }
-
     m_listSavedSearchesRequestId = QUuid();
-    if (!foundSearches.isEmpty()) {
+
+    bool hasMorePages = m_listSavedSearchesPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundSearches.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:saved_search",
-            "The number of found saved searches is "
-                << "greater than zero, requesting more saved searches from "
-                << "the local storage");
+            "The page of found saved searches is full, requesting more "
+                << "saved searches from the local storage");
 
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listSavedSearchesOffset += static_cast<size_t>(foundSearches.size());
         requestSavedSearchesList();
+    }
+
+    for (const auto & foundSearch: qAsConst(foundSearches)) {
+        onSavedSearchAddedOrUpdated(foundSearch);
+    }
+
+    if (hasMorePages) {
         return;
     }
 
@@ -1236,6 +1245,9 @@ void SavedSearchModel::onListSavedSearchesFailed(
             << ", request id = " << requestId);
 
     m_listSavedSearchesRequestId = QUuid();
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -1253,40 +1265,7 @@ void SavedSearchModel::onExpungeSavedSearchComplete(
         return;
     }
 
-    auto & localUidIndex = m_data.get<ByLocalUid>();
-    auto itemIt = localUidIndex.find(search.localUid());
-    if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-        QNDEBUG(
-            "model:saved_search",
-            "Expunged saved search was not found "
-                << "within the saved search model items: " << search);
-        return;
-    }
-
-    auto & index = m_data.get<ByIndex>();
-    auto indexIt = m_data.project<ByIndex>(itemIt);
-    if (Q_UNLIKELY(indexIt == index.end())) {
-        ErrorString error(
-            QT_TR_NOOP("Internal error: can't project the local uid index "
-                       "iterator to the random access index iterator within "
-                       "the saved searches model"));
-
-        QNWARNING("model:saved_search", error);
-        Q_EMIT notifyError(error);
-        return;
-    }
-
-    Q_EMIT aboutToRemoveSavedSearches();
-
-    int rowIndex = static_cast<int>(std::distance(index.begin(), indexIt));
-
-    beginRemoveRows(
-        indexForItem(m_pAllSavedSearchesRootItem), rowIndex, rowIndex);
-
-    Q_UNUSED(m_data.erase(indexIt))
-    endRemoveRows();
-
-    Q_EMIT removedSavedSearches();
+    removeItemByLocalUid(search.localUid());
 }
 
 void SavedSearchModel::onExpungeSavedSearchFailed(
@@ -1307,6 +1286,91 @@ void SavedSearchModel::onExpungeSavedSearchFailed(
     onSavedSearchAddedOrUpdated(search);
 }
 
+void SavedSearchModel::startListing()
+{
+    QNDEBUG("model:saved_search", "SavedSearchModel::startListing");
+
+    requestSavedSearchesList();
+}
+
+void SavedSearchModel::writeSnapshot(QDataStream & out) const
+{
+    QList<const SavedSearchItem *> items;
+    const auto & rowIndex = m_data.get<ByIndex>();
+    for (const auto & item: rowIndex) {
+        if (!m_savedSearchItemsNotYetInLocalStorageUids.contains(
+                item.localUid()))
+        {
+            items << &item;
+        }
+    }
+
+    out << static_cast<quint32>(items.size());
+    for (const auto * pItem: qAsConst(items)) {
+        out << pItem->localUid() << pItem->guid() << pItem->name()
+            << pItem->query() << pItem->isSynchronizable() << pItem->isDirty()
+            << pItem->isFavorited();
+    }
+}
+
+bool SavedSearchModel::readSnapshot(QDataStream & in, QStringList & localUids)
+{
+    quint32 numItems = 0;
+    in >> numItems;
+
+    QList<SavedSearchItem> items;
+    for (quint32 i = 0; i < numItems && in.status() == QDataStream::Ok; ++i) {
+        QString localUid;
+        QString guid;
+        QString name;
+        QString query;
+        bool isSynchronizable = false;
+        bool isDirty = false;
+        bool isFavorited = false;
+
+        in >> localUid >> guid >> name >> query >> isSynchronizable >>
+            isDirty >> isFavorited;
+
+        items << SavedSearchItem(
+            localUid, guid, name, query, isSynchronizable, isDirty,
+            isFavorited);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    checkAndCreateModelRootItems();
+    const auto parentIndex = indexForItem(m_pAllSavedSearchesRootItem);
+
+    // NOTE: restored saved searches are not put into the cache as items don't
+    // keep all the fields of saved searches
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & item: qAsConst(items)) {
+        if (localUidIndex.find(item.localUid()) != localUidIndex.end()) {
+            continue;
+        }
+
+        int row = rowForNewItem(item);
+
+        beginInsertRows(parentIndex, row, row);
+        auto insertionResult = localUidIndex.insert(item);
+        endInsertRows();
+
+        updateRandomAccessIndexWithRespectToSorting(*insertionResult.first);
+        localUids << item.localUid();
+    }
+
+    return true;
+}
+
+void SavedSearchModel::removeSnapshotItems(const QStringList & localUids)
+{
+    for (const auto & localUid: localUids) {
+        removeItemByLocalUid(localUid);
+    }
+}
+
 void SavedSearchModel::createConnections(
     LocalStorageManagerAsync & localStorageManagerAsync)
 {
@@ -1409,9 +1473,11 @@ void SavedSearchModel::requestSavedSearchesList()
             << "searches: offset = " << m_listSavedSearchesOffset
             << ", request id = " << m_listSavedSearchesRequestId);
 
+    size_t limit = m_listSavedSearchesPagingPolicy.onPageRequested();
+
     Q_EMIT listSavedSearches(
-        flags, SAVED_SEARCH_LIST_LIMIT, m_listSavedSearchesOffset, order,
-        direction, m_listSavedSearchesRequestId);
+        flags, limit, m_listSavedSearchesOffset, order, direction,
+        m_listSavedSearchesRequestId);
 }
 
 void SavedSearchModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
@@ -1419,6 +1485,7 @@ void SavedSearchModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
     auto & rowIndex = m_data.get<ByIndex>();
     auto & localUidIndex = m_data.get<ByLocalUid>();
 
+    confirmSnapshotItem(search.localUid());
     m_cache.put(search.localUid(), search);
 
     SavedSearchItem item(search.localUid());
@@ -1579,6 +1646,49 @@ QString SavedSearchModel::nameForNewSavedSearch() const
         nameIndex, m_lastNewSavedSearchNameCounter, baseName);
 }
 
+void SavedSearchModel::removeItemByLocalUid(const QString & localUid)
+{
+    QNTRACE(
+        "model:saved_search",
+        "SavedSearchModel::removeItemByLocalUid: " << localUid);
+
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto itemIt = localUidIndex.find(localUid);
+    if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+        QNDEBUG(
+            "model:saved_search",
+            "Saved search to remove was not found "
+                << "within the saved search model items: local uid = "
+                << localUid);
+        return;
+    }
+
+    auto & index = m_data.get<ByIndex>();
+    auto indexIt = m_data.project<ByIndex>(itemIt);
+    if (Q_UNLIKELY(indexIt == index.end())) {
+        ErrorString error(
+            QT_TR_NOOP("Internal error: can't project the local uid index "
+                       "iterator to the random access index iterator within "
+                       "the saved searches model"));
+
+        QNWARNING("model:saved_search", error);
+        Q_EMIT notifyError(error);
+        return;
+    }
+
+    Q_EMIT aboutToRemoveSavedSearches();
+
+    int rowIndex = static_cast<int>(std::distance(index.begin(), indexIt));
+
+    beginRemoveRows(
+        indexForItem(m_pAllSavedSearchesRootItem), rowIndex, rowIndex);
+
+    Q_UNUSED(m_data.erase(indexIt))
+    endRemoveRows();
+
+    Q_EMIT removedSavedSearches();
+}
+
 int SavedSearchModel::rowForNewItem(const SavedSearchItem & newItem) const
 {
     if (m_sortedColumn != Column::Name) {
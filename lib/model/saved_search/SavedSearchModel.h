@@ -25,6 +25,7 @@
 #include "SavedSearchItem.h"
 
 #include <lib/model/common/AbstractItemModel.h>
+#include <lib/model/common/ListPagingPolicy.h>
 
 #include <quentier/local_storage/LocalStorageManagerAsync.h>
 #include <quentier/types/Account.h>
@@ -296,6 +297,15 @@ private Q_SLOTS:
         SavedSearch search, ErrorString errorDescription, QUuid requestId);
 
 private:
+    // AbstractItemModel interface
+    virtual void startListing() override;
+    virtual void writeSnapshot(QDataStream & out) const override;
+
+    virtual bool readSnapshot(
+        QDataStream & in, QStringList & localUids) override;
+
+    virtual void removeSnapshotItems(const QStringList & localUids) override;
+
     void createConnections(LocalStorageManagerAsync & localStorageManagerAsync);
     void requestSavedSearchesList();
 
@@ -307,6 +317,8 @@ private:
 
     QString nameForNewSavedSearch() const;
 
+    void removeItemByLocalUid(const QString & localUid);
+
     // Returns the appropriate row before which the new item should be inserted
     // according to the current sorting criteria and column
     int rowForNewItem(const SavedSearchItem & newItem) const;
@@ -377,6 +389,7 @@ private:
     IndexId m_allSavedSearchesRootItemIndexId = 1;
 
     size_t m_listSavedSearchesOffset = 0;
+    ListPagingPolicy m_listSavedSearchesPagingPolicy;
     QUuid m_listSavedSearchesRequestId;
     QSet<QUuid> m_savedSearchItemsNotYetInLocalStorageUids;
 
@@ -30,15 +30,25 @@
 #include <QByteArray>
 #include <QDataStream>
 #include <QMimeData>
+#include <QTimerEvent>
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 #include <vector>
 
 // Limit for the queries to the local storage
 #define TAG_LIST_LIMIT             (100)
 #define LINKED_NOTEBOOK_LIST_LIMIT (40)
 
+// Note counts for all tags are re-requested once no changes requiring that
+// occur within this interval
+#define NOTE_COUNTS_REFRESH_QUIET_PERIOD_MSEC (1000)
+
+// Continuous changes don't postpone the refresh of note counts for longer
+// than this
+#define NOTE_COUNTS_REFRESH_MAX_DELAY_MSEC (5000)
+
 #define NUM_TAG_MODEL_COLUMNS (5)
 
 #define REPORT_ERROR(error, ...)                                               \
@@ -58,12 +68,10 @@ TagModel::TagModel(
     LocalStorageManagerAsync & localStorageManagerAsync, TagCache & cache,
     QObject * parent) :
     AbstractItemModel(account, parent),
-    m_cache(cache)
+    m_cache(cache), m_listTagsPagingPolicy(TAG_LIST_LIMIT),
+    m_listLinkedNotebooksPagingPolicy(LINKED_NOTEBOOK_LIST_LIMIT)
 {
     createConnections(localStorageManagerAsync);
-
-    requestTagsList();
-    requestLinkedNotebooksList();
 }
 
 TagModel::~TagModel()
@@ -77,6 +85,29 @@ bool TagModel::allTagsListed() const
     return m_allTagsListed && m_allLinkedNotebooksListed;
 }
 
+int TagModel::noteCountForTag(const QString & tagLocalUid) const
+{
+    if (!allTagsListed()) {
+        return -1;
+    }
+
+    // Note counts kept by the model are not reliable while their refresh is
+    // either in flight or scheduled
+    if (!m_noteCountsPerAllTagsRequestId.isNull() ||
+        m_noteCountsRefreshTimer.isActive())
+    {
+        return -1;
+    }
+
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    auto it = localUidIndex.find(tagLocalUid);
+    if (it == localUidIndex.end()) {
+        return -1;
+    }
+
+    return it->noteCount();
+}
+
 void TagModel::favoriteTag(const QModelIndex & index)
 {
     QNDEBUG(
@@ -1010,13 +1041,9 @@ bool TagModel::removeRows(int row, int count, const QModelIndex & parent)
 
         auto it = localUidIndex.find(pTagItem->localUid());
         if (it != localUidIndex.end()) {
+            releaseIdForItem(*it);
             Q_UNUSED(localUidIndex.erase(it))
         }
-
-        auto indexIt = m_indexIdToLocalUidBimap.right.find(tag.localUid());
-        if (indexIt != m_indexIdToLocalUidBimap.right.end()) {
-            Q_UNUSED(m_indexIdToLocalUidBimap.right.erase(indexIt))
-        }
     }
     endRemoveRows();
 
@@ -1066,39 +1093,13 @@ void TagModel::sort(int column, Qt::SortOrder order)
 
     checkAndCreateModelRootItems();
 
-    Q_EMIT layoutAboutToBeChanged();
-
-    if (m_sortOrder == Qt::AscendingOrder) {
-        auto & localUidIndex = m_data.get<ByLocalUid>();
-        for (auto & item: localUidIndex) {
-            const_cast<TagItem &>(item).sortChildren(LessByName());
-        }
-
-        for (auto it = m_linkedNotebookItems.begin();
-             it != m_linkedNotebookItems.end(); ++it)
-        {
-            it.value().sortChildren(LessByName());
-        }
-
-        m_pAllTagsRootItem->sortChildren(LessByName());
-    }
-    else {
-        auto & localUidIndex = m_data.get<ByLocalUid>();
-        for (auto & item: localUidIndex) {
-            const_cast<TagItem &>(item).sortChildren(GreaterByName());
-        }
-
-        for (auto it = m_linkedNotebookItems.begin();
-             it != m_linkedNotebookItems.end(); ++it)
-        {
-            it.value().sortChildren(GreaterByName());
-        }
+    Q_EMIT layoutAboutToBeChanged(
+        QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
-        m_pAllTagsRootItem->sortChildren(GreaterByName());
-    }
+    sortItems();
 
-    updatePersistentModelIndices();
-    Q_EMIT layoutChanged();
+    Q_EMIT layoutChanged(
+        QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
     QNDEBUG("model:tag", "Successfully sorted the tag model");
 }
@@ -1321,7 +1322,10 @@ void TagModel::onAddTagComplete(Tag tag, QUuid requestId)
     }
 
     onTagAddedOrUpdated(tag);
-    requestNoteCountForTag(tag);
+
+    // The new tag might be one of many tags being added during the sync so
+    // its note count is requested along with other tags' counts
+    scheduleNoteCountsRefresh();
 }
 
 void TagModel::onAddTagFailed(
@@ -1514,19 +1518,28 @@ void TagModel::onListTagsComplete(
             << ", num found tags = " << tags.size()
             << ", request id = " << requestId);
 
-    for (const auto & tag: qAsConst(tags)) {
-        onTagAddedOrUpdated(tag);
-    }
-
     m_listTagsRequestId = QUuid();
 
-    if (!tags.isEmpty()) {
+    bool hasMorePages = m_listTagsPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(tags.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:tag",
-            "The number of found tags is greater than zero, "
-                << "requesting more tags from the local storage");
+            "The page of found tags is full, requesting more tags from "
+                << "the local storage");
+
+        // The next page is requested before processing the current one so
+        // that the local storage can prepare it in the meantime
         m_listTagsOffset += static_cast<size_t>(tags.size());
         requestTagsList();
+    }
+
+    for (const auto & tag: qAsConst(tags)) {
+        onTagAddedOrUpdated(tag);
+    }
+
+    if (hasMorePages) {
         return;
     }
 
@@ -1561,6 +1574,9 @@ void TagModel::onListTagsFailed(
             << ", request id = " << requestId);
 
     m_listTagsRequestId = QUuid();
+    // The restored items which haven't been listed yet can't be confirmed
+    removeUnconfirmedSnapshotItems();
+
     Q_EMIT notifyError(errorDescription);
 }
 
@@ -1605,53 +1621,6 @@ void TagModel::onExpungeTagFailed(
     onTagAddedOrUpdated(tag);
 }
 
-void TagModel::onGetNoteCountPerTagComplete(
-    int noteCount, Tag tag, LocalStorageManager::NoteCountOptions options,
-    QUuid requestId)
-{
-    Q_UNUSED(options)
-
-    auto it = m_noteCountPerTagRequestIds.find(requestId);
-    if (it == m_noteCountPerTagRequestIds.end()) {
-        return;
-    }
-
-    QNTRACE(
-        "model:tag",
-        "TagModel::onGetNoteCountPerTagComplete: tag = "
-            << tag << "\nRequest id = " << requestId
-            << ", note count = " << noteCount);
-
-    Q_UNUSED(m_noteCountPerTagRequestIds.erase(it))
-    setNoteCountForTag(tag.localUid(), noteCount);
-}
-
-void TagModel::onGetNoteCountPerTagFailed(
-    ErrorString errorDescription, Tag tag,
-    LocalStorageManager::NoteCountOptions options, QUuid requestId)
-{
-    Q_UNUSED(options)
-
-    auto it = m_noteCountPerTagRequestIds.find(requestId);
-    if (it == m_noteCountPerTagRequestIds.end()) {
-        return;
-    }
-
-    QNDEBUG(
-        "model:tag",
-        "TagModel::onGetNoteCountPerTagFailed: "
-            << "error description = " << errorDescription << ", tag = " << tag
-            << ", request id = " << requestId);
-
-    Q_UNUSED(m_noteCountPerTagRequestIds.erase(it))
-
-    ErrorString error(QT_TR_NOOP("Failed to get note count for one of tags"));
-    error.appendBase(errorDescription.base());
-    error.appendBase(errorDescription.additionalBases());
-    error.details() = errorDescription.details();
-    Q_EMIT notifyError(error);
-}
-
 void TagModel::onGetNoteCountsPerAllTagsComplete(
     QHash<QString, int> noteCountsPerTagLocalUid,
     LocalStorageManager::NoteCountOptions options, QUuid requestId)
@@ -1832,7 +1801,7 @@ void TagModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 
     // Notes from this notebook have been expunged along with it; need to
     // re-request the number of notes per tag for all tags
-    requestNoteCountsPerAllTags();
+    scheduleNoteCountsRefresh();
 
     if (!notebook.hasLinkedNotebookGuid()) {
         return;
@@ -1885,12 +1854,7 @@ void TagModel::onAddNoteComplete(Note note, QUuid requestId)
         return;
     }
 
-    const auto & tagLocalUids = note.tagLocalUids();
-    for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
-        Tag dummy;
-        dummy.setLocalUid(tagLocalUid);
-        requestNoteCountForTag(dummy);
-    }
+    adjustNoteCountsForTags(note.tagLocalUids(), 1);
 }
 
 void TagModel::onNoteTagListChanged(
@@ -1908,57 +1872,22 @@ void TagModel::onNoteTagListChanged(
     std::sort(previousNoteTagLocalUids.begin(), previousNoteTagLocalUids.end());
     std::sort(newNoteTagLocalUids.begin(), newNoteTagLocalUids.end());
 
-    std::vector<QString> commonTagLocalUids;
+    QStringList removedTagLocalUids;
 
-    std::set_intersection(
+    std::set_difference(
         previousNoteTagLocalUids.begin(), previousNoteTagLocalUids.end(),
         newNoteTagLocalUids.begin(), newNoteTagLocalUids.end(),
-        std::back_inserter(commonTagLocalUids));
-
-    auto & localUidIndex = m_data.get<ByLocalUid>();
+        std::back_inserter(removedTagLocalUids));
 
-    for (const auto & tagLocalUid: qAsConst(previousNoteTagLocalUids)) {
-        auto commonIt = std::find(
-            commonTagLocalUids.begin(), commonTagLocalUids.end(), tagLocalUid);
+    QStringList addedTagLocalUids;
 
-        if (commonIt != commonTagLocalUids.end()) {
-            continue;
-        }
-
-        auto itemIt = localUidIndex.find(tagLocalUid);
-        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-            // Probably this tag was expunged
-            QNDEBUG(
-                "model:tag", "No tag was found in the model: " << tagLocalUid);
-            continue;
-        }
-
-        int noteCount = itemIt->noteCount();
-        --noteCount;
-        noteCount = std::max(0, noteCount);
-        setNoteCountForTag(tagLocalUid, noteCount);
-    }
-
-    for (const auto & tagLocalUid: qAsConst(newNoteTagLocalUids)) {
-        auto commonIt = std::find(
-            commonTagLocalUids.begin(), commonTagLocalUids.end(), tagLocalUid);
-
-        if (commonIt != commonTagLocalUids.end()) {
-            continue;
-        }
-
-        auto itemIt = localUidIndex.find(tagLocalUid);
-        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-            // Probably this tag was expunged
-            QNDEBUG(
-                "model:tag", "No tag was found in the model: " << tagLocalUid);
-            continue;
-        }
+    std::set_difference(
+        newNoteTagLocalUids.begin(), newNoteTagLocalUids.end(),
+        previousNoteTagLocalUids.begin(), previousNoteTagLocalUids.end(),
+        std::back_inserter(addedTagLocalUids));
 
-        int noteCount = itemIt->noteCount();
-        ++noteCount;
-        setNoteCountForTag(tagLocalUid, noteCount);
-    }
+    adjustNoteCountsForTags(removedTagLocalUids, -1);
+    adjustNoteCountsForTags(addedTagLocalUids, 1);
 }
 
 void TagModel::onExpungeNoteComplete(Note note, QUuid requestId)
@@ -1968,19 +1897,18 @@ void TagModel::onExpungeNoteComplete(Note note, QUuid requestId)
         "TagModel::onExpungeNoteComplete: note = " << note << "\nRequest id = "
                                                    << requestId);
 
-    if (note.hasTagLocalUids()) {
-        const auto & tagLocalUids = note.tagLocalUids();
-        for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
-            Tag tag;
-            tag.setLocalUid(tagLocalUid);
-            requestNoteCountForTag(tag);
-        }
-
+    // NOTE: the expunged note might have been a deleted one which didn't
+    // contribute to note counts of its tags
+    if (note.hasTagLocalUids() && !note.hasDeletionTimestamp()) {
+        adjustNoteCountsForTags(note.tagLocalUids(), -1);
         return;
     }
 
-    QNDEBUG("model:tag", "Note has no tag local uids");
-    requestNoteCountsPerAllTags();
+    QNDEBUG(
+        "model:tag",
+        "Can't adjust note counts for tags of the expunged note, "
+            << "scheduling the refresh of note counts for all tags");
+    scheduleNoteCountsRefresh();
 }
 
 void TagModel::onAddLinkedNotebookComplete(
@@ -2053,15 +1981,9 @@ void TagModel::onExpungeLinkedNotebookComplete(
             }
         }
 
+        releaseIdForItem(*pModelItem);
         Q_UNUSED(m_linkedNotebookItems.erase(linkedNotebookItemIt))
     }
-
-    auto indexIt =
-        m_indexIdToLinkedNotebookGuidBimap.right.find(linkedNotebookGuid);
-
-    if (indexIt != m_indexIdToLinkedNotebookGuidBimap.right.end()) {
-        Q_UNUSED(m_indexIdToLinkedNotebookGuidBimap.right.erase(indexIt))
-    }
 }
 
 void TagModel::onListAllTagsPerNoteComplete(
@@ -2083,9 +2005,15 @@ void TagModel::onListAllTagsPerNoteComplete(
             << ", order direction = " << orderDirection
             << ", request id = " << requestId);
 
+    Q_UNUSED(m_listTagsPerNoteRequestIds.erase(it))
+
+    QStringList tagLocalUids;
+    tagLocalUids.reserve(foundTags.size());
     for (const auto & foundTag: qAsConst(foundTags)) {
-        requestNoteCountForTag(foundTag);
+        tagLocalUids << foundTag.localUid();
     }
+
+    adjustNoteCountsForTags(tagLocalUids, 1);
 }
 
 void TagModel::onListAllTagsPerNoteFailed(
@@ -2107,9 +2035,11 @@ void TagModel::onListAllTagsPerNoteFailed(
             << ", order direction = " << orderDirection << ", request id = "
             << requestId << ", error description = " << errorDescription);
 
+    Q_UNUSED(m_listTagsPerNoteRequestIds.erase(it))
+
     // Trying to work around this problem by re-requesting the note count for
     // all tags
-    requestNoteCountsPerAllTags();
+    scheduleNoteCountsRefresh();
 }
 
 void TagModel::onListAllLinkedNotebooksComplete(
@@ -2129,23 +2059,28 @@ void TagModel::onListAllLinkedNotebooksComplete(
             << ", order direction = " << orderDirection
             << ", request id = " << requestId);
 
-    for (const auto & foundLinkedNotebook: qAsConst(foundLinkedNotebooks)) {
-        onLinkedNotebookAddedOrUpdated(foundLinkedNotebook);
-    }
-
     m_listLinkedNotebooksRequestId = QUuid();
 
-    if (!foundLinkedNotebooks.isEmpty()) {
+    bool hasMorePages = m_listLinkedNotebooksPagingPolicy.onPageReceived(
+        limit, static_cast<size_t>(foundLinkedNotebooks.size()));
+
+    if (hasMorePages) {
         QNTRACE(
             "model:tag",
-            "The number of found linked notebooks is not "
-                << "empty, requesting more linked notebooks from the local "
-                << "storage");
+            "The page of found linked notebooks is full, requesting more "
+                << "linked notebooks from the local storage");
 
         m_listLinkedNotebooksOffset +=
             static_cast<size_t>(foundLinkedNotebooks.size());
 
         requestLinkedNotebooksList();
+    }
+
+    for (const auto & foundLinkedNotebook: qAsConst(foundLinkedNotebooks)) {
+        onLinkedNotebookAddedOrUpdated(foundLinkedNotebook);
+    }
+
+    if (hasMorePages) {
         return;
     }
 
@@ -2180,6 +2115,179 @@ void TagModel::onListAllLinkedNotebooksFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
+void TagModel::startListing()
+{
+    QNDEBUG("model:tag", "TagModel::startListing");
+
+    requestTagsList();
+    requestLinkedNotebooksList();
+
+    const auto linkedNotebookGuids =
+        m_linkedNotebookGuidsPendingRestrictionsRequest;
+
+    m_linkedNotebookGuidsPendingRestrictionsRequest.clear();
+
+    for (const auto & linkedNotebookGuid: linkedNotebookGuids) {
+        requestLinkedNotebookRestrictions(linkedNotebookGuid);
+    }
+}
+
+void TagModel::writeSnapshot(QDataStream & out) const
+{
+    QHash<QString, QString> linkedNotebookUsernamesByGuids;
+    for (auto it = m_linkedNotebookItems.constBegin(),
+              end = m_linkedNotebookItems.constEnd();
+         it != end; ++it)
+    {
+        linkedNotebookUsernamesByGuids[it.key()] = it.value().username();
+    }
+
+    out << linkedNotebookUsernamesByGuids;
+
+    // Parent tags are written before their children so that on reading each
+    // tag can be put right under its parent
+    QList<const TagItem *> tagItems;
+    tagItems.reserve(static_cast<int>(m_data.size()));
+
+    QVector<const ITagModelItem *> items;
+    if (m_pInvisibleRootItem) {
+        items << m_pInvisibleRootItem;
+    }
+
+    while (!items.isEmpty()) {
+        const auto * pItem = items.takeLast();
+
+        const auto * pTagItem = pItem->cast<TagItem>();
+        if (pTagItem) {
+            if (m_tagItemsNotYetInLocalStorageUids.contains(
+                    pTagItem->localUid()))
+            {
+                continue;
+            }
+
+            tagItems << pTagItem;
+        }
+
+        const auto children = pItem->children();
+        for (const auto * pChildItem: children) {
+            if (pChildItem) {
+                items << pChildItem;
+            }
+        }
+    }
+
+    out << static_cast<quint32>(tagItems.size());
+    for (const auto * pTagItem: qAsConst(tagItems)) {
+        out << pTagItem->localUid() << pTagItem->guid()
+            << pTagItem->linkedNotebookGuid() << pTagItem->name()
+            << pTagItem->parentLocalUid() << pTagItem->parentGuid()
+            << static_cast<qint32>(pTagItem->noteCount())
+            << pTagItem->isSynchronizable() << pTagItem->isDirty()
+            << pTagItem->isFavorited();
+    }
+}
+
+bool TagModel::readSnapshot(QDataStream & in, QStringList & localUids)
+{
+    QHash<QString, QString> linkedNotebookUsernamesByGuids;
+    in >> linkedNotebookUsernamesByGuids;
+
+    quint32 numItems = 0;
+    in >> numItems;
+
+    QList<std::pair<Tag, qint32>> tagsWithNoteCounts;
+    for (quint32 i = 0; i < numItems && in.status() == QDataStream::Ok; ++i) {
+        QString localUid;
+        QString guid;
+        QString linkedNotebookGuid;
+        QString name;
+        QString parentLocalUid;
+        QString parentGuid;
+        qint32 noteCount = 0;
+        bool isSynchronizable = false;
+        bool isDirty = false;
+        bool isFavorited = false;
+
+        in >> localUid >> guid >> linkedNotebookGuid >> name >>
+            parentLocalUid >> parentGuid >> noteCount >> isSynchronizable >>
+            isDirty >> isFavorited;
+
+        Tag tag;
+        tag.setLocalUid(localUid);
+
+        if (!guid.isEmpty()) {
+            tag.setGuid(guid);
+        }
+
+        if (!linkedNotebookGuid.isEmpty()) {
+            tag.setLinkedNotebookGuid(linkedNotebookGuid);
+        }
+
+        if (!parentLocalUid.isEmpty()) {
+            tag.setParentLocalUid(parentLocalUid);
+        }
+
+        if (!parentGuid.isEmpty()) {
+            tag.setParentGuid(parentGuid);
+        }
+
+        tag.setName(name);
+        tag.setLocal(!isSynchronizable);
+        tag.setDirty(isDirty);
+        tag.setFavorited(isFavorited);
+
+        tagsWithNoteCounts << std::make_pair(tag, noteCount);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    for (auto it = linkedNotebookUsernamesByGuids.constBegin(),
+              end = linkedNotebookUsernamesByGuids.constEnd();
+         it != end; ++it)
+    {
+        LinkedNotebook linkedNotebook;
+        linkedNotebook.setGuid(it.key());
+        linkedNotebook.setUsername(it.value());
+        onLinkedNotebookAddedOrUpdated(linkedNotebook);
+    }
+
+    // NOTE: restored tags are deliberately not put into the cache as they
+    // lack the fields which the model doesn't keep
+    auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & pair: qAsConst(tagsWithNoteCounts)) {
+        const auto & tag = pair.first;
+        if (localUidIndex.find(tag.localUid()) != localUidIndex.end()) {
+            continue;
+        }
+
+        onTagAdded(tag, nullptr);
+        localUids << tag.localUid();
+
+        auto itemIt = localUidIndex.find(tag.localUid());
+        if (itemIt != localUidIndex.end()) {
+            TagItem item(*itemIt);
+            item.setNoteCount(pair.second);
+            localUidIndex.replace(itemIt, item);
+        }
+    }
+
+    return true;
+}
+
+void TagModel::removeSnapshotItems(const QStringList & localUids)
+{
+    Q_EMIT aboutToRemoveTags();
+
+    // NOTE: child items of the removed ones are removed along with them
+    for (const auto & localUid: localUids) {
+        removeItemByLocalUid(localUid);
+    }
+
+    Q_EMIT removedTags();
+}
+
 void TagModel::createConnections(
     LocalStorageManagerAsync & localStorageManagerAsync)
 {
@@ -2211,10 +2319,6 @@ void TagModel::createConnections(
         this, &TagModel::findNotebook, &localStorageManagerAsync,
         &LocalStorageManagerAsync::onFindNotebookRequest);
 
-    QObject::connect(
-        this, &TagModel::requestNoteCountPerTag, &localStorageManagerAsync,
-        &LocalStorageManagerAsync::onGetNoteCountPerTagRequest);
-
     QObject::connect(
         this, &TagModel::requestNoteCountsForAllTags, &localStorageManagerAsync,
         &LocalStorageManagerAsync::onGetNoteCountsPerAllTagsRequest);
@@ -2270,16 +2374,6 @@ void TagModel::createConnections(
         &localStorageManagerAsync, &LocalStorageManagerAsync::expungeTagFailed,
         this, &TagModel::onExpungeTagFailed);
 
-    QObject::connect(
-        &localStorageManagerAsync,
-        &LocalStorageManagerAsync::getNoteCountPerTagComplete, this,
-        &TagModel::onGetNoteCountPerTagComplete);
-
-    QObject::connect(
-        &localStorageManagerAsync,
-        &LocalStorageManagerAsync::getNoteCountPerTagFailed, this,
-        &TagModel::onGetNoteCountPerTagFailed);
-
     QObject::connect(
         &localStorageManagerAsync,
         &LocalStorageManagerAsync::getNoteCountsPerAllTagsComplete, this,
@@ -2380,29 +2474,13 @@ void TagModel::requestTagsList()
         "Emitting the request to list tags: offset = "
             << m_listTagsOffset << ", request id = " << m_listTagsRequestId);
 
+    size_t limit = m_listTagsPagingPolicy.onPageRequested();
+
     Q_EMIT listTags(
-        flags, TAG_LIST_LIMIT, m_listTagsOffset, order, direction, {},
+        flags, limit, m_listTagsOffset, order, direction, {},
         m_listTagsRequestId);
 }
 
-void TagModel::requestNoteCountForTag(const Tag & tag)
-{
-    QNTRACE("model:tag", "TagModel::requestNoteCountForTag: " << tag);
-
-    QUuid requestId = QUuid::createUuid();
-    Q_UNUSED(m_noteCountPerTagRequestIds.insert(requestId))
-
-    QNTRACE(
-        "model:tag",
-        "Emitting the request to compute the number of notes "
-            << "per tag, request id = " << requestId);
-
-    LocalStorageManager::NoteCountOptions options(
-        LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
-
-    Q_EMIT requestNoteCountPerTag(tag, options, requestId);
-}
-
 void TagModel::requestTagsPerNote(const Note & note)
 {
     QNTRACE("model:tag", "TagModel::requestTagsPerNote: " << note);
@@ -2426,6 +2504,10 @@ void TagModel::requestNoteCountsPerAllTags()
 {
     QNTRACE("model:tag", "TagModel::requestNoteCountsPerAllTags");
 
+    // The request supersedes the scheduled one
+    m_noteCountsRefreshTimer.stop();
+    m_noteCountsRefreshPendingTimer.invalidate();
+
     m_noteCountsPerAllTagsRequestId = QUuid::createUuid();
 
     LocalStorageManager::NoteCountOptions options(
@@ -2435,6 +2517,86 @@ void TagModel::requestNoteCountsPerAllTags()
         options, m_noteCountsPerAllTagsRequestId);
 }
 
+void TagModel::adjustNoteCountsForTags(
+    const QStringList & tagLocalUids, const int delta)
+{
+    if (tagLocalUids.isEmpty()) {
+        return;
+    }
+
+    QNTRACE(
+        "model:tag",
+        "TagModel::adjustNoteCountsForTags: delta = "
+            << delta << ", tag local uids: "
+            << tagLocalUids.join(QStringLiteral(", ")));
+
+    if (!m_allTagsListed) {
+        QNTRACE(
+            "model:tag",
+            "Not all tags are listed yet, note counts for all tags "
+                << "would be requested after the listing");
+        return;
+    }
+
+    // If note counts for all tags are being requested or are about to be
+    // re-requested, it's unknown whether they would take the change into
+    // account so they need to be requested once again
+    if (!m_noteCountsPerAllTagsRequestId.isNull() ||
+        m_noteCountsRefreshTimer.isActive())
+    {
+        scheduleNoteCountsRefresh();
+        return;
+    }
+
+    const auto & localUidIndex = m_data.get<ByLocalUid>();
+    for (const auto & tagLocalUid: qAsConst(tagLocalUids)) {
+        auto itemIt = localUidIndex.find(tagLocalUid);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            // Probably this tag was expunged
+            QNDEBUG(
+                "model:tag", "No tag was found in the model: " << tagLocalUid);
+            continue;
+        }
+
+        int noteCount = std::max(0, itemIt->noteCount() + delta);
+        setNoteCountForTag(tagLocalUid, noteCount);
+    }
+}
+
+void TagModel::scheduleNoteCountsRefresh()
+{
+    if (!m_noteCountsRefreshPendingTimer.isValid()) {
+        m_noteCountsRefreshPendingTimer.start();
+    }
+
+    if (m_noteCountsRefreshTimer.isActive() &&
+        (m_noteCountsRefreshPendingTimer.elapsed() >=
+         NOTE_COUNTS_REFRESH_MAX_DELAY_MSEC))
+    {
+        return;
+    }
+
+    QNTRACE("model:tag", "Scheduling the refresh of note counts for all tags");
+
+    // Restarting the timer postpones the refresh until the quiet period
+    m_noteCountsRefreshTimer.start(NOTE_COUNTS_REFRESH_QUIET_PERIOD_MSEC, this);
+}
+
+void TagModel::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() != m_noteCountsRefreshTimer.timerId()) {
+        QAbstractItemModel::timerEvent(pEvent);
+        return;
+    }
+
+    QNDEBUG("model:tag", "Refreshing note counts for all tags");
+    requestNoteCountsPerAllTags();
+}
+
 void TagModel::requestLinkedNotebooksList()
 {
     QNTRACE("model:tag", "TagModel::requestLinkedNotebooksList");
@@ -2450,14 +2612,17 @@ void TagModel::requestLinkedNotebooksList()
             << "offset = " << m_listLinkedNotebooksOffset
             << ", request id = " << m_listLinkedNotebooksRequestId);
 
+    size_t limit = m_listLinkedNotebooksPagingPolicy.onPageRequested();
+
     Q_EMIT listAllLinkedNotebooks(
-        LINKED_NOTEBOOK_LIST_LIMIT, m_listLinkedNotebooksOffset, order,
-        direction, m_listLinkedNotebooksRequestId);
+        limit, m_listLinkedNotebooksOffset, order, direction,
+        m_listLinkedNotebooksRequestId);
 }
 
 void TagModel::onTagAddedOrUpdated(
     const Tag & tag, const QStringList * pTagNoteLocalUids)
 {
+    confirmSnapshotItem(tag.localUid());
     m_cache.put(tag.localUid(), tag);
 
     auto & localUidIndex = m_data.get<ByLocalUid>();
@@ -2898,96 +3063,60 @@ ITagModelItem * TagModel::itemForId(const IndexId id) const
         return m_pAllTagsRootItem;
     }
 
-    auto localUidIt = m_indexIdToLocalUidBimap.left.find(id);
-    if (localUidIt == m_indexIdToLocalUidBimap.left.end()) {
-        auto linkedNotebookGuidIt =
-            m_indexIdToLinkedNotebookGuidBimap.left.find(id);
-
-        if (linkedNotebookGuidIt ==
-            m_indexIdToLinkedNotebookGuidBimap.left.end()) {
-            QNDEBUG(
-                "model:tag",
-                "Found no tag model item corresponding to "
-                    << "model index internal id");
-
-            return nullptr;
-        }
-
-        const QString & linkedNotebookGuid = linkedNotebookGuidIt->second;
-        auto it = m_linkedNotebookItems.find(linkedNotebookGuid);
-        if (it == m_linkedNotebookItems.end()) {
-            QNDEBUG(
-                "model:tag",
-                "Found no tag linked notebook root model item "
-                    << "corresponding to the linked notebook guid "
-                    << "corresponding to model index internal id");
-
-            return nullptr;
-        }
+    if (id >= static_cast<IndexId>(m_itemsByIndexId.size())) {
+        QNDEBUG(
+            "model:tag",
+            "Found no tag model item corresponding to "
+                << "model index internal id");
 
-        return const_cast<TagLinkedNotebookRootItem *>(&(it.value()));
+        return nullptr;
     }
 
-    const QString & localUid = localUidIt->second;
-
-    QNTRACE(
-        "model:tag",
-        "Found tag local uid corresponding to model index "
-            << "internal id: " << localUid);
-
-    const auto & localUidIndex = m_data.get<ByLocalUid>();
-    auto it = localUidIndex.find(localUid);
-    if (it != localUidIndex.end()) {
-        return const_cast<TagItem *>(&(*it));
+    auto * pItem = m_itemsByIndexId[static_cast<size_t>(id)];
+    if (!pItem) {
+        QNTRACE(
+            "model:tag",
+            "The tag model item corresponding to model index internal id "
+                << "was removed from the model");
     }
 
-    QNTRACE(
-        "model:tag",
-        "Found no tag item corresponding to local uid " << localUid);
-
-    return nullptr;
+    return pItem;
 }
 
 TagModel::IndexId TagModel::idForItem(const ITagModelItem & item) const
 {
-    const auto * pTagItem = item.cast<TagItem>();
-    if (pTagItem) {
-        auto it = m_indexIdToLocalUidBimap.right.find(pTagItem->localUid());
-        if (it == m_indexIdToLocalUidBimap.right.end()) {
-            IndexId id = m_lastFreeIndexId++;
-            Q_UNUSED(m_indexIdToLocalUidBimap.insert(
-                IndexIdToLocalUidBimap::value_type(id, pTagItem->localUid())))
-            return id;
-        }
-
-        return it->second;
+    if (&item == m_pAllTagsRootItem) {
+        return m_allTagsRootItemIndexId;
     }
 
-    const auto * pLinkedNotebookItem = item.cast<TagLinkedNotebookRootItem>();
-    if (pLinkedNotebookItem) {
-        auto it = m_indexIdToLinkedNotebookGuidBimap.right.find(
-            pLinkedNotebookItem->linkedNotebookGuid());
-
-        if (it == m_indexIdToLinkedNotebookGuidBimap.right.end()) {
-            IndexId id = m_lastFreeIndexId++;
-            Q_UNUSED(m_indexIdToLinkedNotebookGuidBimap.insert(
-                IndexIdToLinkedNotebookGuidBimap::value_type(
-                    id, pLinkedNotebookItem->linkedNotebookGuid())))
-            return id;
-        }
+    auto it = m_indexIdsByItem.constFind(&item);
+    if (it != m_indexIdsByItem.constEnd()) {
+        return it.value();
+    }
 
-        return it->second;
+    if (!item.cast<TagItem>() && !item.cast<TagLinkedNotebookRootItem>()) {
+        QNWARNING(
+            "model:tag",
+            "Detected attempt to assign id to unidentified "
+                << "tag model item: " << item);
+        return 0;
     }
 
-    if (&item == m_pAllTagsRootItem) {
-        return m_allTagsRootItemIndexId;
+    auto id = static_cast<IndexId>(m_itemsByIndexId.size());
+    m_itemsByIndexId.push_back(const_cast<ITagModelItem *>(&item));
+    m_indexIdsByItem[&item] = id;
+    return id;
+}
+
+void TagModel::releaseIdForItem(const ITagModelItem & item)
+{
+    auto it = m_indexIdsByItem.find(&item);
+    if (it == m_indexIdsByItem.end()) {
+        return;
     }
 
-    QNWARNING(
-        "model:tag",
-        "Detected attempt to assign id to unidentified "
-            << "tag model item: " << item);
-    return 0;
+    m_itemsByIndexId[static_cast<size_t>(it.value())] = nullptr;
+    Q_UNUSED(m_indexIdsByItem.erase(it))
 }
 
 QVariant TagModel::dataImpl(
@@ -4068,11 +4197,7 @@ void TagModel::removeItemByLocalUid(const QString & localUid)
     Q_UNUSED(pParentItem->takeChild(row))
     endRemoveRows();
 
-    auto indexIt = m_indexIdToLocalUidBimap.right.find(itemIt->localUid());
-    if (indexIt != m_indexIdToLocalUidBimap.right.end()) {
-        Q_UNUSED(m_indexIdToLocalUidBimap.right.erase(indexIt))
-    }
-
+    releaseIdForItem(*itemIt);
     Q_UNUSED(localUidIndex.erase(itemIt))
 
     checkAndRemoveEmptyLinkedNotebookRootItem(*pParentItem);
@@ -4186,17 +4311,70 @@ void TagModel::updateItemRowWithRespectToSorting(ITagModelItem & item)
                                << "; item: " << item);
 }
 
-void TagModel::updatePersistentModelIndices()
+void TagModel::sortItems()
 {
-    QNTRACE("model:tag", "TagModel::updatePersistentModelIndices");
+    QNTRACE("model:tag", "TagModel::sortItems");
+
+    if (!m_pInvisibleRootItem) {
+        return;
+    }
+
+    // Each item's children are sorted only once, the rows permutations are
+    // kept to remap persistent model indices without looking up the rows
+    // of their items
+    QHash<const ITagModelItem *, QVector<int>> newRowsByParentItem;
+
+    QVector<ITagModelItem *> parentItems;
+    parentItems << m_pInvisibleRootItem;
+
+    while (!parentItems.isEmpty()) {
+        auto * pParentItem = parentItems.takeLast();
+
+        const auto children = pParentItem->children();
+        for (auto * pChildItem: children) {
+            if (pChildItem && pChildItem->hasChildren()) {
+                parentItems << pChildItem;
+            }
+        }
+
+        if (children.size() < 2) {
+            continue;
+        }
+
+        if (m_sortOrder == Qt::AscendingOrder) {
+            newRowsByParentItem[pParentItem] =
+                pParentItem->sortChildren(LessByName());
+        }
+        else {
+            newRowsByParentItem[pParentItem] =
+                pParentItem->sortChildren(GreaterByName());
+        }
+    }
 
-    // Ensure any persistent model indices would be updated appropriately
     auto indices = persistentIndexList();
+
+    QModelIndexList replacementIndices;
+    replacementIndices.reserve(indices.size());
+
     for (const auto & index: qAsConst(indices)) {
-        auto * pItem = itemForId(static_cast<IndexId>(index.internalId()));
-        QModelIndex replacementIndex = indexForItem(pItem);
-        changePersistentIndex(index, replacementIndex);
+        const auto * pItem =
+            itemForId(static_cast<IndexId>(index.internalId()));
+
+        const auto * pParentItem = (pItem ? pItem->parent() : nullptr);
+
+        auto it = newRowsByParentItem.constFind(pParentItem);
+        if ((it == newRowsByParentItem.constEnd()) ||
+            (index.row() >= it.value().size()))
+        {
+            replacementIndices << index;
+            continue;
+        }
+
+        replacementIndices << createIndex(
+            it.value().at(index.row()), index.column(), index.internalId());
     }
+
+    changePersistentIndexList(indices, replacementIndices);
 }
 
 void TagModel::updateTagInLocalStorage(const TagItem & item)
@@ -4482,15 +4660,9 @@ void TagModel::checkAndRemoveEmptyLinkedNotebookRootItem(
 
     QString linkedNotebookGuid = pLinkedNotebookItem->linkedNotebookGuid();
 
-    auto indexIt =
-        m_indexIdToLinkedNotebookGuidBimap.right.find(linkedNotebookGuid);
-
-    if (indexIt != m_indexIdToLinkedNotebookGuidBimap.right.end()) {
-        Q_UNUSED(m_indexIdToLinkedNotebookGuidBimap.right.erase(indexIt))
-    }
-
     auto linkedNotebookItemIt = m_linkedNotebookItems.find(linkedNotebookGuid);
     if (linkedNotebookItemIt != m_linkedNotebookItems.end()) {
+        releaseIdForItem(linkedNotebookItemIt.value());
         Q_UNUSED(m_linkedNotebookItems.erase(linkedNotebookItemIt))
     }
 }
@@ -4530,6 +4702,36 @@ void TagModel::checkAndFindLinkedNotebookRestrictions(const TagItem & tagItem)
         return;
     }
 
+    // No requests are sent to the local storage before the model is started
+    if (!isStarted()) {
+        QNTRACE(
+            "model:tag",
+            "The model is not started yet, postponing the request to find "
+                << "tag restrictions for linked notebook guid "
+                << linkedNotebookGuid);
+
+        Q_UNUSED(m_linkedNotebookGuidsPendingRestrictionsRequest.insert(
+            linkedNotebookGuid))
+
+        return;
+    }
+
+    requestLinkedNotebookRestrictions(linkedNotebookGuid);
+}
+
+void TagModel::requestLinkedNotebookRestrictions(
+    const QString & linkedNotebookGuid)
+{
+    // The restrictions might have been found or requested while the request
+    // was postponed
+    if (m_tagRestrictionsByLinkedNotebookGuid.contains(linkedNotebookGuid) ||
+        (m_findNotebookRequestForLinkedNotebookGuid.left.find(
+             linkedNotebookGuid) !=
+         m_findNotebookRequestForLinkedNotebookGuid.left.end()))
+    {
+        return;
+    }
+
     auto requestId = QUuid::createUuid();
 
     m_findNotebookRequestForLinkedNotebookGuid.insert(
@@ -4704,7 +4906,7 @@ bool TagModel::LessByName::operator()(
     QString rhsName;
     MODEL_ITEM_NAME(rhs, rhsName)
 
-    return (lhsName.localeAwareCompare(rhsName) <= 0);
+    return (lhsName.localeAwareCompare(rhsName) < 0);
 }
 
 bool TagModel::LessByName::operator()(
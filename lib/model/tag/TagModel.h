@@ -26,6 +26,7 @@
 #include "TagLinkedNotebookRootItem.h"
 
 #include <lib/model/common/AbstractItemModel.h>
+#include <lib/model/common/ListPagingPolicy.h>
 
 #include <quentier/local_storage/LocalStorageManagerAsync.h>
 #include <quentier/types/Account.h>
@@ -35,6 +36,8 @@
 #include <quentier/utility/SuppressWarnings.h>
 
 #include <QAbstractItemModel>
+#include <QBasicTimer>
+#include <QElapsedTimer>
 #include <QHash>
 #include <QSet>
 #include <QStringList>
@@ -51,6 +54,8 @@ MSVC_SUPPRESS_WARNING(4834)
 
 RESTORE_WARNINGS
 
+#include <vector>
+
 #define TAG_MODEL_MIME_TYPE                                                    \
     QStringLiteral("application/x-com.quentier.tagmodeldatalist")
 
@@ -201,6 +206,18 @@ public:
      */
     bool allTagsListed() const;
 
+    /**
+     * @brief noteCountForTag - provides the number of notes per tag kept by
+     * the model
+     *
+     * @param tagLocalUid           The local uid of the tag which note count
+     *                              is required
+     * @return                      The number of notes labeled with the tag or
+     *                              -1 if the tag is not within the model or its
+     *                              note count is not known yet
+     */
+    int noteCountForTag(const QString & tagLocalUid) const;
+
     /**
      * @brief favoriteTag - marks the tag pointed to by the index as favorited
      *
@@ -373,10 +390,6 @@ Q_SIGNALS:
     void expungeTag(Tag tag, QUuid requestId);
     void findNotebook(Notebook notebook, QUuid requestId);
 
-    void requestNoteCountPerTag(
-        Tag tag, LocalStorageManager::NoteCountOptions options,
-        QUuid requestId);
-
     void requestNoteCountsForAllTags(
         LocalStorageManager::NoteCountOptions options, QUuid requestId);
 
@@ -426,14 +439,6 @@ private Q_SLOTS:
     void onExpungeTagFailed(
         Tag tag, ErrorString errorDescription, QUuid requestId);
 
-    void onGetNoteCountPerTagComplete(
-        int noteCount, Tag tag, LocalStorageManager::NoteCountOptions options,
-        QUuid requestId);
-
-    void onGetNoteCountPerTagFailed(
-        ErrorString errorDescription, Tag tag,
-        LocalStorageManager::NoteCountOptions options, QUuid requestId);
-
     void onGetNoteCountsPerAllTagsComplete(
         QHash<QString, int> noteCountsPerTagLocalUid,
         LocalStorageManager::NoteCountOptions options, QUuid requestId);
@@ -495,11 +500,37 @@ private Q_SLOTS:
         ErrorString errorDescription, QUuid requestId);
 
 private:
+    // AbstractItemModel interface
+    virtual void startListing() override;
+    virtual void writeSnapshot(QDataStream & out) const override;
+
+    virtual bool readSnapshot(
+        QDataStream & in, QStringList & localUids) override;
+
+    virtual void removeSnapshotItems(const QStringList & localUids) override;
+
     void createConnections(LocalStorageManagerAsync & localStorageManagerAsync);
     void requestTagsList();
-    void requestNoteCountForTag(const Tag & tag);
     void requestTagsPerNote(const Note & note);
     void requestNoteCountsPerAllTags();
+
+    /**
+     * @brief adjustNoteCountsForTags - applies the known change of the number
+     * of notes to note counts of tags; if the change can't be applied
+     * reliably (for example, because note counts for all tags are being
+     * requested at the moment), schedules the refresh of all note counts
+     */
+    void adjustNoteCountsForTags(
+        const QStringList & tagLocalUids, const int delta);
+
+    /**
+     * @brief scheduleNoteCountsRefresh - schedules requesting note counts for
+     * all tags after the quiet period without note changes affecting the tags
+     * so that a burst of changes results in a single request
+     */
+    void scheduleNoteCountsRefresh();
+
+    virtual void timerEvent(QTimerEvent * pEvent) override;
     void requestLinkedNotebooksList();
 
     QVariant dataImpl(const ITagModelItem & item, const Column column) const;
@@ -523,7 +554,15 @@ private:
         const ITagModelItem & parentItem, const ITagModelItem & newItem) const;
 
     void updateItemRowWithRespectToSorting(ITagModelItem & item);
-    void updatePersistentModelIndices();
+
+    /**
+     * @brief sortItems - sorts the children of each item within the model
+     * according to the current sort order and remaps persistent model indices
+     * through the resulting row permutations; must be called between
+     * layoutAboutToBeChanged and layoutChanged signals
+     */
+    void sortItems();
+
     void updateTagInLocalStorage(const TagItem & item);
 
     void tagFromItem(const TagItem & item, Tag & tag) const;
@@ -541,6 +580,8 @@ private:
 
     void checkAndFindLinkedNotebookRestrictions(const TagItem & tagItem);
 
+    void requestLinkedNotebookRestrictions(const QString & linkedNotebookGuid);
+
     bool tagItemMatchesByLinkedNotebook(
         const TagItem & item, const QString & linkedNotebookGuid) const;
 
@@ -589,9 +630,6 @@ private:
 
     using IndexId = quintptr;
 
-    using IndexIdToLocalUidBimap = boost::bimap<IndexId, QString>;
-    using IndexIdToLinkedNotebookGuidBimap = boost::bimap<IndexId, QString>;
-
     struct LessByName
     {
         bool operator()(
@@ -644,6 +682,12 @@ private:
     ITagModelItem * itemForId(const IndexId id) const;
     IndexId idForItem(const ITagModelItem & item) const;
 
+    /**
+     * @brief releaseIdForItem - invalidates the model index internal id
+     * assigned to the item which is about to be erased from the model
+     */
+    void releaseIdForItem(const ITagModelItem & item);
+
     void checkAndCreateModelRootItems();
 
 private:
@@ -658,11 +702,18 @@ private:
 
     LinkedNotebookItems m_linkedNotebookItems;
 
-    mutable IndexIdToLocalUidBimap m_indexIdToLocalUidBimap;
-    mutable IndexIdToLinkedNotebookGuidBimap m_indexIdToLinkedNotebookGuidBimap;
-    mutable IndexId m_lastFreeIndexId = 2;
+    // Model index internal ids are slots within this vector so the item
+    // corresponding to the model index is found without lookups by string
+    // keys. Slots of erased items are nulled and never reused so that stale
+    // model indexes can't point to other items. Ids 0 and 1 are reserved for
+    // invalid id and for all tags root item respectively.
+    mutable std::vector<ITagModelItem *> m_itemsByIndexId =
+        std::vector<ITagModelItem *>(2, nullptr);
+
+    mutable QHash<const ITagModelItem *, IndexId> m_indexIdsByItem;
 
     size_t m_listTagsOffset = 0;
+    ListPagingPolicy m_listTagsPagingPolicy;
     QUuid m_listTagsRequestId;
     QSet<QUuid> m_tagItemsNotYetInLocalStorageUids;
 
@@ -670,8 +721,9 @@ private:
     QSet<QUuid> m_updateTagRequestIds;
     QSet<QUuid> m_expungeTagRequestIds;
 
-    QSet<QUuid> m_noteCountPerTagRequestIds;
     QUuid m_noteCountsPerAllTagsRequestId;
+    QBasicTimer m_noteCountsRefreshTimer;
+    QElapsedTimer m_noteCountsRefreshPendingTimer;
 
     QSet<QUuid> m_findTagToRestoreFailedUpdateRequestIds;
     QSet<QUuid> m_findTagToPerformUpdateRequestIds;
@@ -681,6 +733,7 @@ private:
 
     QHash<QString, QString> m_linkedNotebookOwnerUsernamesByLinkedNotebookGuids;
     size_t m_listLinkedNotebooksOffset = 0;
+    ListPagingPolicy m_listLinkedNotebooksPagingPolicy;
     QUuid m_listLinkedNotebooksRequestId;
 
     Column m_sortedColumn = Column::Name;
@@ -700,6 +753,11 @@ private:
     LinkedNotebookGuidWithFindNotebookRequestIdBimap
         m_findNotebookRequestForLinkedNotebookGuid;
 
+    // Guids of linked notebooks of the tags restored from the snapshot before
+    // the model was started; their restrictions are requested from the local
+    // storage once the model is started
+    QSet<QString> m_linkedNotebookGuidsPendingRestrictionsRequest;
+
     mutable int m_lastNewTagNameCounter = 0;
     mutable QMap<QString, int> m_lastNewTagNameCounterByLinkedNotebookGuid;
 
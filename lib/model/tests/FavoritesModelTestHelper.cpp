@@ -317,6 +317,8 @@ void FavoritesModelTestHelper::test()
             account, *m_pLocalStorageManagerAsync, noteCache, notebookCache,
             tagCache, savedSearchCache, this);
 
+        model->start();
+
         ModelTest t1(model);
         Q_UNUSED(t1)
 
@@ -0,0 +1,584 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogViewerModelTestHelper.h"
+
+#include <lib/model/log_viewer/LogViewerModelLogFileIndexer.h>
+#include <lib/model/log_viewer/LogViewerModelLogFileParser.h>
+
+#include <quentier/utility/Compat.h>
+
+#include <QRegExp>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QTimeZone>
+
+// The regex based parsing of log file lines which the tokenizer of the log
+// file parser replaced; kept as the reference the parser is checked against
+#define REGEX_QNLOG_DATE                                                       \
+    "^(\\d{4}-\\d{2}-\\d{2}\\s+\\d{2}:\\d{2}:\\d{2}.\\d{1,17})(?:\\s+(\\w+))?"
+
+#define REGEX_QNLOG_SOURCE_LINENUMBER "([a-zA-Z0-9\\\\\\/_.]+):(\\d+)"
+
+#define REGEX_QNLOG_LINE                                                       \
+    REGEX_QNLOG_DATE                                                           \
+    "\\s+" REGEX_QNLOG_SOURCE_LINENUMBER                                       \
+    "\\s+"                                                                     \
+    "\\[(\\w+)\\]"                                                             \
+    "(?:\\s+\\[((?:\\w+|:|-|_)+)\\])?:\\s+(.+$)"
+
+// The number of log entries within the log file data indexed in parallel,
+// the data is large enough to be split into ranges for several threads
+#define LOG_VIEWER_MODEL_TEST_NUM_MULTILINE_LOG_ENTRIES 10000
+
+// The maximal number of threads indexing the log file data in parallel
+#define LOG_VIEWER_MODEL_TEST_MAX_INDEXER_THREAD_COUNT 8
+
+namespace quentier {
+
+namespace {
+
+bool parseLogLevelWithRegex(const QString & logLevel, LogLevel & result)
+{
+    if (logLevel == QStringLiteral("Trace")) {
+        result = LogLevel::Trace;
+    }
+    else if (logLevel == QStringLiteral("Debug")) {
+        result = LogLevel::Debug;
+    }
+    else if (logLevel == QStringLiteral("Info")) {
+        result = LogLevel::Info;
+    }
+    else if (logLevel == QStringLiteral("Warn")) {
+        result = LogLevel::Warning;
+    }
+    else if (logLevel == QStringLiteral("Error")) {
+        result = LogLevel::Error;
+    }
+    else {
+        return false;
+    }
+
+    return true;
+}
+
+void appendLogEntryLine(LogViewerModel::Data & data, const QString & line)
+{
+    if (!data.m_logEntry.isEmpty()) {
+        data.m_logEntry += QStringLiteral("\n");
+    }
+
+    data.m_logEntry += line;
+}
+
+bool parseLogFileDataWithRegex(
+    const QByteArray & data, const QVector<LogLevel> & disabledLogLevels,
+    const QRegExp & filterContentRegExp,
+    QVector<LogViewerModel::Data> & dataEntries,
+    ErrorString & errorDescription)
+{
+    QRegExp regex(
+        QStringLiteral(REGEX_QNLOG_LINE), Qt::CaseInsensitive, QRegExp::RegExp);
+
+    QStringList lines = QString::fromUtf8(data).split(QChar::fromLatin1('\n'));
+    if (!lines.isEmpty() && lines.back().isEmpty()) {
+        lines.pop_back();
+    }
+
+    bool lastEntryFiltered = true;
+    for (auto line: lines) {
+        if (line.endsWith(QChar::fromLatin1('\r'))) {
+            line.chop(1);
+        }
+
+        if (regex.indexIn(line) < 0) {
+            if (lastEntryFiltered || dataEntries.isEmpty()) {
+                continue;
+            }
+
+            auto & lastEntry = dataEntries.back();
+            appendLogEntryLine(lastEntry, line);
+
+            if (!filterContentRegExp.isEmpty() &&
+                (filterContentRegExp.indexIn(lastEntry.m_logEntry) >= 0))
+            {
+                dataEntries.pop_back();
+                lastEntryFiltered = true;
+            }
+
+            continue;
+        }
+
+        QStringList capturedTexts = regex.capturedTexts();
+
+        LogViewerModel::Data entry;
+        if (!parseLogLevelWithRegex(capturedTexts[5], entry.m_logLevel)) {
+            errorDescription.setBase(
+                QStringLiteral("Regex based parsing failed to parse "
+                               "the log level"));
+
+            errorDescription.details() = line;
+            return false;
+        }
+
+        if (disabledLogLevels.contains(entry.m_logLevel)) {
+            lastEntryFiltered = true;
+            continue;
+        }
+
+        if (!filterContentRegExp.isEmpty() && filterContentRegExp.isValid() &&
+            (filterContentRegExp.indexIn(capturedTexts[7]) < 0) &&
+            (filterContentRegExp.indexIn(capturedTexts[1]) < 0) &&
+            (filterContentRegExp.indexIn(capturedTexts[3]) < 0))
+        {
+            lastEntryFiltered = true;
+            continue;
+        }
+
+        entry.m_timestamp = QDateTime::fromString(
+            capturedTexts[1], QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"));
+
+        QTimeZone timezone(capturedTexts[2].toLocal8Bit());
+        if (timezone.isValid()) {
+            entry.m_timestamp.setTimeZone(timezone);
+        }
+
+        entry.m_sourceFileName = capturedTexts[3];
+        entry.m_sourceFileLineNumber = capturedTexts[4].toInt();
+        entry.m_component = capturedTexts[6];
+
+        appendLogEntryLine(entry, capturedTexts[7]);
+        dataEntries.push_back(entry);
+        lastEntryFiltered = false;
+    }
+
+    return true;
+}
+
+bool dataEntriesEqual(
+    const LogViewerModel::Data & lhs, const LogViewerModel::Data & rhs)
+{
+    return (lhs.m_timestamp == rhs.m_timestamp) &&
+        (lhs.m_timestamp.timeSpec() == rhs.m_timestamp.timeSpec()) &&
+        (lhs.m_timestamp.timeZone() == rhs.m_timestamp.timeZone()) &&
+        (lhs.m_sourceFileName == rhs.m_sourceFileName) &&
+        (lhs.m_sourceFileLineNumber == rhs.m_sourceFileLineNumber) &&
+        (lhs.m_component == rhs.m_component) &&
+        (lhs.m_logLevel == rhs.m_logLevel) &&
+        (lhs.m_logEntry == rhs.m_logEntry);
+}
+
+} // namespace
+
+LogViewerModelTestHelper::LogViewerModelTestHelper() :
+    m_pParser(new LogViewerModel::LogFileParser)
+{}
+
+LogViewerModelTestHelper::~LogViewerModelTestHelper() {}
+
+bool LogViewerModelTestHelper::checkLogFileParserMatchesRegex(
+    ErrorString & errorDescription)
+{
+    QByteArray data;
+
+    // Ordinary log entries with and without timezone and component
+    data += "2020-03-15 12:34:56.789 UTC lib/model/note/NoteModel.cpp:123 "
+            "[Debug] [model:note]: Note was updated\n";
+    data += "2020-03-15 12:34:56.790 src/main.cpp:7 [Info]: Started\n";
+    data += "2020-03-15 12:34:56.791 GMT lib/sync/SyncEngine.cpp:42 [Warn] "
+            "[sync-engine:remote_1]: Rate limit reached\n";
+    data += "2020-03-15 12:34:56.792 lib\\widget\\Widget.cpp:5 [Error] "
+            "[widget]: Failed\n";
+
+    // Word which is not a valid timezone name
+    data += "2020-03-15 12:34:56.793 NotATimeZone file.cpp:1 [Trace]: Text\n";
+
+    // Unusual separators and fractional seconds
+    data += "2020-03-15\t12:34:56,794\tfile.cpp:2\t[Info]:\tTabs\n";
+    data += "2020-03-15  12:34:56.7 file.cpp:3 [Info]: Short fraction\n";
+    data += "2020-03-15 12:34:56.12345678901234567 file.cpp:4 [Info]: "
+            "Long fraction\n";
+
+    // Component like text which is a part of the message
+    data += "2020-03-15 12:34:56.795 file.cpp:5 [Info]: [not a component]: "
+            "message\n";
+    data += "2020-03-15 12:34:56.796 file.cpp:6 [Info] [bad component]: "
+            "message\n";
+
+    // Multiline entries including empty lines and lines looking almost like
+    // log entry starts
+    data += "2020-03-15 12:34:56.797 file.cpp:7 [Debug] [multi]: First line\n";
+    data += "  second line\n";
+    data += "\n";
+    data += "2020-03-15 12:34:56.798 file.cpp [Info]: no line number\n";
+    data += "2020-03-15 12:34:56.798 file.cpp:8 Info: no brackets\n";
+    data += "2020-03-15 12:34 file.cpp:8 [Info]: short time\n";
+    data += "third line with CRLF\r\n";
+
+    // Whitespace only messages: a single whitespace character after the colon
+    // makes the line a continuation, more of them make the message
+    data += "2020-03-15 12:34:56.799 file.cpp:9 [Info]: \n";
+    data += "2020-03-15 12:34:56.800 file.cpp:10 [Info]:    \n";
+    data += "2020-03-15 12:34:56.801 file.cpp:11 [Info] [comp]: \t\n";
+    data += "continuation of whitespace only message\n";
+
+    // Non-ASCII characters within component and message
+    data += QString::fromUtf8(
+                "2020-03-15 12:34:56.802 file.cpp:12 [Info] [компонент]: "
+                "сообщение\n")
+                .toUtf8();
+
+    // Entries matching the content filters used below by message, timestamp
+    // or source file name and by continuation lines
+    data += "2020-03-15 12:34:56.804 needle.cpp:14 [Info]: File name\n";
+    data += "2020-03-15 12:34:56.805 file.cpp:15 [Debug] [comp]: The needle "
+            "within the message\n";
+    data += "continuation line\n";
+    data += "2020-03-15 12:34:56.806 file.cpp:16 [Warn]: No match\n";
+    data += "continuation line with a needle\n";
+    data += "2020-03-15 12:34:56.807 file.cpp:17 [Info]: A needle within both "
+            "lines\n";
+    data += "another needle line\n";
+    data += "2020-03-15 12:34:56.808 file.cpp:18 [Error] [comp]: Needle with "
+            "capital letter\n";
+
+    // Entry without the trailing line break at the end of the data
+    data += "2020-03-15 12:34:56.803 file.cpp:13 [Trace] [last]: Last entry";
+
+    struct FilteringOptions
+    {
+        QVector<LogLevel> m_disabledLogLevels;
+        QString m_logEntryContentFilter;
+    };
+
+    QVector<FilteringOptions> filteringOptionsList;
+    filteringOptionsList << FilteringOptions();
+
+    FilteringOptions disabledLogLevelsOptions;
+    disabledLogLevelsOptions.m_disabledLogLevels << LogLevel::Trace
+                                                 << LogLevel::Warning;
+
+    filteringOptionsList << disabledLogLevelsOptions;
+
+    // Plain text filters are matched against UTF-8 bytes of the log file
+    // lines without decoding them
+    QStringList plainTextFilters;
+    plainTextFilters << QStringLiteral("needle") << QStringLiteral("56.79")
+                     << QStringLiteral("Widget.cpp")
+                     << QString::fromUtf8("сообщение");
+
+    for (const auto & filter: qAsConst(plainTextFilters)) {
+        FilteringOptions plainTextFilterOptions;
+        plainTextFilterOptions.m_logEntryContentFilter = filter;
+        filteringOptionsList << plainTextFilterOptions;
+    }
+
+    QStringList wildcardFilters;
+    wildcardFilters << QStringLiteral("*needle*line*")
+                    << QStringLiteral("[Nn]eedle") << QStringLiteral("56.8?");
+
+    for (const auto & filter: qAsConst(wildcardFilters)) {
+        FilteringOptions wildcardFilterOptions;
+        wildcardFilterOptions.m_logEntryContentFilter = filter;
+        filteringOptionsList << wildcardFilterOptions;
+    }
+
+    FilteringOptions allFilteringOptions;
+    allFilteringOptions.m_disabledLogLevels << LogLevel::Debug;
+    allFilteringOptions.m_logEntryContentFilter = QStringLiteral("needle");
+    filteringOptionsList << allFilteringOptions;
+
+    for (const auto & filteringOptions: qAsConst(filteringOptionsList)) {
+        QRegExp filterContentRegExp(
+            filteringOptions.m_logEntryContentFilter, Qt::CaseSensitive,
+            QRegExp::Wildcard);
+
+        QVector<LogViewerModel::Data> expectedDataEntries;
+        bool res = parseLogFileDataWithRegex(
+            data, filteringOptions.m_disabledLogLevels, filterContentRegExp,
+            expectedDataEntries, errorDescription);
+
+        if (!res) {
+            return false;
+        }
+
+        QVector<LogViewerModel::Data> dataEntries;
+        QVector<qint64> entryStartPositions;
+        m_pParser->parseDataEntriesFromData(
+            data.constData(), data.constData() + data.size(), 0,
+            filteringOptions.m_disabledLogLevels, filterContentRegExp,
+            dataEntries, entryStartPositions);
+
+        QString filteringDetails = QStringLiteral("content filter = ") +
+            filteringOptions.m_logEntryContentFilter +
+            QStringLiteral(", num disabled log levels = ") +
+            QString::number(filteringOptions.m_disabledLogLevels.size()) +
+            QStringLiteral(": ");
+
+        if (dataEntries.size() != expectedDataEntries.size()) {
+            errorDescription.setBase(
+                QStringLiteral("The number of log entries parsed by the log "
+                               "file parser differs from the one parsed by "
+                               "regex"));
+
+            errorDescription.details() = filteringDetails +
+                QString::number(dataEntries.size()) + QStringLiteral(" vs ") +
+                QString::number(expectedDataEntries.size());
+
+            return false;
+        }
+
+        for (int i = 0, size = dataEntries.size(); i < size; ++i) {
+            if (!dataEntriesEqual(dataEntries[i], expectedDataEntries[i])) {
+                errorDescription.setBase(
+                    QStringLiteral("The log entry parsed by the log file "
+                                   "parser differs from the one parsed by "
+                                   "regex"));
+
+                errorDescription.details() = filteringDetails +
+                    dataEntries[i].toString() + QStringLiteral(" vs ") +
+                    expectedDataEntries[i].toString();
+
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool LogViewerModelTestHelper::checkParallelIndexingMatchesSequentialParsing(
+    ErrorString & errorDescription)
+{
+    QByteArray data = generateMultilineLogFileData(
+        LOG_VIEWER_MODEL_TEST_NUM_MULTILINE_LOG_ENTRIES);
+
+    QTemporaryFile logFile;
+    if (!logFile.open() || (logFile.write(data) != data.size()) ||
+        !logFile.flush())
+    {
+        errorDescription.setBase(
+            QStringLiteral("Failed to write the log file data to temporary "
+                           "file"));
+
+        errorDescription.details() = logFile.errorString();
+        return false;
+    }
+
+    struct FilteringOptions
+    {
+        QVector<LogLevel> m_disabledLogLevels;
+        QString m_logEntryContentFilter;
+    };
+
+    QVector<FilteringOptions> filteringOptionsList;
+    filteringOptionsList << FilteringOptions();
+
+    FilteringOptions disabledLogLevelsOptions;
+    disabledLogLevelsOptions.m_disabledLogLevels << LogLevel::Trace
+                                                 << LogLevel::Warning;
+
+    filteringOptionsList << disabledLogLevelsOptions;
+
+    // The filter matches both the first and the continuation lines of some
+    // log entries
+    FilteringOptions contentFilterOptions;
+    contentFilterOptions.m_logEntryContentFilter = QStringLiteral("needle");
+    filteringOptionsList << contentFilterOptions;
+
+    FilteringOptions allFilteringOptions;
+    allFilteringOptions.m_disabledLogLevels << LogLevel::Debug;
+
+    allFilteringOptions.m_logEntryContentFilter =
+        QStringLiteral("*needle*entry");
+
+    filteringOptionsList << allFilteringOptions;
+
+    for (const auto & filteringOptions: qAsConst(filteringOptionsList)) {
+        QVector<LogViewerModel::Data> dataEntries;
+        QVector<qint64> expectedEntryStartPositions;
+        m_pParser->parseDataEntriesFromData(
+            data.constData(), data.constData() + data.size(), 0,
+            filteringOptions.m_disabledLogLevels,
+            QRegExp(
+                filteringOptions.m_logEntryContentFilter, Qt::CaseSensitive,
+                QRegExp::Wildcard),
+            dataEntries, expectedEntryStartPositions);
+
+        QByteArray expectedEntryLogLevels;
+        for (const auto & dataEntry: qAsConst(dataEntries)) {
+            expectedEntryLogLevels.append(
+                static_cast<char>(dataEntry.m_logLevel));
+        }
+
+        QVector<qint64> entryStartPositions;
+        QByteArray entryLogLevels;
+        bool res = indexLogFile(
+            logFile.fileName(), LOG_VIEWER_MODEL_TEST_MAX_INDEXER_THREAD_COUNT,
+            filteringOptions.m_disabledLogLevels,
+            filteringOptions.m_logEntryContentFilter, entryStartPositions,
+            entryLogLevels, errorDescription);
+
+        if (!res) {
+            return false;
+        }
+
+        if ((entryStartPositions != expectedEntryStartPositions) ||
+            (entryLogLevels != expectedEntryLogLevels))
+        {
+            errorDescription.setBase(
+                QStringLiteral("The log entries found by parallel indexing "
+                               "differ from the ones found by sequential "
+                               "parsing"));
+
+            errorDescription.details() = QStringLiteral("content filter = ") +
+                filteringOptions.m_logEntryContentFilter +
+                QStringLiteral(", num disabled log levels = ") +
+                QString::number(filteringOptions.m_disabledLogLevels.size()) +
+                QStringLiteral(", num entries = ") +
+                QString::number(entryStartPositions.size()) +
+                QStringLiteral(" vs ") +
+                QString::number(expectedEntryStartPositions.size());
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int LogViewerModelTestHelper::parseLogFileData(const QByteArray & data)
+{
+    QVector<LogViewerModel::Data> dataEntries;
+    QVector<qint64> entryStartPositions;
+    m_pParser->parseDataEntriesFromData(
+        data.constData(), data.constData() + data.size(), 0,
+        QVector<LogLevel>(), QRegExp(), dataEntries, entryStartPositions);
+
+    return dataEntries.size();
+}
+
+QByteArray LogViewerModelTestHelper::generateLogFileData(const int numEntries)
+{
+    static const char * logLevels[] = {
+        "Trace", "Debug", "Info", "Warn", "Error"};
+
+    static const char * components[] = {
+        "model:note", "synchronization:note_store", "widget", "local_storage"};
+
+    QDateTime timestamp(QDate(2020, 3, 15), QTime(12, 0));
+
+    QByteArray data;
+    for (int i = 0; i < numEntries; ++i) {
+        data += timestamp.addMSecs(i)
+                    .toString(QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"))
+                    .toUtf8();
+
+        data += " UTC lib/model/SomeSourceFile.cpp:";
+        data += QByteArray::number(i % 1000 + 1);
+        data += " [";
+        data += logLevels[i % 5];
+        data += "] [";
+        data += components[i % 4];
+        data += "]: Log entry number ";
+        data += QByteArray::number(i);
+        data += " with some text typical for log entries\n";
+
+        if (i % 4 == 0) {
+            data += "    second line of a multiline log entry\n";
+            data += "    third line of a multiline log entry\n";
+        }
+    }
+
+    return data;
+}
+
+QByteArray LogViewerModelTestHelper::generateMultilineLogFileData(
+    const int numEntries)
+{
+    static const char * logLevels[] = {
+        "Trace", "Debug", "Info", "Warn", "Error"};
+
+    QByteArray data;
+    for (int i = 0; i < numEntries; ++i) {
+        data += "2020-03-15 12:00:00.000 UTC lib/model/SomeSourceFile.cpp:";
+        data += QByteArray::number(i % 1000 + 1);
+        data += " [";
+        data += logLevels[i % 5];
+        data += "] [component]: First line of log entry ";
+        data += QByteArray::number(i);
+        data += ((i % 3 == 0) ? " with needle\n" : "\n");
+
+        // Continuation lines which can't start log entries because of
+        // unknown log level or too large source file line number
+        data += "2020-03-15 12:00:00.000 file.cpp:1 [Fatal]: unknown level\n";
+        data += "2020-03-15 12:00:00.000 file.cpp:99999999999 [Info]: too "
+                "large line number\n";
+
+        data += "    continuation line of log entry ";
+        data += QByteArray::number(i);
+        data += ((i % 7 == 0) ? " with needle\n" : "\n");
+        data += "\n";
+    }
+
+    return data;
+}
+
+bool LogViewerModelTestHelper::indexLogFile(
+    const QString & logFilePath, const int maxThreadCount,
+    const QVector<LogLevel> & disabledLogLevels,
+    const QString & logEntryContentFilter,
+    QVector<qint64> & entryStartPositions, QByteArray & entryLogLevels,
+    ErrorString & errorDescription)
+{
+    entryStartPositions.clear();
+    entryLogLevels.clear();
+
+    LogViewerModel::LogFileIndexer indexer(
+        logFilePath, 0, 0, disabledLogLevels, logEntryContentFilter);
+
+    indexer.setMaxThreadCount(maxThreadCount);
+
+    bool endOfFile = false;
+
+    QObject::connect(
+        &indexer, &LogViewerModel::LogFileIndexer::logFileIndexed,
+        [&](quint64 generation, qint64 fromPos, qint64 endPos,
+            QVector<qint64> indexedEntryStartPositions,
+            QByteArray indexedEntryLogLevels, bool indexedEndOfFile,
+            ErrorString indexingErrorDescription) {
+            Q_UNUSED(generation)
+            Q_UNUSED(fromPos)
+            Q_UNUSED(endPos)
+
+            entryStartPositions << indexedEntryStartPositions;
+            entryLogLevels.append(indexedEntryLogLevels);
+            endOfFile = indexedEndOfFile;
+            errorDescription = indexingErrorDescription;
+        });
+
+    // The indexer schedules the indexing of the next window through the event
+    // loop, here windows are indexed synchronously one after another
+    while (!endOfFile) {
+        indexer.onIndexLogFile();
+    }
+
+    return errorDescription.isEmpty();
+}
+
+} // namespace quentier
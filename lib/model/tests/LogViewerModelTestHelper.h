@@ -0,0 +1,102 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_TESTS_LOG_VIEWER_MODEL_TEST_HELPER_H
+#define QUENTIER_LIB_MODEL_TESTS_LOG_VIEWER_MODEL_TEST_HELPER_H
+
+#include <lib/model/log_viewer/LogViewerModel.h>
+
+#include <QByteArray>
+#include <QVector>
+
+#include <memory>
+
+namespace quentier {
+
+/**
+ * @brief The LogViewerModelTestHelper class provides access to the log file
+ * parsing internals of LogViewerModel for tests and benchmarks
+ */
+class LogViewerModelTestHelper
+{
+public:
+    LogViewerModelTestHelper();
+    ~LogViewerModelTestHelper();
+
+    /**
+     * @brief checkLogFileParserMatchesRegex - checks that the log file parser
+     * produces the same log entries as the regex based parsing which it
+     * replaced, both for ordinary and for edge case log file lines, without
+     * filtering and with disabled log levels, plain text and wildcard content
+     * filters
+     */
+    bool checkLogFileParserMatchesRegex(ErrorString & errorDescription);
+
+    /**
+     * @brief checkParallelIndexingMatchesSequentialParsing - checks that
+     * the log file indexer splitting the log file into ranges indexed in
+     * parallel finds the same log entries as sequential parsing of the whole
+     * log file, both with and without filtering
+     */
+    bool checkParallelIndexingMatchesSequentialParsing(
+        ErrorString & errorDescription);
+
+    /**
+     * @brief parseLogFileData - parses all log entries from the log file data
+     *
+     * @return              The number of parsed log entries
+     */
+    int parseLogFileData(const QByteArray & data);
+
+    /**
+     * @brief generateLogFileData - generates the log file data with the given
+     * number of log entries, some of them multiline
+     */
+    static QByteArray generateLogFileData(const int numEntries);
+
+    /**
+     * @brief generateMultilineLogFileData - generates the log file data with
+     * the given number of log entries, all of them multiline with some
+     * continuation lines looking almost like log entry starts
+     */
+    static QByteArray generateMultilineLogFileData(const int numEntries);
+
+    /**
+     * @brief indexLogFile - indexes the whole log file with the log file
+     * indexer
+     *
+     * @param maxThreadCount    The maximal number of threads indexing
+     *                          the log file in parallel
+     */
+    static bool indexLogFile(
+        const QString & logFilePath, const int maxThreadCount,
+        const QVector<LogLevel> & disabledLogLevels,
+        const QString & logEntryContentFilter,
+        QVector<qint64> & entryStartPositions, QByteArray & entryLogLevels,
+        ErrorString & errorDescription);
+
+private:
+    Q_DISABLE_COPY(LogViewerModelTestHelper)
+
+private:
+    std::unique_ptr<LogViewerModel::LogFileParser> m_pParser;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_TESTS_LOG_VIEWER_MODEL_TEST_HELPER_H
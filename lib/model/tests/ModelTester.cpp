@@ -19,11 +19,16 @@
 #include "ModelTester.h"
 
 #include "FavoritesModelTestHelper.h"
+#include "LogViewerModelTestHelper.h"
 #include "NoteModelTestHelper.h"
 #include "NotebookModelTestHelper.h"
 #include "SavedSearchModelTestHelper.h"
 #include "TagModelTestHelper.h"
 
+#include <lib/model/common/ItemNamesCompletionModel.h>
+#include <lib/model/favorites/FavoritesModel.h>
+#include <lib/model/note/NoteModel.h>
+#include <lib/model/notebook/NotebookModel.h>
 #include <lib/model/saved_search/SavedSearchModel.h>
 #include <lib/model/tag/TagModel.h>
 
@@ -31,21 +36,64 @@
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/EventLoopWithExitStatus.h>
 #include <quentier/utility/Initialize.h>
+#include <quentier/utility/StandardPaths.h>
 #include <quentier/utility/SysInfo.h>
 #include <quentier/utility/UidGenerator.h>
 
 #include <QApplication>
 #include <QByteArray>
+#include <QCollator>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QPixmap>
+#include <QScrollBar>
 #include <QSortFilterProxyModel>
 #include <QStringListModel>
+#include <QTemporaryFile>
 #include <QTest>
+#include <QThreadPool>
 #include <QTimer>
+#include <QTreeView>
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
 
+#include <algorithm>
+
 // 10 minutes, the timeout for async stuff to complete
 #define MAX_ALLOWED_MILLISECONDS 600000
 
+// The number of notes loaded into the note model by the listing benchmark
+#define NOTE_MODEL_BENCHMARK_NUM_LISTED_NOTES 1000
+
+// The number of notes sorted in memory by the sorting benchmark
+#define NOTE_MODEL_BENCHMARK_NUM_SORTED_NOTES 50000
+
+// The number of notes within the local storage from which the note model
+// loads the first screen of notes in the time to first screen benchmark
+#define NOTE_MODEL_BENCHMARK_NUM_FIRST_SCREEN_SOURCE_NOTES 10000
+
+// The number of notes loaded into the note model by the memory usage benchmark
+#define NOTE_MODEL_BENCHMARK_NUM_NOTES_FOR_MEMORY_USAGE 100000
+
+// The number of notes among which indexes are looked up by local uids
+#define NOTE_MODEL_BENCHMARK_NUM_INDEXED_NOTES 10000
+
+// The number of tags sorted by the tag model sorting benchmark
+#define TAG_MODEL_BENCHMARK_NUM_SORTED_TAGS 5000
+
+// The number of tags in each top level tag's subtree for tag model benchmarks
+#define TAG_MODEL_BENCHMARK_NUM_TAGS_PER_TOP_LEVEL_TAG 50
+
+// The number of tags painted by the tag model tree view painting benchmark
+#define TAG_MODEL_BENCHMARK_NUM_PAINTED_TAGS 10000
+
+// The number of log entries within the log file data parsed by benchmarks
+#define LOG_VIEWER_MODEL_BENCHMARK_NUM_LOG_ENTRIES 20000
+
 #define qnPrintable(string) QString::fromUtf8(string).toLocal8Bit().constData()
 
 ModelTester::ModelTester(QObject * parent) : QObject(parent) {}
@@ -120,6 +168,200 @@ void ModelTester::testSavedSearchModel()
     }
 }
 
+void ModelTester::testSavedSearchModelSnapshot()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_saved_search_model_snapshot_fake_user"),
+        301);
+
+    const int numSavedSearches = 20;
+
+    QVector<SavedSearch> savedSearches;
+    savedSearches.reserve(numSavedSearches);
+    for (int i = 0; i < numSavedSearches; ++i) {
+        SavedSearch search;
+        search.setName(QStringLiteral("Saved search #") + QString::number(i));
+        search.setQuery(QStringLiteral("tag:tag") + QString::number(i));
+        search.setLocal(true);
+        search.setFavorited(i % 2 == 0);
+
+        // NOTE: exploiting the direct connection used in current test
+        // environment
+        m_pLocalStorageManagerAsync->onAddSavedSearchRequest(search, QUuid());
+        savedSearches << search;
+    }
+
+    SavedSearchCache cache(5);
+
+    Account account(
+        QStringLiteral("ModelTester_saved_search_model_snapshot_fake_user"),
+        Account::Type::Local);
+
+    const QString snapshotFilePath = accountPersistentStoragePath(account) +
+        QStringLiteral("/modelSnapshots/quentier::SavedSearchModel.dat");
+
+    // Leftovers from previous runs must not affect the test
+    Q_UNUSED(QFile::remove(snapshotFilePath))
+
+    auto checkModelItems = [&](const SavedSearchModel & model,
+                               const QVector<SavedSearch> & expectedSearches,
+                               QString & errorDescription) -> bool {
+        for (const auto & search: qAsConst(expectedSearches)) {
+            auto index = model.indexForLocalUid(search.localUid());
+            const auto * pModelItem = model.itemForIndex(index);
+            const auto * pItem =
+                (pModelItem ? pModelItem->cast<SavedSearchItem>() : nullptr);
+
+            if (!pItem) {
+                errorDescription = QStringLiteral("No item for saved search ") +
+                    search.name();
+                return false;
+            }
+
+            if ((pItem->name() != search.name()) ||
+                (pItem->query() != search.query()) ||
+                (pItem->isFavorited() != search.isFavorited()))
+            {
+                errorDescription =
+                    QStringLiteral("Item doesn't match saved search ") +
+                    search.name();
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    QString errorDescription;
+
+    // Round trip
+    {
+        SavedSearchModel model(account, *m_pLocalStorageManagerAsync, cache);
+        QVERIFY(!model.saveSnapshot());
+        QVERIFY(!QFile::exists(snapshotFilePath));
+
+        model.start();
+        QTRY_VERIFY(model.allItemsListed());
+
+        QVERIFY(model.saveSnapshot());
+        QVERIFY(QFile::exists(snapshotFilePath));
+    }
+
+    QFile snapshotFile(snapshotFilePath);
+    QVERIFY(snapshotFile.open(QIODevice::ReadOnly));
+    const QByteArray snapshotData = snapshotFile.readAll();
+    snapshotFile.close();
+
+    // Magic number and format version
+    QVERIFY(snapshotData.size() > 8);
+
+    // The saved search expunged from the local storage after the snapshot
+    // was saved is restored but then removed once all items are listed
+    const QVector<SavedSearch> snapshotSavedSearches = savedSearches;
+    const SavedSearch expungedSearch = savedSearches.takeLast();
+
+    m_pLocalStorageManagerAsync->onExpungeSavedSearchRequest(
+        expungedSearch, QUuid());
+
+    {
+        SavedSearchModel model(account, *m_pLocalStorageManagerAsync, cache);
+        QVERIFY(model.restoreSnapshot());
+
+        // The snapshot is consumed once read
+        QVERIFY(!QFile::exists(snapshotFilePath));
+        QVERIFY(!model.restoreSnapshot());
+
+        QVERIFY2(
+            checkModelItems(model, snapshotSavedSearches, errorDescription),
+            qPrintable(errorDescription));
+
+        model.start();
+        QTRY_VERIFY(model.allItemsListed());
+
+        QVERIFY2(
+            checkModelItems(model, savedSearches, errorDescription),
+            qPrintable(errorDescription));
+
+        QVERIFY(!model.indexForLocalUid(expungedSearch.localUid()).isValid());
+
+        QVERIFY(
+            model.rowCount(model.allItemsRootItemIndex()) ==
+            savedSearches.size());
+
+        // Started model can't be restored from the snapshot
+        QVERIFY(model.saveSnapshot());
+        QVERIFY(!model.restoreSnapshot());
+        QVERIFY(QFile::exists(snapshotFilePath));
+    }
+
+    // Malformed snapshots
+    QByteArray corruptMagic = snapshotData;
+    corruptMagic[0] = static_cast<char>(corruptMagic[0] ^ 0xFF);
+
+    QByteArray unknownFormatVersion = snapshotData;
+    unknownFormatVersion[7] = static_cast<char>(unknownFormatVersion[7] + 1);
+
+    QByteArray garbagePayload = snapshotData.left(8);
+    for (int i = 0; i < 64; ++i) {
+        garbagePayload.append(static_cast<char>((i * 37) & 0xFF));
+    }
+
+    QVector<QPair<QString, QByteArray>> malformedSnapshots;
+    malformedSnapshots
+        << qMakePair(QStringLiteral("empty"), QByteArray())
+        << qMakePair(QStringLiteral("corrupt magic"), corruptMagic)
+        << qMakePair(
+               QStringLiteral("unknown format version"), unknownFormatVersion)
+        << qMakePair(
+               QStringLiteral("truncated header"), snapshotData.left(6))
+        << qMakePair(QStringLiteral("header only"), snapshotData.left(8))
+        << qMakePair(
+               QStringLiteral("truncated"),
+               snapshotData.left(snapshotData.size() / 2))
+        << qMakePair(
+               QStringLiteral("truncated by one byte"),
+               snapshotData.left(snapshotData.size() - 1))
+        << qMakePair(QStringLiteral("garbage payload"), garbagePayload);
+
+    QVERIFY(QDir().mkpath(QFileInfo(snapshotFilePath).absolutePath()));
+
+    for (const auto & malformedSnapshot: qAsConst(malformedSnapshots)) {
+        const QString & description = malformedSnapshot.first;
+
+        QFile file(snapshotFilePath);
+        QVERIFY2(
+            file.open(QIODevice::WriteOnly | QIODevice::Truncate),
+            qPrintable(description));
+
+        QVERIFY2(
+            file.write(malformedSnapshot.second) ==
+                malformedSnapshot.second.size(),
+            qPrintable(description));
+
+        file.close();
+
+        SavedSearchModel model(account, *m_pLocalStorageManagerAsync, cache);
+        QVERIFY2(!model.restoreSnapshot(), qPrintable(description));
+        QVERIFY2(!QFile::exists(snapshotFilePath), qPrintable(description));
+
+        // Nothing is restored from the rejected snapshot
+        for (const auto & search: qAsConst(savedSearches)) {
+            QVERIFY2(
+                !model.indexForLocalUid(search.localUid()).isValid(),
+                qPrintable(description));
+        }
+
+        model.start();
+        QTRY_VERIFY(model.allItemsListed());
+
+        QVERIFY2(
+            checkModelItems(model, savedSearches, errorDescription),
+            qPrintable(description + QStringLiteral(": ") + errorDescription));
+    }
+}
+
 void ModelTester::testTagModel()
 {
     using namespace quentier;
@@ -322,6 +564,611 @@ void ModelTester::testNoteModel()
     }
 }
 
+void ModelTester::testNoteModelNoteCountsAfterUpdatesOfNotLoadedNotes()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_note_counts_fake_user"), 701);
+
+    Notebook notebook;
+    notebook.setName(QStringLiteral("Notebook"));
+    notebook.setLocal(true);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    m_pLocalStorageManagerAsync->onAddNotebookRequest(notebook, QUuid());
+
+    const int numNotes = 200;
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    QVector<Note> notes;
+    notes.reserve(numNotes);
+    for (int i = 0; i < numNotes; ++i) {
+        Note note;
+        note.setTitle(QStringLiteral("Note #") + QString::number(i));
+        note.setContent(QStringLiteral("<en-note><h1>Note</h1></en-note>"));
+        note.setCreationTimestamp(timestamp + i);
+        note.setModificationTimestamp(note.creationTimestamp());
+        note.setNotebookLocalUid(notebook.localUid());
+        note.setLocal(true);
+        m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid());
+        notes << note;
+    }
+
+    Note deletedNote;
+    deletedNote.setTitle(QStringLiteral("Deleted note"));
+    deletedNote.setContent(QStringLiteral("<en-note><h1>Note</h1></en-note>"));
+    deletedNote.setCreationTimestamp(timestamp);
+    deletedNote.setModificationTimestamp(timestamp);
+    deletedNote.setDeletionTimestamp(timestamp);
+    deletedNote.setNotebookLocalUid(notebook.localUid());
+    deletedNote.setLocal(true);
+    m_pLocalStorageManagerAsync->onAddNoteRequest(deletedNote, QUuid());
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache,
+        nullptr, NoteModel::IncludedNotes::NonDeleted,
+        NoteModel::NoteSortingMode::ModifiedAscending);
+
+    model.start();
+
+    QTRY_COMPARE(model.totalAccountNotesCount(), numNotes);
+    QTRY_COMPARE(model.totalFilteredNotesCount(), numNotes);
+
+    // The most recently modified note is the last one to be loaded
+    Note & lastNote = notes.last();
+    QVERIFY(!model.itemForLocalUid(lastNote.localUid()));
+
+    lastNote.setDeletionTimestamp(QDateTime::currentMSecsSinceEpoch());
+
+    m_pLocalStorageManagerAsync->onUpdateNoteRequest(
+        lastNote,
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        LocalStorageManager::UpdateNoteOptions(),
+#else
+        LocalStorageManager::UpdateNoteOptions(0),
+#endif
+        QUuid());
+
+    QTRY_COMPARE(model.totalAccountNotesCount(), numNotes - 1);
+    QTRY_COMPARE(model.totalFilteredNotesCount(), numNotes - 1);
+
+    // The restored note was neither loaded nor cached before the update
+    QVERIFY(!model.itemForLocalUid(deletedNote.localUid()));
+    QVERIFY(!noteCache.get(deletedNote.localUid()));
+
+    deletedNote.setDeletionTimestamp(-1);
+
+    m_pLocalStorageManagerAsync->onUpdateNoteRequest(
+        deletedNote,
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        LocalStorageManager::UpdateNoteOptions(),
+#else
+        LocalStorageManager::UpdateNoteOptions(0),
+#endif
+        QUuid());
+
+    QTRY_COMPARE(model.totalAccountNotesCount(), numNotes);
+    QTRY_COMPARE(model.totalFilteredNotesCount(), numNotes);
+}
+
+void ModelTester::benchmarkNoteModelListing()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_listing_benchmark_fake_user"),
+        702);
+
+    const int numNotes = NOTE_MODEL_BENCHMARK_NUM_LISTED_NOTES;
+    Q_UNUSED(addNotesToLocalStorage(numNotes))
+
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    int numIterations = 0;
+    int numRowCountChangingSignals = 0;
+    int numOtherSignals = 0;
+    size_t numListNotesRoundTrips = 0;
+    int rowCount = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        NoteCache noteCache(20);
+        NotebookCache notebookCache(3);
+
+        NoteModel model(
+            account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+        numRowCountChangingSignals = 0;
+        numOtherSignals = 0;
+
+        auto countRowCountChangingSignal = [&] {
+            ++numRowCountChangingSignals;
+        };
+
+        auto countOtherSignal = [&] {
+            ++numOtherSignals;
+        };
+
+        QObject::connect(
+            &model, &NoteModel::rowsInserted, countRowCountChangingSignal);
+
+        QObject::connect(
+            &model, &NoteModel::rowsRemoved, countRowCountChangingSignal);
+
+        QObject::connect(&model, &NoteModel::rowsMoved, countOtherSignal);
+        QObject::connect(&model, &NoteModel::layoutChanged, countOtherSignal);
+        QObject::connect(&model, &NoteModel::dataChanged, countOtherSignal);
+
+        // NOTE: exploiting the direct connection used in current test
+        // environment: the listing is complete once these calls return
+        model.start();
+        while (model.canFetchMore(QModelIndex())) {
+            model.fetchMore(QModelIndex());
+        }
+
+        rowCount = model.rowCount();
+        numListNotesRoundTrips = model.listNotesRoundTripCount();
+        ++numIterations;
+    }
+
+    qint64 elapsedMsec = std::max(timer.elapsed(), qint64(1));
+
+    QVERIFY(rowCount == numNotes);
+
+    // Notes are listed in the model's sort order so each page of listed notes
+    // is inserted as a single contiguous range of rows
+    QVERIFY(
+        static_cast<size_t>(numRowCountChangingSignals) <=
+        numListNotesRoundTrips);
+
+    qInfo() << "Note model listing of" << numNotes << "notes:"
+            << (static_cast<double>(elapsedMsec) / numIterations) << "msec,"
+            << numListNotesRoundTrips << "list notes requests,"
+            << numRowCountChangingSignals << "rows insertion/removal signals,"
+            << numOtherSignals << "other change signals";
+}
+
+void ModelTester::testNoteModelSortOrder()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_sort_order_fake_user"), 703);
+
+    const int numNotes = 100;
+    Q_UNUSED(addNotesToLocalStorage(numNotes))
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+    }
+
+    QVERIFY(model.rowCount() == numNotes);
+
+    QString errorDescription;
+    QVERIFY2(
+        checkNoteModelSortOrder(model, errorDescription),
+        qPrintable(errorDescription));
+
+    // All notes are loaded so they are sorted in memory without listing them
+    // from the local storage once again
+    size_t numListNotesRoundTrips = model.listNotesRoundTripCount();
+
+    QVector<NoteModel::Columns::type> columns;
+    columns << NoteModel::Columns::Title
+            << NoteModel::Columns::ModificationTimestamp
+            << NoteModel::Columns::CreationTimestamp
+            << NoteModel::Columns::Size << NoteModel::Columns::Title;
+
+    for (const auto column: qAsConst(columns)) {
+        for (const auto order: {Qt::DescendingOrder, Qt::AscendingOrder}) {
+            model.sort(column, order);
+
+            QVERIFY(model.sortingColumn() == column);
+            QVERIFY(model.sortOrder() == order);
+            QVERIFY(model.rowCount() == numNotes);
+
+            QVERIFY2(
+                checkNoteModelSortOrder(model, errorDescription),
+                qPrintable(errorDescription));
+        }
+    }
+
+    QVERIFY(model.listNotesRoundTripCount() == numListNotesRoundTrips);
+}
+
+void ModelTester::benchmarkNoteModelSortByTitle()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_sort_benchmark_fake_user"),
+        704);
+
+    const int numNotes = NOTE_MODEL_BENCHMARK_NUM_SORTED_NOTES;
+    Q_UNUSED(addNotesToLocalStorage(numNotes))
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+    }
+
+    QVERIFY(model.rowCount() == numNotes);
+
+    int numIterations = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        model.sort(NoteModel::Columns::Title, Qt::AscendingOrder);
+        model.sort(NoteModel::Columns::Title, Qt::DescendingOrder);
+        ++numIterations;
+    }
+
+    qint64 elapsedMsec = std::max(timer.elapsed(), qint64(1));
+
+    QString errorDescription;
+    QVERIFY2(
+        checkNoteModelSortOrder(model, errorDescription),
+        qPrintable(errorDescription));
+
+    qInfo() << "Note model sorting of" << numNotes << "notes by title:"
+            << (static_cast<double>(elapsedMsec) / (numIterations * 2))
+            << "msec";
+}
+
+void ModelTester::testNoteModelListNotesRoundTripCount()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_round_trips_fake_user"), 705);
+
+    const int numNotes = 500;
+    Q_UNUSED(addNotesToLocalStorage(numNotes))
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+    QVERIFY(model.listNotesRoundTripCount() == 0);
+    QVERIFY(model.timeToFirstScreenMsec() < 0);
+
+    // The note model is the only one listing notes within this test
+    size_t numListNotesCompletions = 0;
+    QObject::connect(
+        m_pLocalStorageManagerAsync,
+        &LocalStorageManagerAsync::listNotesComplete, &model,
+        [&] { ++numListNotesCompletions; });
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+
+    QVERIFY(numListNotesCompletions > 0);
+    QVERIFY(model.listNotesRoundTripCount() == numListNotesCompletions);
+    QVERIFY(model.timeToFirstScreenMsec() >= 0);
+    QVERIFY(model.rowCount() > 0);
+    QVERIFY(model.rowCount() < numNotes);
+
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+        QVERIFY(model.listNotesRoundTripCount() == numListNotesCompletions);
+    }
+
+    QVERIFY(model.rowCount() == numNotes);
+
+    // Each page except for the last one is full and the requests' limits are
+    // never less than the minimal one
+    QVERIFY(model.listNotesRoundTripCount() <= static_cast<size_t>(numNotes));
+
+    // Filtering resets the model so the round trips are counted anew; notes
+    // are listed per notebooks and tags then
+    size_t numFilteredListNotesCompletions = 0;
+    QObject::connect(
+        m_pLocalStorageManagerAsync,
+        &LocalStorageManagerAsync::listNotesPerNotebooksAndTagsComplete, &model,
+        [&] { ++numFilteredListNotesCompletions; });
+
+    QStringList notebookLocalUids;
+    notebookLocalUids << model.itemAtRow(0)->notebookLocalUid();
+    model.setFilteredNotebookLocalUids(notebookLocalUids);
+
+    QVERIFY(numFilteredListNotesCompletions > 0);
+
+    QVERIFY(
+        model.listNotesRoundTripCount() == numFilteredListNotesCompletions);
+
+    QVERIFY(model.timeToFirstScreenMsec() >= 0);
+}
+
+void ModelTester::benchmarkNoteModelTimeToFirstScreen()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_first_screen_benchmark_user"),
+        706);
+
+    const int numNotes = NOTE_MODEL_BENCHMARK_NUM_FIRST_SCREEN_SOURCE_NOTES;
+    Q_UNUSED(addNotesToLocalStorage(numNotes))
+
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    int numIterations = 0;
+    qint64 totalTimeToFirstScreenMsec = 0;
+    size_t totalListNotesRoundTrips = 0;
+    int rowCount = 0;
+
+    QBENCHMARK {
+        NoteCache noteCache(20);
+        NotebookCache notebookCache(3);
+
+        NoteModel model(
+            account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+        // NOTE: exploiting the direct connection used in current test
+        // environment: the first screen is loaded once the call returns
+        model.start();
+
+        totalTimeToFirstScreenMsec += model.timeToFirstScreenMsec();
+        totalListNotesRoundTrips += model.listNotesRoundTripCount();
+        rowCount = model.rowCount();
+        ++numIterations;
+    }
+
+    QVERIFY(rowCount > 0);
+
+    qInfo() << "Note model first screen of" << rowCount << "notes out of"
+            << numNotes << "loaded within"
+            << (static_cast<double>(totalTimeToFirstScreenMsec) /
+                numIterations)
+            << "msec using"
+            << (static_cast<double>(totalListNotesRoundTrips) / numIterations)
+            << "list notes requests";
+}
+
+void ModelTester::benchmarkNoteModelMemoryUsage()
+{
+    using namespace quentier;
+
+#ifndef Q_OS_LINUX
+    QSKIP("The resident memory size is only measured on Linux");
+#else
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_memory_benchmark_fake_user"),
+        707);
+
+    const int numNotes = NOTE_MODEL_BENCHMARK_NUM_NOTES_FOR_MEMORY_USAGE;
+    QStringList noteLocalUids = addNotesToLocalStorage(numNotes, 10, 50);
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    // Let the preview text extraction of the previous tests settle down
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+
+    qint64 residentMemoryBefore = residentMemorySize();
+    QVERIFY(residentMemoryBefore > 0);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+    QBENCHMARK_ONCE {
+        // NOTE: exploiting the direct connection used in current test
+        // environment
+        model.start();
+        while (model.canFetchMore(QModelIndex())) {
+            model.fetchMore(QModelIndex());
+        }
+
+        // Preview texts are extracted in background and are also kept by
+        // items
+        QThreadPool::globalInstance()->waitForDone();
+        QCoreApplication::processEvents();
+    }
+
+    QVERIFY(model.rowCount() == numNotes);
+
+    // Notebook and tag references are interned so the items of notes from
+    // the same notebook and with the same tags share the strings
+    const auto * pFirstItem = model.itemForLocalUid(noteLocalUids[0]);
+    const auto * pSecondItem = model.itemForLocalUid(noteLocalUids[10]);
+    QVERIFY(pFirstItem && pSecondItem);
+
+    QVERIFY(
+        pFirstItem->notebookLocalUid().constData() ==
+        pSecondItem->notebookLocalUid().constData());
+
+    QVERIFY(!pFirstItem->tagLocalUids().isEmpty());
+
+    QVERIFY(
+        pFirstItem->tagLocalUids().at(0).constData() ==
+        pSecondItem->tagLocalUids().at(0).constData());
+
+    // The resident memory size also includes the memory taken by the local
+    // storage while listing the notes so this is the upper bound of memory
+    // taken by the model's items
+    qint64 residentMemoryAfter = residentMemorySize();
+
+    qInfo() << "Note model memory usage with" << numNotes << "notes:"
+            << ((residentMemoryAfter - residentMemoryBefore) / 1024) << "KB,"
+            << (static_cast<double>(
+                    residentMemoryAfter - residentMemoryBefore) /
+                numNotes)
+            << "bytes per note";
+#endif
+}
+
+void ModelTester::testNoteModelIndexForLocalUid()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_index_for_local_uid_fake_user"),
+        708);
+
+    const int numNotes = 100;
+    QStringList noteLocalUids = addNotesToLocalStorage(numNotes, 3, 5);
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+    }
+
+    QVERIFY(model.rowCount() == numNotes);
+
+    QString errorDescription;
+    QVERIFY2(
+        checkNoteModelIndexesForLocalUids(model, errorDescription),
+        qPrintable(errorDescription));
+
+    QVERIFY(!model.indexForLocalUid(UidGenerator::Generate()).isValid());
+
+    // Insert
+    const auto * pFirstItem = model.itemForLocalUid(noteLocalUids[0]);
+    QVERIFY(pFirstItem);
+
+    Note note;
+    note.setTitle(QStringLiteral("Inserted note"));
+    note.setContent(QStringLiteral("<en-note><h1>Note</h1></en-note>"));
+    note.setCreationTimestamp(QDateTime::currentMSecsSinceEpoch());
+    note.setModificationTimestamp(note.creationTimestamp());
+    note.setNotebookLocalUid(pFirstItem->notebookLocalUid());
+    note.setLocal(true);
+    m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid());
+
+    QTRY_COMPARE(model.rowCount(), numNotes + 1);
+    QVERIFY(model.indexForLocalUid(note.localUid()).isValid());
+
+    QVERIFY2(
+        checkNoteModelIndexesForLocalUids(model, errorDescription),
+        qPrintable(errorDescription));
+
+    // Remove
+    const auto * pRemovedItem = model.itemAtRow(numNotes / 2);
+    QVERIFY(pRemovedItem);
+
+    Note removedNote;
+    removedNote.setLocalUid(pRemovedItem->localUid());
+    m_pLocalStorageManagerAsync->onExpungeNoteRequest(removedNote, QUuid());
+
+    QTRY_COMPARE(model.rowCount(), numNotes);
+    QVERIFY(!model.indexForLocalUid(removedNote.localUid()).isValid());
+    QVERIFY(!model.itemForLocalUid(removedNote.localUid()));
+
+    QVERIFY2(
+        checkNoteModelIndexesForLocalUids(model, errorDescription),
+        qPrintable(errorDescription));
+
+    // Sort
+    for (const auto order: {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        model.sort(NoteModel::Columns::Title, order);
+        QVERIFY(model.rowCount() == numNotes);
+
+        QVERIFY2(
+            checkNoteModelIndexesForLocalUids(model, errorDescription),
+            qPrintable(errorDescription));
+    }
+}
+
+void ModelTester::benchmarkNoteModelIndexForLocalUid()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_note_model_index_benchmark_fake_user"),
+        709);
+
+    const int numNotes = NOTE_MODEL_BENCHMARK_NUM_INDEXED_NOTES;
+    const QStringList noteLocalUids = addNotesToLocalStorage(numNotes);
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    NoteModel model(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+    }
+
+    QVERIFY(model.rowCount() == numNotes);
+
+    // Look up the local uids in an order unrelated to the order of rows;
+    // 7919 is a prime so the stride visits each note exactly once
+    QStringList lookedUpLocalUids;
+    lookedUpLocalUids.reserve(numNotes);
+    for (int i = 0; i < numNotes; ++i) {
+        lookedUpLocalUids << noteLocalUids[(i * 7919) % numNotes];
+    }
+
+    int numIterations = 0;
+    int numValidIndexes = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        numValidIndexes = 0;
+        for (const auto & localUid: qAsConst(lookedUpLocalUids)) {
+            if (model.indexForLocalUid(localUid).isValid()) {
+                ++numValidIndexes;
+            }
+        }
+
+        ++numIterations;
+    }
+
+    qint64 elapsed = timer.nsecsElapsed();
+
+    QVERIFY(numValidIndexes == numNotes);
+
+    qInfo() << "Looked up" << numNotes << "note model indexes by local uids"
+            << numIterations << "times,"
+            << (static_cast<double>(elapsed) / (numIterations * numNotes))
+            << "ns per lookup";
+}
+
 void ModelTester::testFavoritesModel()
 {
     using namespace quentier;
@@ -390,6 +1237,114 @@ void ModelTester::testFavoritesModel()
     }
 }
 
+void ModelTester::testFavoritesModelNoteCountsFromNotebookModel()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_favorites_model_note_counts_fake_user"),
+        801);
+
+    Notebook favoritedNotebook;
+    favoritedNotebook.setName(QStringLiteral("Favorited notebook"));
+    favoritedNotebook.setLocal(true);
+    favoritedNotebook.setFavorited(true);
+
+    Notebook otherNotebook;
+    otherNotebook.setName(QStringLiteral("Other notebook"));
+    otherNotebook.setLocal(true);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    m_pLocalStorageManagerAsync->onAddNotebookRequest(
+        favoritedNotebook, QUuid());
+
+    m_pLocalStorageManagerAsync->onAddNotebookRequest(otherNotebook, QUuid());
+
+    QVector<Note> notes;
+    for (int i = 0; i < 4; ++i) {
+        Note note;
+        note.setTitle(QStringLiteral("Note #") + QString::number(i));
+        note.setContent(QStringLiteral("<en-note><h1>Note</h1></en-note>"));
+        note.setCreationTimestamp(QDateTime::currentMSecsSinceEpoch());
+        note.setModificationTimestamp(note.creationTimestamp());
+        note.setNotebookLocalUid(favoritedNotebook.localUid());
+        note.setLocal(true);
+        notes << note;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        m_pLocalStorageManagerAsync->onAddNoteRequest(notes[i], QUuid());
+    }
+
+    NoteCache noteCache(10);
+    NotebookCache notebookCache(3);
+    TagCache tagCache(5);
+    SavedSearchCache savedSearchCache(5);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    // The favorites model is created before the notebook model, like within
+    // the app, so it processes each local storage event before the notebook
+    // model does
+    FavoritesModel favoritesModel(
+        account, *m_pLocalStorageManagerAsync, noteCache, notebookCache,
+        tagCache, savedSearchCache);
+
+    NotebookModel notebookModel(
+        account, *m_pLocalStorageManagerAsync, notebookCache);
+
+    favoritesModel.start();
+    notebookModel.start();
+    favoritesModel.setNotebookModel(&notebookModel);
+
+    auto favoritesNoteCount = [&] {
+        const auto * pItem =
+            favoritesModel.itemForLocalUid(favoritedNotebook.localUid());
+        return (pItem ? pItem->noteCount() : -1);
+    };
+
+    QTRY_COMPARE(
+        notebookModel.noteCountForNotebook(favoritedNotebook.localUid()), 3);
+
+    QTRY_COMPARE(favoritesNoteCount(), 3);
+
+    m_pLocalStorageManagerAsync->onAddNoteRequest(notes[3], QUuid());
+
+    QTRY_COMPARE(
+        notebookModel.noteCountForNotebook(favoritedNotebook.localUid()), 4);
+
+    QTRY_COMPARE(favoritesNoteCount(), 4);
+
+    // Hold the count for a while to catch adjustments applied twice
+    QTest::qWait(100);
+    QCOMPARE(favoritesNoteCount(), 4);
+
+    notes[1].setNotebookLocalUid(otherNotebook.localUid());
+
+    m_pLocalStorageManagerAsync->onUpdateNoteRequest(
+        notes[1],
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        LocalStorageManager::UpdateNoteOptions(),
+#else
+        LocalStorageManager::UpdateNoteOptions(0),
+#endif
+        QUuid());
+
+    QTRY_COMPARE(
+        notebookModel.noteCountForNotebook(favoritedNotebook.localUid()), 3);
+
+    QTRY_COMPARE(favoritesNoteCount(), 3);
+
+    m_pLocalStorageManagerAsync->onExpungeNoteRequest(notes[0], QUuid());
+
+    QTRY_COMPARE(
+        notebookModel.noteCountForNotebook(favoritedNotebook.localUid()), 2);
+
+    QTRY_COMPARE(favoritesNoteCount(), 2);
+
+    QTest::qWait(100);
+    QCOMPARE(favoritesNoteCount(), 2);
+}
+
 void ModelTester::testTagModelItemSerialization()
 {
     using namespace quentier;
@@ -426,6 +1381,716 @@ void ModelTester::testTagModelItemSerialization()
     QVERIFY(restoredItem.parent() == item.parent());
 }
 
+void ModelTester::benchmarkTagModelSortByName()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_tag_model_sort_benchmark_fake_user"), 901);
+
+    const int numTags = TAG_MODEL_BENCHMARK_NUM_SORTED_TAGS;
+    const QStringList tagLocalUids = addTagsToLocalStorage(
+        numTags, TAG_MODEL_BENCHMARK_NUM_TAGS_PER_TOP_LEVEL_TAG);
+
+    TagCache tagCache(20);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    TagModel model(account, *m_pLocalStorageManagerAsync, tagCache);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    QTRY_VERIFY(model.allTagsListed());
+
+    QString errorDescription;
+    QVERIFY2(
+        checkTagModelSortOrder(model, QModelIndex(), errorDescription),
+        qPrintable(errorDescription));
+
+    // Persistent indices must keep pointing to the same tags after sorting
+    const QString & childTagLocalUid = tagLocalUids[1];
+    QPersistentModelIndex childTagIndex =
+        model.indexForLocalUid(childTagLocalUid);
+    QVERIFY(childTagIndex.isValid());
+
+    const int column = static_cast<int>(TagModel::Column::Name);
+    int numIterations = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        model.sort(column, Qt::DescendingOrder);
+        model.sort(column, Qt::AscendingOrder);
+        ++numIterations;
+    }
+
+    qint64 elapsed = timer.elapsed();
+
+    QVERIFY2(
+        checkTagModelSortOrder(model, QModelIndex(), errorDescription),
+        qPrintable(errorDescription));
+
+    model.sort(column, Qt::DescendingOrder);
+
+    QVERIFY2(
+        checkTagModelSortOrder(model, QModelIndex(), errorDescription),
+        qPrintable(errorDescription));
+
+    QVERIFY(childTagIndex.isValid());
+    QVERIFY(childTagIndex == model.indexForLocalUid(childTagLocalUid));
+
+    qInfo() << "Sorted" << numTags << "tags by name in both orders"
+            << numIterations << "times within" << elapsed << "msec";
+}
+
+void ModelTester::benchmarkTagModelTreeViewPainting()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_tag_model_painting_benchmark_fake_user"),
+        902);
+
+    const int numTags = TAG_MODEL_BENCHMARK_NUM_PAINTED_TAGS;
+    Q_UNUSED(addTagsToLocalStorage(
+        numTags, TAG_MODEL_BENCHMARK_NUM_TAGS_PER_TOP_LEVEL_TAG))
+
+    TagCache tagCache(20);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    TagModel model(account, *m_pLocalStorageManagerAsync, tagCache);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    QTRY_VERIFY(model.allTagsListed());
+
+    QTreeView view;
+    view.setUniformRowHeights(true);
+    view.setModel(&model);
+    view.resize(400, 600);
+    view.expandAll();
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    auto * pScrollBar = view.verticalScrollBar();
+    QVERIFY(pScrollBar);
+    QVERIFY(pScrollBar->maximum() > 0);
+
+    int numIterations = 0;
+    int numPaintedPages = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Each page of the expanded tree is painted from the top to the bottom,
+    // so data and parent/index calls are made for every visible tag
+    QBENCHMARK {
+        numPaintedPages = 0;
+        pScrollBar->setValue(0);
+        while (true) {
+            QPixmap pixmap = view.viewport()->grab();
+            QVERIFY(!pixmap.isNull());
+            ++numPaintedPages;
+
+            if (pScrollBar->value() == pScrollBar->maximum()) {
+                break;
+            }
+
+            pScrollBar->setValue(
+                pScrollBar->value() + pScrollBar->pageStep());
+        }
+
+        ++numIterations;
+    }
+
+    qint64 elapsed = timer.elapsed();
+
+    qInfo() << "Painted" << numPaintedPages << "pages of the tree view over"
+            << numTags << "tags" << numIterations << "times within" << elapsed
+            << "msec,"
+            << (static_cast<double>(elapsed) /
+                (numIterations * numPaintedPages))
+            << "msec per page";
+}
+
+void ModelTester::testItemNamesCompletionModelIncrementalUpdates()
+{
+    using namespace quentier;
+
+    resetLocalStorageManagerAsync(
+        QStringLiteral("ModelTester_item_names_completion_model_fake_user"),
+        903);
+
+    QStringList tagLocalUids = addTagsToLocalStorage(100, 10);
+
+    TagCache tagCache(20);
+    Account account(QStringLiteral("Default user"), Account::Type::Local);
+
+    TagModel model(account, *m_pLocalStorageManagerAsync, tagCache);
+
+    // The completion model created before the source model is started
+    // follows the listing of items
+    auto * pCompletionModel = ItemNamesCompletionModel::forSourceModel(model);
+    QVERIFY(pCompletionModel);
+    QVERIFY(
+        ItemNamesCompletionModel::forSourceModel(model) == pCompletionModel);
+
+    // NOTE: exploiting the direct connection used in current test environment
+    model.start();
+    QTRY_VERIFY(model.allTagsListed());
+
+    QString errorDescription;
+    QVERIFY2(
+        checkItemNamesCompletionModel(*pCompletionModel, errorDescription),
+        qPrintable(errorDescription));
+
+    QVERIFY(pCompletionModel->rowCount() == tagLocalUids.size());
+
+    // Changes of the source model after listing must not rebuild completions
+    int numCompletionModelResets = 0;
+    QObject::connect(
+        pCompletionModel, &ItemNamesCompletionModel::modelReset, &model,
+        [&numCompletionModelResets] { ++numCompletionModelResets; });
+
+    // Insert top level and child tags
+    Tag topLevelTag;
+    topLevelTag.setName(QStringLiteral("Inserted top level tag"));
+    topLevelTag.setLocal(true);
+    m_pLocalStorageManagerAsync->onAddTagRequest(topLevelTag, QUuid());
+
+    Tag childTag;
+    childTag.setName(QStringLiteral("inserted child tag"));
+    childTag.setLocal(true);
+    childTag.setParentLocalUid(tagLocalUids[0]);
+    m_pLocalStorageManagerAsync->onAddTagRequest(childTag, QUuid());
+
+    QTRY_VERIFY(model.indexForLocalUid(childTag.localUid()).isValid());
+    QTRY_COMPARE(pCompletionModel->rowCount(), tagLocalUids.size() + 2);
+
+    QVERIFY2(
+        checkItemNamesCompletionModel(*pCompletionModel, errorDescription),
+        qPrintable(errorDescription));
+
+    // Rename tags so that their completions move to other rows
+    childTag.setName(QStringLiteral("A renamed child tag"));
+    m_pLocalStorageManagerAsync->onUpdateTagRequest(childTag, QUuid());
+
+    Tag renamedTag;
+    renamedTag.setLocalUid(tagLocalUids[55]);
+    renamedTag.setName(QStringLiteral("zz renamed tag"));
+    renamedTag.setParentLocalUid(tagLocalUids[50]);
+    renamedTag.setLocal(true);
+    m_pLocalStorageManagerAsync->onUpdateTagRequest(renamedTag, QUuid());
+
+    QTRY_COMPARE(
+        model.itemNameForLocalUid(renamedTag.localUid()), renamedTag.name());
+
+    QVERIFY2(
+        checkItemNamesCompletionModel(*pCompletionModel, errorDescription),
+        qPrintable(errorDescription));
+
+    // Remove a single tag and then a top level tag along with its children
+    m_pLocalStorageManagerAsync->onExpungeTagRequest(topLevelTag, QUuid());
+
+    Tag expungedParentTag;
+    expungedParentTag.setLocalUid(tagLocalUids[10]);
+    m_pLocalStorageManagerAsync->onExpungeTagRequest(
+        expungedParentTag, QUuid());
+
+    QTRY_VERIFY(!model.indexForLocalUid(tagLocalUids[11]).isValid());
+    QTRY_COMPARE(pCompletionModel->rowCount(), tagLocalUids.size() + 1 - 10);
+
+    QVERIFY2(
+        checkItemNamesCompletionModel(*pCompletionModel, errorDescription),
+        qPrintable(errorDescription));
+
+    QVERIFY(numCompletionModelResets == 0);
+}
+
+void ModelTester::testLogViewerModelLogFileParser()
+{
+    using namespace quentier;
+
+    LogViewerModelTestHelper logViewerModelTestHelper;
+
+    ErrorString errorDescription;
+    bool res = logViewerModelTestHelper.checkLogFileParserMatchesRegex(
+        errorDescription);
+
+    QVERIFY2(res, qPrintable(errorDescription.nonLocalizedString()));
+}
+
+void ModelTester::benchmarkLogViewerModelLogFileParser()
+{
+    using namespace quentier;
+
+    LogViewerModelTestHelper logViewerModelTestHelper;
+
+    QByteArray data = LogViewerModelTestHelper::generateLogFileData(
+        LOG_VIEWER_MODEL_BENCHMARK_NUM_LOG_ENTRIES);
+
+    int numEntries = 0;
+    int numIterations = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        numEntries = logViewerModelTestHelper.parseLogFileData(data);
+        ++numIterations;
+    }
+
+    qint64 elapsedNsec = std::max(timer.nsecsElapsed(), qint64(1));
+
+    QVERIFY(numEntries == LOG_VIEWER_MODEL_BENCHMARK_NUM_LOG_ENTRIES);
+
+    double megabytesPerSecond = static_cast<double>(data.size()) *
+        numIterations / (1024.0 * 1024.0) / (elapsedNsec * 1.0e-9);
+
+    qInfo() << "Log file parser throughput:" << megabytesPerSecond << "MB/s";
+}
+
+void ModelTester::testLogViewerModelLogFileIndexer()
+{
+    using namespace quentier;
+
+    LogViewerModelTestHelper logViewerModelTestHelper;
+
+    ErrorString errorDescription;
+    bool res =
+        logViewerModelTestHelper.checkParallelIndexingMatchesSequentialParsing(
+            errorDescription);
+
+    QVERIFY2(res, qPrintable(errorDescription.nonLocalizedString()));
+}
+
+void ModelTester::benchmarkLogViewerModelLogFileIndexer_data()
+{
+    QTest::addColumn<int>("maxThreadCount");
+    QTest::addColumn<QString>("logEntryContentFilter");
+
+    for (int maxThreadCount: {1, 2, 4, 8}) {
+        QByteArray name = QByteArray::number(maxThreadCount) +
+            ((maxThreadCount == 1) ? " thread" : " threads");
+
+        QTest::newRow(name.constData()) << maxThreadCount << QString();
+
+        name += ", content filter";
+
+        QTest::newRow(name.constData())
+            << maxThreadCount << QStringLiteral("needle");
+    }
+}
+
+void ModelTester::benchmarkLogViewerModelLogFileIndexer()
+{
+    using namespace quentier;
+
+    QFETCH(int, maxThreadCount);
+    QFETCH(QString, logEntryContentFilter);
+
+    QByteArray data = LogViewerModelTestHelper::generateLogFileData(
+        LOG_VIEWER_MODEL_BENCHMARK_NUM_LOG_ENTRIES);
+
+    QTemporaryFile logFile;
+    QVERIFY(logFile.open());
+    QVERIFY(logFile.write(data) == data.size());
+    QVERIFY(logFile.flush());
+
+    bool res = true;
+    int numIterations = 0;
+    QVector<qint64> entryStartPositions;
+    QByteArray entryLogLevels;
+    ErrorString errorDescription;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        res = res &&
+            LogViewerModelTestHelper::indexLogFile(
+                logFile.fileName(), maxThreadCount, QVector<LogLevel>(),
+                logEntryContentFilter, entryStartPositions, entryLogLevels,
+                errorDescription);
+
+        ++numIterations;
+    }
+
+    qint64 elapsedNsec = std::max(timer.nsecsElapsed(), qint64(1));
+
+    QVERIFY2(res, qPrintable(errorDescription.nonLocalizedString()));
+
+    double megabytesPerSecond = static_cast<double>(data.size()) *
+        numIterations / (1024.0 * 1024.0) / (elapsedNsec * 1.0e-9);
+
+    qInfo() << "Log file indexer throughput with" << maxThreadCount
+            << "threads:" << megabytesPerSecond << "MB/s";
+}
+
+void ModelTester::resetLocalStorageManagerAsync(
+    const QString & userName, const qint32 userId)
+{
+    using namespace quentier;
+
+    delete m_pLocalStorageManagerAsync;
+
+    Account account(userName, Account::Type::Evernote, userId);
+
+    LocalStorageManager::StartupOptions startupOptions(
+        LocalStorageManager::StartupOption::ClearDatabase);
+
+    m_pLocalStorageManagerAsync = new quentier::LocalStorageManagerAsync(
+        account, startupOptions, this);
+
+    m_pLocalStorageManagerAsync->init();
+}
+
+qint64 ModelTester::residentMemorySize() const
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+
+    // The line looks like "VmRSS:     12345 kB"
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        if (!line.startsWith("VmRSS:")) {
+            continue;
+        }
+
+        QList<QByteArray> parts = line.simplified().split(' ');
+        if (parts.size() < 2) {
+            return -1;
+        }
+
+        bool conversionResult = false;
+        qint64 sizeInKilobytes = parts[1].toLongLong(&conversionResult);
+        return (conversionResult ? sizeInKilobytes * 1024 : -1);
+    }
+
+    return -1;
+}
+
+bool ModelTester::checkNoteModelIndexesForLocalUids(
+    const quentier::NoteModel & model, QString & errorDescription) const
+{
+    for (int row = 0, rowCount = model.rowCount(); row < rowCount; ++row) {
+        const auto * pItem = model.itemAtRow(row);
+        if (!pItem) {
+            errorDescription = QStringLiteral("No note model item at row ") +
+                QString::number(row);
+            return false;
+        }
+
+        auto index = model.indexForLocalUid(pItem->localUid());
+        if (!index.isValid() || (index.row() != row)) {
+            errorDescription = QStringLiteral("The index for local uid ") +
+                pItem->localUid() + QStringLiteral(" has row ") +
+                QString::number(index.row()) +
+                QStringLiteral(" while the item is at row ") +
+                QString::number(row);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QStringList ModelTester::addNotesToLocalStorage(
+    const int numNotes, const int numNotebooks, const int numTags)
+{
+    using namespace quentier;
+
+    QStringList notebookLocalUids;
+    for (int i = 0; i < numNotebooks; ++i) {
+        Notebook notebook;
+        notebook.setName(QStringLiteral("Notebook #") + QString::number(i));
+        notebook.setLocal(true);
+
+        // NOTE: exploiting the direct connection used in current test
+        // environment
+        m_pLocalStorageManagerAsync->onAddNotebookRequest(notebook, QUuid());
+        notebookLocalUids << notebook.localUid();
+    }
+
+    QStringList tagLocalUids;
+    for (int i = 0; i < numTags; ++i) {
+        Tag tag;
+        tag.setName(QStringLiteral("Tag #") + QString::number(i));
+        tag.setLocal(true);
+        m_pLocalStorageManagerAsync->onAddTagRequest(tag, QUuid());
+        tagLocalUids << tag.localUid();
+    }
+
+    // Titles are spread over the alphabet regardless of the order of notes'
+    // modification timestamps, some of them differ only in case or contain
+    // non-ASCII characters
+    QStringList titleWords;
+    titleWords << QStringLiteral("apple") << QStringLiteral("Banana")
+               << QStringLiteral("cherry") << QStringLiteral("Apple")
+               << QString::fromUtf8("éclair") << QStringLiteral("date")
+               << QString::fromUtf8("Ångström") << QStringLiteral("fig");
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    QStringList noteLocalUids;
+    noteLocalUids.reserve(numNotes);
+
+    for (int i = 0; i < numNotes; ++i) {
+        int titleNumber =
+            static_cast<int>((static_cast<qint64>(i) * 7919) % numNotes);
+
+        Note note;
+        note.setTitle(
+            titleWords[titleNumber % titleWords.size()] +
+            QStringLiteral(" ") + QString::number(titleNumber));
+
+        note.setContent(
+            QStringLiteral("<en-note><div>Content of note ") +
+            QString::number(i) + QStringLiteral("</div></en-note>"));
+
+        note.setCreationTimestamp(timestamp + i);
+        note.setModificationTimestamp(note.creationTimestamp());
+        note.setNotebookLocalUid(notebookLocalUids[i % numNotebooks]);
+        note.setLocal(true);
+
+        if (numTags > 0) {
+            QStringList noteTagLocalUids;
+            noteTagLocalUids << tagLocalUids[i % numTags];
+            if (numTags > 1) {
+                noteTagLocalUids << tagLocalUids[(i + 1) % numTags];
+            }
+
+            note.setTagLocalUids(noteTagLocalUids);
+        }
+
+        m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid());
+        noteLocalUids << note.localUid();
+    }
+
+    return noteLocalUids;
+}
+
+QStringList ModelTester::addTagsToLocalStorage(
+    const int numTags, const int numTagsPerTopLevelTag)
+{
+    using namespace quentier;
+
+    // Names are spread over the alphabet regardless of the order of tags'
+    // addition, some of them differ only in case or contain non-ASCII
+    // characters
+    QStringList nameWords;
+    nameWords << QStringLiteral("apple") << QStringLiteral("Banana")
+              << QStringLiteral("cherry") << QStringLiteral("Apple")
+              << QString::fromUtf8("éclair") << QStringLiteral("date")
+              << QString::fromUtf8("Ångström") << QStringLiteral("fig");
+
+    QStringList tagLocalUids;
+    tagLocalUids.reserve(numTags);
+
+    QString topLevelTagLocalUid;
+    for (int i = 0; i < numTags; ++i) {
+        int nameNumber =
+            static_cast<int>((static_cast<qint64>(i) * 7919) % numTags);
+
+        Tag tag;
+        tag.setName(
+            nameWords[nameNumber % nameWords.size()] + QStringLiteral(" ") +
+            QString::number(nameNumber));
+
+        tag.setLocal(true);
+
+        if (i % numTagsPerTopLevelTag == 0) {
+            topLevelTagLocalUid = tag.localUid();
+        }
+        else {
+            tag.setParentLocalUid(topLevelTagLocalUid);
+        }
+
+        // NOTE: exploiting the direct connection used in current test
+        // environment
+        m_pLocalStorageManagerAsync->onAddTagRequest(tag, QUuid());
+        tagLocalUids << tag.localUid();
+    }
+
+    return tagLocalUids;
+}
+
+bool ModelTester::checkTagModelSortOrder(
+    const quentier::TagModel & model, const QModelIndex & parentIndex,
+    QString & errorDescription) const
+{
+    using namespace quentier;
+
+    const bool ascending = (model.sortOrder() == Qt::AscendingOrder);
+    const int column = static_cast<int>(TagModel::Column::Name);
+
+    QString previousTagName;
+    for (int row = 0, rowCount = model.rowCount(parentIndex); row < rowCount;
+         ++row)
+    {
+        auto index = model.index(row, column, parentIndex);
+
+        if (!checkTagModelSortOrder(model, index, errorDescription)) {
+            return false;
+        }
+
+        const auto * pItem = model.itemForIndex(index);
+        if (!pItem || (pItem->type() != ITagModelItem::Type::Tag)) {
+            continue;
+        }
+
+        QString tagName = model.data(index).toString();
+        if (!previousTagName.isEmpty()) {
+            int comparison = previousTagName.localeAwareCompare(tagName);
+            if (ascending ? (comparison > 0) : (comparison < 0)) {
+                errorDescription = QStringLiteral("Tags ") + previousTagName +
+                    QStringLiteral(" and ") + tagName +
+                    QStringLiteral(" are not sorted properly by name");
+                return false;
+            }
+        }
+
+        previousTagName = tagName;
+    }
+
+    return true;
+}
+
+bool ModelTester::checkItemNamesCompletionModel(
+    const quentier::ItemNamesCompletionModel & completionModel,
+    QString & errorDescription) const
+{
+    const auto * pSourceModel = completionModel.sourceModel();
+    if (!pSourceModel) {
+        errorDescription = QStringLiteral("No source model");
+        return false;
+    }
+
+    QStringList expectedCompletions;
+    collectItemNamesCompletions(
+        *pSourceModel, QModelIndex(), expectedCompletions);
+
+    // The same order as QCompleter expects from the case insensitively sorted
+    // model
+    std::sort(
+        expectedCompletions.begin(), expectedCompletions.end(),
+        [](const QString & lhs, const QString & rhs) {
+            int result = QString::compare(lhs, rhs, Qt::CaseInsensitive);
+            if (result != 0) {
+                return result < 0;
+            }
+
+            return QString::compare(lhs, rhs, Qt::CaseSensitive) < 0;
+        });
+
+    QStringList completions;
+    for (int row = 0, rowCount = completionModel.rowCount(); row < rowCount;
+         ++row)
+    {
+        completions << completionModel.data(completionModel.index(row))
+                           .toString();
+    }
+
+    if (completions != expectedCompletions) {
+        errorDescription = QStringLiteral("Completions don't match those ") +
+            QStringLiteral("built from scratch: ") +
+            completions.join(QStringLiteral(", ")) + QStringLiteral(" vs ") +
+            expectedCompletions.join(QStringLiteral(", "));
+        return false;
+    }
+
+    return true;
+}
+
+void ModelTester::collectItemNamesCompletions(
+    const quentier::AbstractItemModel & model, const QModelIndex & parentIndex,
+    QStringList & completions) const
+{
+    for (int row = 0, rowCount = model.rowCount(parentIndex); row < rowCount;
+         ++row)
+    {
+        auto index = model.index(row, 0, parentIndex);
+
+        QString localUid = model.localUidForItemIndex(index);
+        if (!localUid.isEmpty()) {
+            auto itemInfo = model.itemInfoForLocalUid(localUid);
+            if (!itemInfo.m_name.isEmpty()) {
+                QString completion = itemInfo.m_name;
+                if (!itemInfo.m_linkedNotebookGuid.isEmpty()) {
+                    completion += QStringLiteral(" \\ @") +
+                        itemInfo.m_linkedNotebookUsername;
+                }
+
+                completions << completion;
+            }
+        }
+
+        collectItemNamesCompletions(model, index, completions);
+    }
+}
+
+bool ModelTester::checkNoteModelSortOrder(
+    const quentier::NoteModel & model, QString & errorDescription) const
+{
+    using namespace quentier;
+
+    // The same collator the note model uses for the titles
+    QCollator collator;
+
+    const int column = model.sortingColumn();
+    const bool ascending = (model.sortOrder() == Qt::AscendingOrder);
+
+    for (int row = 1, rowCount = model.rowCount(); row < rowCount; ++row) {
+        const auto * pPreviousItem = model.itemAtRow(row - 1);
+        const auto * pItem = model.itemAtRow(row);
+        if (!pPreviousItem || !pItem) {
+            errorDescription = QStringLiteral("No note model item at row ") +
+                QString::number(row);
+            return false;
+        }
+
+        qint64 comparison = 0;
+        switch (column) {
+        case NoteModel::Columns::Title:
+            comparison =
+                collator.compare(pPreviousItem->title(), pItem->title());
+            break;
+        case NoteModel::Columns::ModificationTimestamp:
+            comparison = pPreviousItem->modificationTimestamp() -
+                pItem->modificationTimestamp();
+            break;
+        case NoteModel::Columns::CreationTimestamp:
+            comparison =
+                pPreviousItem->creationTimestamp() - pItem->creationTimestamp();
+            break;
+        case NoteModel::Columns::Size:
+            comparison = static_cast<qint64>(pPreviousItem->sizeInBytes()) -
+                static_cast<qint64>(pItem->sizeInBytes());
+            break;
+        default:
+            errorDescription =
+                QStringLiteral("Unexpected note model sorting column: ") +
+                QString::number(column);
+            return false;
+        }
+
+        if (ascending ? (comparison > 0) : (comparison < 0)) {
+            errorDescription = QStringLiteral("Notes at rows ") +
+                QString::number(row - 1) + QStringLiteral(" and ") +
+                QString::number(row) +
+                QStringLiteral(" are not sorted properly by column ") +
+                QString::number(column) + QStringLiteral(": ") +
+                pPreviousItem->title() + QStringLiteral(" vs ") +
+                pItem->title();
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main(int argc, char * argv[])
 {
     QApplication app(argc, argv);
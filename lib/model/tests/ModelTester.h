@@ -23,6 +23,15 @@
 
 #include <QObject>
 
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(AbstractItemModel)
+QT_FORWARD_DECLARE_CLASS(ItemNamesCompletionModel)
+QT_FORWARD_DECLARE_CLASS(NoteModel)
+QT_FORWARD_DECLARE_CLASS(TagModel)
+
+} // namespace quentier
+
 class ModelTester : public QObject
 {
     Q_OBJECT
@@ -33,11 +42,99 @@ public:
 
 private Q_SLOTS:
     void testSavedSearchModel();
+    void testSavedSearchModelSnapshot();
     void testTagModel();
     void testNotebookModel();
     void testNoteModel();
+    void testNoteModelNoteCountsAfterUpdatesOfNotLoadedNotes();
+    void benchmarkNoteModelListing();
+    void testNoteModelSortOrder();
+    void benchmarkNoteModelSortByTitle();
+    void testNoteModelListNotesRoundTripCount();
+    void benchmarkNoteModelTimeToFirstScreen();
+    void benchmarkNoteModelMemoryUsage();
+    void testNoteModelIndexForLocalUid();
+    void benchmarkNoteModelIndexForLocalUid();
     void testFavoritesModel();
+    void testFavoritesModelNoteCountsFromNotebookModel();
     void testTagModelItemSerialization();
+    void benchmarkTagModelSortByName();
+    void benchmarkTagModelTreeViewPainting();
+    void testItemNamesCompletionModelIncrementalUpdates();
+    void testLogViewerModelLogFileParser();
+    void benchmarkLogViewerModelLogFileParser();
+    void testLogViewerModelLogFileIndexer();
+    void benchmarkLogViewerModelLogFileIndexer_data();
+    void benchmarkLogViewerModelLogFileIndexer();
+
+private:
+    void resetLocalStorageManagerAsync(
+        const QString & userName, const qint32 userId);
+
+    /**
+     * @brief addNotesToLocalStorage - adds notebooks, tags and notes
+     * distributed among them to the local storage
+     *
+     * @return              Local uids of the added notes, in the order of
+     *                      increasing modification timestamps
+     */
+    QStringList addNotesToLocalStorage(
+        const int numNotes, const int numNotebooks = 1, const int numTags = 0);
+
+    /**
+     * @brief addTagsToLocalStorage - adds tags to the local storage, each one
+     * of them either a top level tag or a child of the closest preceding top
+     * level tag
+     *
+     * @return              Local uids of the added tags, in the order of
+     *                      their addition
+     */
+    QStringList addTagsToLocalStorage(
+        const int numTags, const int numTagsPerTopLevelTag);
+
+    /**
+     * @brief residentMemorySize - reads the resident memory size of the
+     * process from /proc/self/status
+     * @return the resident memory size in bytes or -1 if it could not be
+     * determined
+     */
+    qint64 residentMemorySize() const;
+
+    /**
+     * @brief checkNoteModelSortOrder - checks that the note model's rows are
+     * ordered according to its sorting column and order
+     */
+    bool checkNoteModelSortOrder(
+        const quentier::NoteModel & model, QString & errorDescription) const;
+
+    /**
+     * @brief checkNoteModelIndexesForLocalUids - checks that the index found
+     * by the local uid of each note model's item points to the item's row
+     */
+    bool checkNoteModelIndexesForLocalUids(
+        const quentier::NoteModel & model, QString & errorDescription) const;
+
+    /**
+     * @brief checkTagModelSortOrder - checks that the tag items under
+     * the parent index and all their descendants are ordered by name
+     * according to the tag model's sort order
+     */
+    bool checkTagModelSortOrder(
+        const quentier::TagModel & model, const QModelIndex & parentIndex,
+        QString & errorDescription) const;
+
+    /**
+     * @brief checkItemNamesCompletionModel - checks that the completion model
+     * contains the same completions in the same order as the list built from
+     * scratch out of all items of its source model
+     */
+    bool checkItemNamesCompletionModel(
+        const quentier::ItemNamesCompletionModel & completionModel,
+        QString & errorDescription) const;
+
+    void collectItemNamesCompletions(
+        const quentier::AbstractItemModel & model,
+        const QModelIndex & parentIndex, QStringList & completions) const;
 
 private:
     quentier::LocalStorageManagerAsync * m_pLocalStorageManagerAsync = nullptr;
@@ -175,6 +175,8 @@ void NotebookModelTestHelper::test()
         auto * model = new NotebookModel(
             account, *m_pLocalStorageManagerAsync, cache, this);
 
+        model->start();
+
         ModelTest t1(model);
         Q_UNUSED(t1)
 
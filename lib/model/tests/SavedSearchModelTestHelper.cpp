@@ -109,6 +109,8 @@ void SavedSearchModelTestHelper::test()
         auto * model = new SavedSearchModel(
             account, *m_pLocalStorageManagerAsync, cache, this);
 
+        model->start();
+
         ModelTest t1(model);
         Q_UNUSED(t1)
 
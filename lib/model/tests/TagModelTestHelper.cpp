@@ -175,6 +175,8 @@ void TagModelTestHelper::test()
         auto * model =
             new TagModel(account, *m_pLocalStorageManagerAsync, cache, this);
 
+        model->start();
+
         ModelTest t1(model);
         Q_UNUSED(t1)
 
@@ -211,6 +211,23 @@ void NoteListView::dataChanged(
     const QVector<int> & roles)
 {
     QListView::dataChanged(topLeft, bottomRight, roles);
+
+    if (!topLeft.isValid() || !bottomRight.isValid() ||
+        (topLeft.column() > NoteModel::Columns::ThumbnailImage) ||
+        (bottomRight.column() < NoteModel::Columns::ThumbnailImage))
+    {
+        return;
+    }
+
+    const auto * pModel = model();
+    if (Q_UNLIKELY(!pModel)) {
+        return;
+    }
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        auto index = pModel->index(row, modelColumn(), topLeft.parent());
+        viewport()->update(visualRect(index));
+    }
 }
 
 void NoteListView::rowsAboutToBeRemoved(
@@ -109,9 +109,11 @@ public Q_SLOTS:
     void selectNotesByLocalUids(const QStringList & noteLocalUids);
 
     /**
-     * @brief The dataChanged method is redefined in NoteListView for the sole
-     * reason of being a public slot instead of protected; it calls
-     * the implementation of QListView's dataChanged protected slot
+     * @brief The dataChanged method is redefined in NoteListView for being
+     * a public slot instead of protected; it calls the implementation of
+     * QListView's dataChanged protected slot and additionally repaints
+     * the rows which thumbnails have changed as NoteItemDelegate paints
+     * the thumbnails within the rows of the displayed column
      */
     virtual void dataChanged(
         const QModelIndex & topLeft, const QModelIndex & bottomRight,
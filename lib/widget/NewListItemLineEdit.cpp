@@ -19,19 +19,18 @@
 #include "NewListItemLineEdit.h"
 #include "ui_NewListItemLineEdit.h"
 
-#include <lib/model/tag/TagModel.h>
+#include <lib/model/common/ItemNamesCompletionModel.h>
 
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/Compat.h>
 #include <quentier/utility/VersionInfo.h>
 
 #include <QAbstractItemView>
+#include <QApplication>
 #include <QCompleter>
 #include <QKeyEvent>
-#include <QModelIndex>
-#include <QStringListModel>
-
-#include <algorithm>
+#include <QRegExp>
+#include <QSortFilterProxyModel>
 
 namespace quentier {
 
@@ -41,24 +40,21 @@ NewListItemLineEdit::NewListItemLineEdit(
     QLineEdit(parent),
     m_pUi(new Ui::NewListItemLineEdit), m_pItemModel(pItemModel),
     m_reservedItems(std::move(reservedItems)),
-    m_pItemNamesModel(new QStringListModel(this)),
+    m_pItemNamesFilterModel(new QSortFilterProxyModel(this)),
     m_pCompleter(new QCompleter(this))
 {
     m_pUi->setupUi(this);
     setPlaceholderText(tr("Click here to add") + QStringLiteral("..."));
-    setupCompleter();
 
-    QObject::connect(
-        m_pItemModel.data(), &AbstractItemModel::rowsInserted, this,
-        &NewListItemLineEdit::onModelRowsInserted);
+    if (!m_pItemModel.isNull()) {
+        m_pItemNamesModel =
+            ItemNamesCompletionModel::forSourceModel(*m_pItemModel);
+    }
 
-    QObject::connect(
-        m_pItemModel.data(), &AbstractItemModel::rowsRemoved, this,
-        &NewListItemLineEdit::onModelRowsRemoved);
+    m_pItemNamesFilterModel->setFilterRole(
+        ItemNamesCompletionModel::Role::LinkedNotebookGuid);
 
-    QObject::connect(
-        m_pItemModel.data(), &AbstractItemModel::dataChanged, this,
-        &NewListItemLineEdit::onModelDataChanged);
+    setupCompleter();
 
     // NOTE: working around what seems to be a Qt bug: when one selects some
     // item from the drop-down menu shown by QCompleter via pressing
@@ -99,6 +95,7 @@ void NewListItemLineEdit::setTargetLinkedNotebookGuid(
     QString linkedNotebookGuid)
 {
     m_targetLinkedNotebookGuid = std::move(linkedNotebookGuid);
+    setupCompleterModel();
 }
 
 QVector<NewListItemLineEdit::ItemInfo> NewListItemLineEdit::reservedItems()
@@ -195,49 +192,6 @@ void NewListItemLineEdit::focusInEvent(QFocusEvent * pEvent)
     }
 }
 
-void NewListItemLineEdit::onModelRowsInserted(
-    const QModelIndex & parent, int start, int end)
-{
-    QNDEBUG(
-        "widget:new_list_item_line_edit",
-        "NewListItemLineEdit::onModelRowsInserted");
-
-    Q_UNUSED(parent)
-    Q_UNUSED(start)
-    Q_UNUSED(end)
-
-    setupCompleter();
-}
-
-void NewListItemLineEdit::onModelRowsRemoved(
-    const QModelIndex & parent, int start, int end)
-{
-    QNDEBUG(
-        "widget:new_list_item_line_edit",
-        "NewListItemLineEdit::onModelRowsRemoved");
-
-    Q_UNUSED(parent)
-    Q_UNUSED(start)
-    Q_UNUSED(end)
-
-    setupCompleter();
-}
-
-void NewListItemLineEdit::onModelDataChanged(
-    const QModelIndex & topLeft, const QModelIndex & bottomRight,
-    const QVector<int> & roles)
-{
-    QNDEBUG(
-        "widget:new_list_item_line_edit",
-        "NewListItemLineEdit::onModelDataChanged");
-
-    Q_UNUSED(topLeft)
-    Q_UNUSED(bottomRight)
-    Q_UNUSED(roles)
-
-    setupCompleter();
-}
-
 void NewListItemLineEdit::setupCompleter()
 {
     QNDEBUG(
@@ -247,15 +201,7 @@ void NewListItemLineEdit::setupCompleter()
     m_pCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     m_pCompleter->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
 
-    auto itemNames = itemNamesForCompleter();
-    m_pItemNamesModel->setStringList(itemNames);
-
-    QNTRACE(
-        "widget:new_list_item_line_edit",
-        "The item names to set to the completer: "
-            << itemNames.join(QStringLiteral(", ")));
-
-    m_pCompleter->setModel(m_pItemNamesModel);
+    setupCompleterModel();
     setCompleter(m_pCompleter);
 
 #ifdef LIB_QUENTIER_USE_QT_WEB_ENGINE
@@ -268,47 +214,33 @@ void NewListItemLineEdit::setupCompleter()
 #endif
 }
 
-QStringList NewListItemLineEdit::itemNamesForCompleter() const
+void NewListItemLineEdit::setupCompleterModel()
 {
-    if (m_pItemModel.isNull()) {
-        return {};
-    }
-
-    QStringList itemNames;
-
-    if (!m_targetLinkedNotebookGuid.isNull()) {
-        itemNames = m_pItemModel->itemNames(m_targetLinkedNotebookGuid);
-
-        if (!m_targetLinkedNotebookGuid.isEmpty()) {
-            QString linkedNotebookUsername =
-                m_pItemModel->linkedNotebookUsername(
-                    m_targetLinkedNotebookGuid);
+    QNDEBUG(
+        "widget:new_list_item_line_edit",
+        "NewListItemLineEdit::setupCompleterModel: target linked notebook "
+            << "guid = " << m_targetLinkedNotebookGuid);
 
-            for (auto & itemName: itemNames) {
-                itemName += QStringLiteral(" \\ @");
-                itemName += linkedNotebookUsername;
-            }
-        }
+    if (m_pItemNamesModel.isNull()) {
+        m_pCompleter->setModel(nullptr);
+        return;
     }
-    else {
-        // First list item names corresponding to user's own account
-        itemNames = m_pItemModel->itemNames(QLatin1String(""));
-
-        // Now add items corresponding to linked notebooks
-        auto linkedNotebooksInfo = m_pItemModel->linkedNotebooksInfo();
-        for (const auto & info: qAsConst(linkedNotebooksInfo)) {
-            auto linkedNotebookItemNames = m_pItemModel->itemNames(info.m_guid);
-            for (auto & itemName: linkedNotebookItemNames) {
-                itemName += QStringLiteral(" \\ @");
-                itemName += info.m_username;
-            }
-
-            itemNames << linkedNotebookItemNames;
-        }
+
+    // Null target linked notebook guid means items from both user's own
+    // account and linked notebooks should be completed
+    if (m_targetLinkedNotebookGuid.isNull()) {
+        m_pCompleter->setModel(m_pItemNamesModel.data());
+        return;
     }
 
-    std::sort(itemNames.begin(), itemNames.end());
-    return itemNames;
+    // The filter model preserves the sorting of the source model as long as
+    // it is not sorted itself
+    m_pItemNamesFilterModel->setSourceModel(m_pItemNamesModel.data());
+    m_pItemNamesFilterModel->setFilterRegExp(QRegExp(
+        QStringLiteral("^") + QRegExp::escape(m_targetLinkedNotebookGuid) +
+        QStringLiteral("$")));
+
+    m_pCompleter->setModel(m_pItemNamesFilterModel);
 }
 
 } // namespace quentier
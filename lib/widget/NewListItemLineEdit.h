@@ -31,12 +31,12 @@ class NewListItemLineEdit;
 }
 
 QT_FORWARD_DECLARE_CLASS(QCompleter)
-QT_FORWARD_DECLARE_CLASS(QModelIndex)
-QT_FORWARD_DECLARE_CLASS(QStringListModel)
+QT_FORWARD_DECLARE_CLASS(QSortFilterProxyModel)
 
 namespace quentier {
 
 QT_FORWARD_DECLARE_CLASS(AbstractItemModel)
+QT_FORWARD_DECLARE_CLASS(ItemNamesCompletionModel)
 
 class NewListItemLineEdit final : public QLineEdit
 {
@@ -75,24 +75,21 @@ protected:
     virtual void keyPressEvent(QKeyEvent * pEvent) override;
     virtual void focusInEvent(QFocusEvent * pEvent) override;
 
-private Q_SLOTS:
-    void onModelRowsInserted(const QModelIndex & parent, int start, int end);
-    void onModelRowsRemoved(const QModelIndex & parent, int start, int end);
-
-    void onModelDataChanged(
-        const QModelIndex & topLeft, const QModelIndex & bottomRight,
-        const QVector<int> & roles = QVector<int>());
-
 private:
     void setupCompleter();
-
-    QStringList itemNamesForCompleter() const;
+    void setupCompleterModel();
 
 private:
     Ui::NewListItemLineEdit * m_pUi;
     QPointer<AbstractItemModel> m_pItemModel;
     QVector<ItemInfo> m_reservedItems;
-    QStringListModel * m_pItemNamesModel;
+
+    // Shared between all line edits created for the same item model
+    QPointer<ItemNamesCompletionModel> m_pItemNamesModel;
+
+    // Filters item names by the target linked notebook guid if it's set
+    QSortFilterProxyModel * m_pItemNamesFilterModel;
+
     QCompleter * m_pCompleter;
     QString m_targetLinkedNotebookGuid;
 };
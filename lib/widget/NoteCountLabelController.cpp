@@ -23,6 +23,7 @@
 #include <quentier/logging/QuentierLogger.h>
 
 #include <QLabel>
+#include <QTimerEvent>
 
 namespace quentier {
 
@@ -55,7 +56,7 @@ void NoteCountLabelController::onNoteCountPerAccountUpdated(qint32 noteCount)
             << noteCount);
 
     m_totalNoteCountPerAccount = noteCount;
-    setNoteCountsToLabel();
+    scheduleLabelUpdate();
 }
 
 void NoteCountLabelController::onFilteredNotesCountUpdated(qint32 noteCount)
@@ -65,7 +66,7 @@ void NoteCountLabelController::onFilteredNotesCountUpdated(qint32 noteCount)
         "NoteCountLabelController::onFilteredNotesCountUpdated: " << noteCount);
 
     m_filteredNotesCount = noteCount;
-    setNoteCountsToLabel();
+    scheduleLabelUpdate();
 }
 
 void NoteCountLabelController::setNoteCountsFromNoteModel()
@@ -89,6 +90,8 @@ void NoteCountLabelController::setNoteCountsFromNoteModel()
 
 void NoteCountLabelController::setNoteCountsToLabel()
 {
+    m_labelUpdateTimer.stop();
+
     QNDEBUG(
         "widget:note_count_label",
         "NoteCountLabelController::setNoteCountsToLabel: "
@@ -103,6 +106,15 @@ void NoteCountLabelController::setNoteCountsToLabel()
     m_pLabel->setText(text);
 }
 
+void NoteCountLabelController::scheduleLabelUpdate()
+{
+    if (m_labelUpdateTimer.isActive()) {
+        return;
+    }
+
+    m_labelUpdateTimer.start(0, this);
+}
+
 void NoteCountLabelController::disconnectFromNoteModel()
 {
     QNDEBUG(
@@ -149,4 +161,18 @@ void NoteCountLabelController::connectToNoteModel()
         Qt::ConnectionType(Qt::QueuedConnection | Qt::UniqueConnection));
 }
 
+void NoteCountLabelController::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_labelUpdateTimer.timerId()) {
+        setNoteCountsToLabel();
+        return;
+    }
+
+    QObject::timerEvent(pEvent);
+}
+
 } // namespace quentier
@@ -19,6 +19,7 @@
 #ifndef QUENTIER_LIB_WIDGET_NOTE_COUNT_LABEL_CONTROLLER_H
 #define QUENTIER_LIB_WIDGET_NOTE_COUNT_LABEL_CONTROLLER_H
 
+#include <QBasicTimer>
 #include <QObject>
 #include <QPointer>
 
@@ -43,9 +44,19 @@ private Q_SLOTS:
 private:
     void setNoteCountsFromNoteModel();
     void setNoteCountsToLabel();
+
+    /**
+     * @brief scheduleLabelUpdate - postpones setting the counts to the label
+     * until the next event loop iteration so that a burst of count updates
+     * results in a single label update
+     */
+    void scheduleLabelUpdate();
+
     void connectToNoteModel();
     void disconnectFromNoteModel();
 
+    virtual void timerEvent(QTimerEvent * pEvent) override;
+
 private:
     Q_DISABLE_COPY(NoteCountLabelController);
 
@@ -55,6 +66,8 @@ private:
 
     qint32 m_totalNoteCountPerAccount = 0;
     qint32 m_filteredNotesCount = 0;
+
+    QBasicTimer m_labelUpdateTimer;
 };
 
 } // namespace quentier